@@ -0,0 +1,62 @@
+// Driver-to-vehicle assignment benchmark.
+// Solves n x n problems with uniform random costs and with "empty km"
+// costs between random points on a map (Manhattan distance), which have
+// much longer augmenting paths. Target: 5000 x 5000 under 1 s for both.
+//
+// Usage: assignment_bench [maxSize]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "assignment_engine.h"
+using namespace std;
+
+double timeSolve(AssignmentEngine& engine, const DistanceMatrix& costs, AssignmentResult& result) {
+    auto start = chrono::steady_clock::now();
+    engine.solve(costs, result);
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int maxSize = argc > 1 ? atoi(argv[1]) : 5000;
+    mt19937 rng(42);
+    AssignmentEngine engine;
+    AssignmentResult result;
+
+    cout << "=== Assignment Engine Benchmark ===" << endl;
+    cout << setw(8) << "n" << setw(14) << "uniform (s)" << setw(14) << "map (s)" << endl;
+
+    int sizes[] = {500, 1000, 2000, 5000};
+    for(int n : sizes) {
+        if(n > maxSize) break;
+        DistanceMatrix uniform;
+        uniform.resize(n, n);
+        for(size_t k = 0; k < uniform.values.size(); k++) {
+            uniform.values[k] = (int)(rng() % 100000);
+        }
+
+        vector<int> driverX(n), driverY(n), depotX(n), depotY(n);
+        for(int i = 0; i < n; i++) {
+            driverX[i] = rng() % 10000;
+            driverY[i] = rng() % 10000;
+            depotX[i] = rng() % 10000;
+            depotY[i] = rng() % 10000;
+        }
+        DistanceMatrix map;
+        map.resize(n, n);
+        for(int i = 0; i < n; i++) {
+            int* row = map.row(i);
+            for(int j = 0; j < n; j++) {
+                row[j] = abs(driverX[i] - depotX[j]) + abs(driverY[i] - depotY[j]);
+            }
+        }
+
+        double uniformTime = timeSolve(engine, uniform, result);
+        double mapTime = timeSolve(engine, map, result);
+        cout << setw(8) << n << fixed << setprecision(3) << setw(14) << uniformTime << setw(14) << mapTime << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Morning login burst benchmark.
+// Registers a set of employees, then fires a burst of logins (90% correct
+// password, 5% wrong password, 5% unknown email) from many threads at once
+// and reports throughput and latency percentiles. Wrong and unknown logins
+// should cost the same as successful ones.
+//
+// Usage: auth_login_bench [logins] [threads] [scryptN]
+// scryptN defaults to 1024 so the run stays short; AuthSystem's default
+// (16384) is the production setting and scales time per login linearly.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "auth_system.h"
+using namespace std;
+
+#define BENCH_USERS 500
+
+double percentile(vector<double>& sorted, double p) {
+    if(sorted.empty()) return 0.0;
+    size_t index = (size_t)(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+int main(int argc, char** argv) {
+    int logins = argc > 1 ? atoi(argv[1]) : 10000;
+    int threads = argc > 2 ? atoi(argv[2]) : 16;
+    uint32_t costN = argc > 3 ? (uint32_t)atoi(argv[3]) : 1024;
+
+    ScryptParams params(costN, 8, 1);
+    AuthSystem auth(params);
+    auth.setVerbose(false);
+
+    vector<string> emails;
+    vector<string> passwords;
+    for(int i = 0; i < BENCH_USERS; i++) {
+        emails.push_back("driver" + to_string(i) + "@fleet.com");
+        passwords.push_back("pass-" + to_string(i * 7919));
+        auth.registerUser(emails[i], passwords[i], "Driver " + to_string(i));
+    }
+
+    cout << "=== Login Burst Benchmark ===" << endl;
+    cout << "Users: " << auth.getTotalUsers() << ", logins: " << logins << ", threads: " << threads
+         << ", scrypt N=" << params.N << " r=" << params.r << " p=" << params.p << "\n" << endl;
+
+    // Latencies by outcome: 0 = success, 1 = wrong password, 2 = unknown email
+    vector<vector<double> > latencies(3);
+    vector<vector<double> > perThread[3];
+    for(int kind = 0; kind < 3; kind++) {
+        perThread[kind].resize(threads);
+    }
+    atomic<int> next(0);
+    atomic<int> unexpected(0);
+    atomic<bool> go(false);
+    vector<thread> workers;
+
+    for(int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            string unknown = "nobody@fleet.com";
+            string wrong = "not-the-password";
+            while(!go.load()) this_thread::yield();
+            while(true) {
+                int i = next.fetch_add(1);
+                if(i >= logins) break;
+                int user = (i * 31) % BENCH_USERS;
+                int kind = (i % 20 == 0) ? 1 : (i % 20 == 1) ? 2 : 0;
+                string_view email = (kind == 2) ? string_view(unknown) : string_view(emails[user]);
+                string_view password = (kind == 1) ? string_view(wrong) : string_view(passwords[user]);
+
+                auto start = chrono::steady_clock::now();
+                User* result = auth.login(email, password);
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                perThread[kind][t].push_back(ms);
+                if((kind == 0) != (result != NULL)) unexpected++;
+            }
+        }));
+    }
+
+    auto start = chrono::steady_clock::now();
+    go = true;
+    for(size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const char* names[3] = {"success", "wrong password", "unknown email"};
+    vector<double> all;
+    cout << setw(16) << "outcome" << setw(8) << "count" << setw(10) << "p50 ms" << setw(10) << "p99 ms"
+         << setw(10) << "max ms" << endl;
+    for(int kind = 0; kind < 3; kind++) {
+        for(int t = 0; t < threads; t++) {
+            latencies[kind].insert(latencies[kind].end(), perThread[kind][t].begin(), perThread[kind][t].end());
+        }
+        sort(latencies[kind].begin(), latencies[kind].end());
+        all.insert(all.end(), latencies[kind].begin(), latencies[kind].end());
+        cout << setw(16) << names[kind] << setw(8) << latencies[kind].size() << fixed << setprecision(2)
+             << setw(10) << percentile(latencies[kind], 0.50) << setw(10) << percentile(latencies[kind], 0.99)
+             << setw(10) << (latencies[kind].empty() ? 0.0 : latencies[kind].back()) << endl;
+    }
+    sort(all.begin(), all.end());
+    cout << "\nThroughput: " << setprecision(0) << logins / seconds << " logins/s over "
+         << setprecision(2) << seconds << " s" << endl;
+    cout << "All logins p99: " << percentile(all, 0.99) << " ms" << endl;
+    if(unexpected > 0) {
+        cout << "❌ " << unexpected << " logins returned the wrong result" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,199 @@
+// Contraction Hierarchy benchmark.
+// First checks ContractionHierarchy against plain Dijkstra on <graphs>
+// random graphs of three shapes - grid cities with missing streets, sparse
+// random networks with parallel roads and unreachable vertices, and
+// local-plus-long-range "regional" networks - comparing reachability,
+// distance and the length of the unpacked path on every query. Then builds
+// the hierarchy for a <side> x <side> grid city with arterial roads every
+// ARTERIAL_EVERY blocks (1M junctions by default) and times random
+// point-to-point queries against Dijkstra. Target: well under 1 ms per
+// query. Exits non-zero on any mismatch or a missed target.
+//
+// Usage: ch_query_bench [side] [queries] [graphs]
+// Timings assume an optimized build (-DCMAKE_BUILD_TYPE=Release); the 1M
+// junction hierarchy takes a few minutes to build.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "contraction_hierarchy.h"
+using namespace std;
+
+#define ARTERIAL_EVERY 20               // Every 20th street is an arterial
+#define CHECK_QUERIES 300               // Per random graph
+#define DIJKSTRA_SAMPLE 50              // Big-graph queries also run through Dijkstra
+#define TARGET_QUERY_MS 1.0
+
+static double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void addRoad(vector<Arc>& arcs, int u, int v, int w) {
+    arcs.push_back(Arc{u, v, w});
+    arcs.push_back(Arc{v, u, w});
+}
+
+// Grid city, ~10% of the streets missing; arterials are 3x faster
+static void gridCity(int side, mt19937& rng, vector<Arc>& arcs) {
+    for(int r = 0; r < side; r++) {
+        for(int c = 0; c < side; c++) {
+            int u = r * side + c;
+            if(c + 1 < side && rng() % 10 != 0) {
+                int metres = 100 + rng() % 200;
+                addRoad(arcs, u, u + 1, r % ARTERIAL_EVERY == 0 ? metres / 3 : metres);
+            }
+            if(r + 1 < side && rng() % 10 != 0) {
+                int metres = 100 + rng() % 200;
+                addRoad(arcs, u, u + side, c % ARTERIAL_EVERY == 0 ? metres / 3 : metres);
+            }
+        }
+    }
+}
+
+// ~2n random roads, some doubled with another weight; a tenth of the
+// vertices get no roads at all
+static void sparseRandom(int n, mt19937& rng, vector<Arc>& arcs) {
+    for(int i = 0; i < 2 * n; i++) {
+        int u = rng() % n, v = rng() % n;
+        if(u % 10 == 0 || v % 10 == 0) continue;
+        int w = 1 + rng() % 1000;
+        addRoad(arcs, u, v, w);
+        if(rng() % 8 == 0) addRoad(arcs, u, v, 1 + rng() % 1000);
+    }
+}
+
+// Roads to nearby vertex numbers plus a few long cheap links
+static void regional(int n, mt19937& rng, vector<Arc>& arcs) {
+    for(int u = 0; u < n; u++) {
+        for(int k = 0; k < 2; k++) {
+            int v = u + 1 + rng() % 30;
+            if(v < n) addRoad(arcs, u, v, 10 + rng() % 90);
+        }
+        if(rng() % 50 == 0) addRoad(arcs, u, rng() % n, 50 + rng() % 200);
+    }
+}
+
+// Sum of road weights along the path, or -1 if a hop is not a road
+static long long pathLength(const CSRGraph& g, const vector<int>& nodes) {
+    long long total = 0;
+    for(size_t i = 0; i + 1 < nodes.size(); i++) {
+        int w = g.edgeWeight(nodes[i], nodes[i + 1]);
+        if(w == INF) return -1;
+        total += w;
+    }
+    return total;
+}
+
+static bool sameRoute(const CSRGraph& g, int from, int to, const RoutePath& plain, const RoutePath& ch) {
+    if(plain.found != ch.found) return false;
+    if(!plain.found) return true;
+    return plain.distance == ch.distance && !ch.nodes.empty() && ch.nodes.front() == from &&
+           ch.nodes.back() == to && pathLength(g, ch.nodes) == ch.distance;
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? atoi(argv[1]) : 1000;
+    int queries = argc > 2 ? atoi(argv[2]) : 1000;
+    int numGraphs = argc > 3 ? atoi(argv[3]) : 6;
+
+    mt19937 rng(5);
+    RoutePath plain, ch;
+    int mismatches = 0;
+
+    cout << "=== Contraction Hierarchy Benchmark ===" << endl;
+    cout << "\n--- Random graphs vs Dijkstra ---" << endl;
+    cout << left << setw(10) << "Graph" << right << setw(10) << "vertices" << setw(10) << "arcs"
+         << setw(12) << "shortcuts" << setw(10) << "queries" << setw(12) << "mismatches" << endl;
+    for(int i = 0; i < numGraphs; i++) {
+        static const char* shapes[] = {"grid", "sparse", "regional"};
+        int shape = i % 3;
+        vector<Arc> arcs;
+        int n;
+        if(shape == 0) {
+            int s = 20 + rng() % 40;
+            n = s * s;
+            gridCity(s, rng, arcs);
+        } else {
+            n = 500 + rng() % 2500;
+            if(shape == 1) sparseRandom(n, rng, arcs);
+            else regional(n, rng, arcs);
+        }
+        CSRGraph g;
+        g.build(n, arcs);
+        ContractionHierarchy hierarchy;
+        hierarchy.build(g);
+        DijkstraSearch dijkstra(g);
+
+        int bad = 0;
+        for(int q = 0; q < CHECK_QUERIES; q++) {
+            int from = rng() % n, to = rng() % n;
+            dijkstra.findRoute(from, to, plain);
+            hierarchy.findRoute(from, to, ch);
+            if(!sameRoute(g, from, to, plain, ch)) bad++;
+        }
+        mismatches += bad;
+        cout << left << setw(10) << shapes[shape] << right << setw(10) << n << setw(10) << g.getNumArcs()
+             << setw(12) << hierarchy.getNumShortcuts() << setw(10) << CHECK_QUERIES << setw(12) << bad << endl;
+    }
+
+    cout << "\n--- " << side << " x " << side << " grid city ---" << endl;
+    vector<Arc> arcs;
+    gridCity(side, rng, arcs);
+    int n = side * side;
+    CSRGraph city;
+    city.build(n, arcs);
+    arcs.clear();
+    arcs.shrink_to_fit();
+
+    auto start = chrono::steady_clock::now();
+    ContractionHierarchy hierarchy;
+    hierarchy.build(city);
+    double buildMs = msSince(start);
+
+    vector<pair<int, int>> pairs;
+    for(int q = 0; q < queries; q++) pairs.push_back(make_pair((int)(rng() % n), (int)(rng() % n)));
+
+    long long chSettled = 0;
+    int found = 0;
+    start = chrono::steady_clock::now();
+    for(const pair<int, int>& p : pairs) {
+        hierarchy.findRoute(p.first, p.second, ch);
+        chSettled += ch.settledNodes;
+        found += ch.found;
+    }
+    double chMs = msSince(start) / queries;
+
+    int sample = queries < DIJKSTRA_SAMPLE ? queries : DIJKSTRA_SAMPLE;
+    DijkstraSearch dijkstra(city);
+    long long dijkstraSettled = 0;
+    int bigMismatches = 0;
+    start = chrono::steady_clock::now();
+    for(int q = 0; q < sample; q++) {
+        dijkstra.findRoute(pairs[q].first, pairs[q].second, plain);
+        dijkstraSettled += plain.settledNodes;
+    }
+    double dijkstraMs = msSince(start) / sample;
+    for(int q = 0; q < sample; q++) {
+        dijkstra.findRoute(pairs[q].first, pairs[q].second, plain);
+        hierarchy.findRoute(pairs[q].first, pairs[q].second, ch);
+        if(!sameRoute(city, pairs[q].first, pairs[q].second, plain, ch)) bigMismatches++;
+    }
+    mismatches += bigMismatches;
+
+    cout << "Vertices: " << n << ", arcs: " << city.getNumArcs() << ", shortcuts: " << hierarchy.getNumShortcuts() << endl;
+    cout << fixed << setprecision(1) << "Preprocessing: " << buildMs / 1000 << " s" << endl;
+    cout << setprecision(4) << "Hierarchy: " << chMs << " ms/query, " << chSettled / queries << " settled ("
+         << found << "/" << queries << " reachable)" << endl;
+    cout << "Dijkstra:  " << dijkstraMs << " ms/query, " << (sample > 0 ? dijkstraSettled / sample : 0)
+         << " settled (" << sample << " queries)" << endl;
+    cout << setprecision(0) << "Speedup: " << dijkstraMs / chMs << "x" << endl;
+
+    bool fast = chMs < TARGET_QUERY_MS;
+    cout << "\n" << (mismatches == 0 ? "✅ Hierarchy matches Dijkstra on every query" : "❌ Hierarchy differs from Dijkstra")
+         << " (" << mismatches << " mismatches)" << endl;
+    cout << (fast ? "✅ " : "❌ ") << setprecision(4) << chMs << " ms per query (target " << TARGET_QUERY_MS << " ms)" << endl;
+    return mismatches == 0 && fast ? 0 : 1;
+}
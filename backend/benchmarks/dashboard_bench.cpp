@@ -0,0 +1,247 @@
+// Dashboard aggregates benchmark.
+// Loads a HashTable with <vehicles> vehicles and an AuthSystem with <users>
+// accounts, attaches DashboardAggregates, then replays <mutations> random
+// changes: vehicle status moves, driver assign/unassign, vehicles added and
+// retired for good, trips started and completed. Mutation time is compared
+// with the same stream on an unobserved table. Account approvals and
+// deactivations then run on <threads> threads while another thread keeps
+// reading snapshots. At the end the snapshot must equal a full recount,
+// which is also what each dashboard read costs without the aggregates.
+// Drivers are counted as in app.js: ACTIVE EMPLOYEE accounts, assigned if
+// a vehicle names their userId. One driver ID in six has no account.
+//
+// Usage: dashboard_bench [vehicles] [users] [mutations] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include "services/dashboard_aggregates.h"
+using namespace std;
+
+#define SNAPSHOT_READS 1000000
+#define RECOUNT_ROUNDS 5
+
+enum MutationKind { MUTATE_STATUS, MUTATE_DRIVER, MUTATE_INSERT, MUTATE_DELETE, MUTATE_TRIP };
+
+struct Mutation {
+    MutationKind kind;
+    int vehicle;
+    int value;
+    double km;
+};
+
+static double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static Vehicle* makeVehicle(int i) {
+    static const char* typeNames[] = {"Truck", "Van", "Car", "SUV"};
+    return new Vehicle("V" + to_string(i), "REG-" + to_string(i), "Model", typeNames[i % 4], 2020);
+}
+
+// Apply the same mutation stream to a table (trips go to 'aggregates' if set)
+static void replay(HashTable& table, const vector<Mutation>& mutations, const vector<string>& driverIds,
+                   DashboardAggregates* aggregates) {
+    for(const Mutation& m : mutations) {
+        string id = "V" + to_string(m.vehicle);
+        switch(m.kind) {
+            case MUTATE_STATUS: table.updateStatus(id, (VehicleStatus)m.value); break;
+            case MUTATE_DRIVER: table.assignDriver(id, m.value < 0 ? "" : driverIds[m.value]); break;
+            case MUTATE_INSERT: table.insert(makeVehicle(m.vehicle)); break;
+            case MUTATE_DELETE: table.deleteVehicle(id); break;
+            case MUTATE_TRIP:
+                if(aggregates == NULL) break;
+                if(m.value == 0) aggregates->tripStarted();
+                else aggregates->tripCompleted(m.km);
+                break;
+        }
+    }
+}
+
+// What the dashboard costs without the aggregates: visit everything
+static DashboardSnapshot recount(const HashTable& table, AuthSystem& auth, const vector<string>& emails,
+                                 long long tripsStarted, const vector<double>& completedKm) {
+    DashboardSnapshot s = DashboardSnapshot();
+    table.forEachVehicle([&](const Vehicle& v) {
+        s.vehicles++;
+        s.vehiclesByStatus[v.status]++;
+        if(v.assignedDriverId != "") s.vehiclesAssigned++;
+    });
+    for(const string& email : emails) {
+        User* u = auth.getUserByEmail(email);
+        s.users++;
+        if(u->status == "ACTIVE") s.usersActive++;
+        else if(u->status == "PENDING") s.usersPending++;
+        else if(u->status == "INACTIVE") s.usersInactive++;
+        if(u->role == "EMPLOYEE") {
+            s.drivers++;
+            if(u->status == "ACTIVE") {
+                s.driversActive++;
+                if(table.findByDriver(u->userId) != NULL) s.driversAssigned++;
+                else s.driversAvailable++;
+            }
+        }
+    }
+    s.tripsCompleted = (long long)completedKm.size();
+    s.tripsOngoing = tripsStarted - s.tripsCompleted;
+    for(double km : completedKm) s.totalDistanceKm += km;
+    s.averageDistanceKm = s.tripsCompleted > 0 ? s.totalDistanceKm / s.tripsCompleted : 0.0;
+    return s;
+}
+
+static bool sameCounters(const DashboardSnapshot& a, const DashboardSnapshot& b) {
+    for(int st = 0; st < VEHICLE_STATUS_COUNT; st++) {
+        if(a.vehiclesByStatus[st] != b.vehiclesByStatus[st]) return false;
+    }
+    return a.vehicles == b.vehicles && a.vehiclesAssigned == b.vehiclesAssigned && a.users == b.users &&
+           a.usersActive == b.usersActive && a.usersPending == b.usersPending && a.usersInactive == b.usersInactive &&
+           a.drivers == b.drivers && a.driversActive == b.driversActive && a.driversAssigned == b.driversAssigned &&
+           a.driversAvailable == b.driversAvailable && a.tripsOngoing == b.tripsOngoing &&
+           a.tripsCompleted == b.tripsCompleted && fabs(a.totalDistanceKm - b.totalDistanceKm) < 1e-6 &&
+           fabs(a.averageDistanceKm - b.averageDistanceKm) < 1e-9;
+}
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 200000;
+    int numUsers = argc > 2 ? atoi(argv[2]) : 20000;
+    int numMutations = argc > 3 ? atoi(argv[3]) : 1000000;
+    int threads = argc > 4 ? atoi(argv[4]) : 2;
+    if(threads < 1) threads = 1;
+
+    mt19937 rng(25);
+    // Cheap hashing parameters: this is not measuring scrypt
+    AuthSystem auth(ScryptParams(16, 1, 1));
+    auth.setVerbose(false);
+    vector<string> emails = {"admin@fleet.com"};
+    for(int u = 0; u < numUsers; u++) {
+        emails.push_back("driver" + to_string(u) + "@fleet.com");
+        auth.registerUser(emails.back(), "pw", "Driver " + to_string(u));
+    }
+
+    // Driver IDs on vehicles: account userIds, then some with no account
+    vector<string> driverIds;
+    for(int u = 0; u < numUsers; u++) driverIds.push_back(auth.getUserByEmail(emails[u + 1])->userId);
+    for(int u = 0; u < numUsers / 5; u++) driverIds.push_back("D" + to_string(u));
+
+    HashTable table, plain;
+    for(HashTable* t : {&table, &plain}) {
+        t->setVerbose(false);
+        t->reserve(numVehicles * 2);
+        for(int i = 0; i < numVehicles; i++) {
+            Vehicle* v = makeVehicle(i);
+            v->status = (VehicleStatus)(i % VEHICLE_STATUS_COUNT);
+            if(v->status == VEHICLE_IN_USE && i < (int)driverIds.size()) v->assignedDriverId = driverIds[i];
+            t->insert(v);
+        }
+    }
+
+    DashboardAggregates aggregates;
+    auto start = chrono::steady_clock::now();
+    aggregates.attach(table);
+    aggregates.attach(auth);
+    double attachMs = msSince(start);
+
+    // Mutation stream; vehicle ids above numVehicles are new vehicles
+    vector<Mutation> mutations;
+    uniform_real_distribution<double> tripKm(1.0, 60.0);
+    int nextVehicle = numVehicles * 2, openTrips = 0;
+    long long tripsStarted = 0;
+    vector<double> completedKm;
+    for(int i = 0; i < numMutations; i++) {
+        int roll = rng() % 100;
+        int vehicle = rng() % numVehicles;
+        if(roll < 35) {
+            mutations.push_back(Mutation{MUTATE_STATUS, vehicle, (int)(rng() % VEHICLE_STATUS_COUNT), 0});
+        } else if(roll < 60) {
+            int driver = rng() % 3 == 0 ? -1 : (int)(rng() % driverIds.size());
+            mutations.push_back(Mutation{MUTATE_DRIVER, vehicle, driver, 0});
+        } else if(roll < 65) {
+            mutations.push_back(Mutation{MUTATE_INSERT, nextVehicle++, 0, 0});
+        } else if(roll < 70) {
+            mutations.push_back(Mutation{MUTATE_DELETE, vehicle, 0, 0});
+        } else if(openTrips == 0 || roll < 85) {
+            mutations.push_back(Mutation{MUTATE_TRIP, 0, 0, 0});
+            openTrips++;
+            tripsStarted++;
+        } else {
+            double km = round(tripKm(rng) * 100) / 100;
+            mutations.push_back(Mutation{MUTATE_TRIP, 0, 1, km});
+            completedKm.push_back(km);
+            openTrips--;
+        }
+    }
+
+    start = chrono::steady_clock::now();
+    replay(table, mutations, driverIds, &aggregates);
+    double observedMs = msSince(start);
+
+    start = chrono::steady_clock::now();
+    replay(plain, mutations, driverIds, NULL);
+    double plainMs = msSince(start);
+
+    // Account changes on worker threads while a reader polls snapshots
+    atomic<bool> done(false);
+    atomic<long long> concurrentReads(0);
+    thread reader([&]() {
+        while(!done.load()) {
+            DashboardSnapshot s = aggregates.snapshot();
+            if(s.users > 0) concurrentReads++;
+        }
+    });
+    vector<thread> workers;
+    for(int w = 0; w < threads; w++) {
+        workers.emplace_back([&, w]() {
+            mt19937 local(100 + w);
+            const char* statuses[] = {"ACTIVE", "ACTIVE", "INACTIVE", "PENDING"};
+            for(int i = 0; i < numUsers; i++) {
+                auth.updateUserStatus(emails[1 + local() % numUsers], statuses[local() % 4]);
+            }
+        });
+    }
+
+    for(thread& t : workers) t.join();
+    done = true;
+    reader.join();
+
+    // Dashboard reads: snapshot copy vs full recount
+    DashboardSnapshot snap;
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for(int r = 0; r < SNAPSHOT_READS; r++) {
+        snap = aggregates.snapshot();
+        checksum += snap.vehicles;
+    }
+    double snapshotNs = msSince(start) * 1e6 / SNAPSHOT_READS;
+
+    DashboardSnapshot full;
+    start = chrono::steady_clock::now();
+    for(int r = 0; r < RECOUNT_ROUNDS; r++) {
+        full = recount(table, auth, emails, tripsStarted, completedKm);
+        checksum += full.vehicles;
+    }
+    double recountMs = msSince(start) / RECOUNT_ROUNDS;
+    bool consistent = sameCounters(snap, full);
+
+    cout << "=== Dashboard Aggregates Benchmark ===" << endl;
+    cout << "Vehicles: " << numVehicles << ", users: " << numUsers << ", mutations: " << numMutations
+         << ", account threads: " << threads << "\n" << endl;
+    cout << fixed << setprecision(1) << "Attach (replays existing rows): " << attachMs << " ms" << endl;
+    cout << "Mutations: " << observedMs << " ms observed vs " << plainMs << " ms unobserved ("
+         << setprecision(1) << (observedMs / plainMs - 1) * 100 << "% overhead)" << endl;
+    cout << "Snapshots read during account updates: " << concurrentReads.load() << endl;
+    cout << setprecision(1) << "Dashboard read: snapshot " << snapshotNs << " ns, full recount "
+         << setprecision(2) << recountMs << " ms (" << setprecision(0) << recountMs * 1e6 / snapshotNs << "x)" << endl;
+    cout << "(checksum " << checksum << ")" << endl;
+    cout << setprecision(2);
+    aggregates.displayStats();
+
+    cout << (consistent ? "✅ Snapshot matches a full recount" : "❌ Snapshot differs from a full recount") << endl;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+// Driver check-in contention benchmark.
+// Half the threads enqueue drivers, half dequeue them, for 1-64 threads.
+// Compares the lock-free DriverQueue with a mutex-guarded std::queue.
+//
+// Usage: driver_queue_bench [operations]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include "driver.h"
+#include "driver_queue.h"
+using namespace std;
+
+// Baseline: what a "just add a mutex" queue looks like
+class LockedDriverQueue {
+private:
+    mutex lock;
+    queue<Driver*> drivers;
+
+public:
+    bool enqueue(Driver* driver) {
+        lock_guard<mutex> guard(lock);
+        drivers.push(driver);
+        return true;
+    }
+
+    Driver* dequeue() {
+        lock_guard<mutex> guard(lock);
+        if(drivers.empty()) return NULL;
+        Driver* driver = drivers.front();
+        drivers.pop();
+        return driver;
+    }
+};
+
+// Returns million operations (enqueue + dequeue) per second
+template <typename Queue>
+double runContention(Queue& q, vector<Driver>& pool, int threads, long operations) {
+    int producers = threads > 1 ? threads / 2 : 1;
+    int consumers = threads > 1 ? threads - producers : 1;
+    long perProducer = operations / producers;
+    long total = perProducer * producers;
+    atomic<long> consumed(0);
+    vector<thread> workers;
+
+    auto start = chrono::steady_clock::now();
+    if(threads == 1) {
+        // Single thread alternates check-in and dispatch
+        for(long i = 0; i < total; i++) {
+            q.enqueue(&pool[i % pool.size()]);
+            q.dequeue();
+        }
+    } else {
+        for(int p = 0; p < producers; p++) {
+            workers.push_back(thread([&, p]() {
+                for(long i = 0; i < perProducer; i++) {
+                    while(!q.enqueue(&pool[(p * perProducer + i) % pool.size()])) {
+                        this_thread::yield();
+                    }
+                }
+            }));
+        }
+        for(int c = 0; c < consumers; c++) {
+            workers.push_back(thread([&]() {
+                while(consumed.load(memory_order_relaxed) < total) {
+                    if(q.dequeue() != NULL) {
+                        consumed.fetch_add(1, memory_order_relaxed);
+                    } else {
+                        this_thread::yield();
+                    }
+                }
+            }));
+        }
+        for(size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return 2.0 * total / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    long operations = argc > 1 ? atol(argv[1]) : 200000;
+
+    vector<Driver> pool;
+    for(int i = 0; i < 4096; i++) {
+        pool.push_back(Driver("D" + to_string(i), "Driver " + to_string(i), "", "", i % 20));
+    }
+
+    cout << "=== Driver Queue Contention Benchmark ===" << endl;
+    cout << "Operations per run: " << operations << endl;
+    cout << "Hardware threads: " << thread::hardware_concurrency() << "\n" << endl;
+    cout << setw(8) << "threads" << setw(14) << "lock-free" << setw(14) << "priority" << setw(14) << "mutex"
+         << "   (M ops/s)" << endl;
+
+    int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    for(int t : threadCounts) {
+        DriverQueue fifo(DRIVER_QUEUE_DEFAULT_CAPACITY, QUEUE_FIFO);
+        DriverQueue priority(DRIVER_QUEUE_DEFAULT_CAPACITY, QUEUE_BY_EXPERIENCE);
+        LockedDriverQueue locked;
+        fifo.setVerbose(false);
+        priority.setVerbose(false);
+
+        double fifoRate = runContention(fifo, pool, t, operations);
+        double priorityRate = runContention(priority, pool, t, operations);
+        double lockedRate = runContention(locked, pool, t, operations);
+        cout << setw(8) << t << fixed << setprecision(2) << setw(14) << fifoRate << setw(14) << priorityRate
+             << setw(14) << lockedRate << endl;
+
+        if(!fifo.isEmpty() || !priority.isEmpty()) {
+            cout << "❌ Queue not drained after run with " << t << " threads" << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
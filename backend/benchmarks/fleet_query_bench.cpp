@@ -0,0 +1,121 @@
+// Fleet query engine benchmark.
+// Builds a FleetStore of random vehicles (plus the same fleet as Vehicle
+// objects) and runs a set of ad-hoc ops filters three ways: a loop over
+// Vehicle pointers evaluating the predicate per object, FleetQueryEngine
+// count(), and FleetQueryEngine vehicleIds(). Every path must agree.
+//
+// Usage: fleet_query_bench [vehicles] [rounds]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "vehicle.h"
+#include "fleet_store.h"
+#include "services/fleet_query.h"
+using namespace std;
+
+struct BenchQuery {
+    const char* text;
+    bool (*matches)(const Vehicle&);
+};
+
+static bool oldTrucks(const Vehicle& v) {
+    return v.year < 2019 && v.type == VEHICLE_TRUCK && v.kilometersRun > 20000 && v.status != VEHICLE_MAINTENANCE;
+}
+
+static bool idleOrOverdue(const Vehicle& v) {
+    return v.status == VEHICLE_AVAILABLE && (v.daysSinceLastService > 90 || v.kilometersRun >= 35000);
+}
+
+static bool rareModel(const Vehicle& v) {
+    return v.type == VEHICLE_SUV && v.year >= 2023 && v.status == VEHICLE_RETIRED && v.daysSinceLastService < 10;
+}
+
+static bool notVanOrCar(const Vehicle& v) {
+    return !(v.type == VEHICLE_VAN || v.type == VEHICLE_CAR) && v.status != VEHICLE_RETIRED;
+}
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 10;
+
+    mt19937 rng(5);
+    vector<Vehicle*> vehicles;
+    FleetStore fleet;
+    fleet.reserve(numVehicles);
+    for(int i = 0; i < numVehicles; i++) {
+        Vehicle* v = new Vehicle("V" + to_string(i), "REG-" + to_string(i), "Model", "", 2010 + rng() % 15);
+        v->type = (VehicleType)(rng() % VEHICLE_TYPE_COUNT);
+        v->status = (VehicleStatus)(rng() % VEHICLE_STATUS_COUNT);
+        v->kilometersRun = (rng() % 400000) / 10.0;
+        v->daysSinceLastService = rng() % 150;
+        fleet.addVehicle(*v);
+        vehicles.push_back(v);
+    }
+
+    BenchQuery queries[] = {
+        {"year < 2019 AND type = Truck AND km > 20000 AND NOT MAINTENANCE", oldTrucks},
+        {"AVAILABLE AND (days > 90 OR km >= 35000)", idleOrOverdue},
+        {"SUV AND year >= 2023 AND RETIRED AND days < 10", rareModel},
+        {"NOT (Van OR Car) AND status != RETIRED", notVanOrCar},
+    };
+
+    cout << "=== Fleet Query Benchmark ===" << endl;
+    cout << "Vehicles: " << fleet.size() << ", rounds: " << rounds << "\n" << endl;
+
+    FleetQueryEngine engine(fleet);
+    bool allMatch = true;
+    cout << fixed << setprecision(3);
+    for(const BenchQuery& q : queries) {
+        FleetQuery query;
+        if(!query.compile(q.text)) {
+            cout << "❌ " << q.text << ": " << query.getError() << endl;
+            return 1;
+        }
+
+        size_t objectCount = 0;
+        auto start = chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++) {
+            objectCount = 0;
+            for(size_t i = 0; i < vehicles.size(); i++) {
+                objectCount += q.matches(*vehicles[i]);
+            }
+        }
+        double objectMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+        size_t engineCount = 0;
+        start = chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++) {
+            engineCount = engine.count(query);
+        }
+        double countMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+        vector<string_view> ids;
+        start = chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++) {
+            engine.vehicleIds(query, ids);
+        }
+        double idsMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+        RoaringBitmap rows = engine.evaluate(query);
+        bool match = objectCount == engineCount && ids.size() == engineCount;
+        allMatch = allMatch && match;
+
+        cout << query.describe() << endl;
+        cout << "  matches:       " << engineCount << (match ? " ✅" : " ❌") << endl;
+        cout << "  per-object:    " << objectMs << " ms" << endl;
+        cout << "  engine count:  " << countMs << " ms (" << objectMs / countMs << "x)" << endl;
+        cout << "  engine IDs:    " << idsMs << " ms" << endl;
+        cout << "  result bitmap: " << rows.memoryBytes() / 1024 << " KB\n" << endl;
+    }
+
+    for(size_t i = 0; i < vehicles.size(); i++) {
+        delete vehicles[i];
+    }
+    cout << "All results match: " << (allMatch ? "✅" : "❌") << endl;
+    return allMatch ? 0 : 1;
+}
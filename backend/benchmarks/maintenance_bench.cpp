@@ -0,0 +1,79 @@
+// Fleet-wide maintenance scoring benchmark.
+// Compares the per-object path (Vehicle::getMaintenancePriority() and
+// needsMaintenance() through a pointer per vehicle) with the columnar
+// MaintenanceScorer kernels over a FleetStore, and checks that every path
+// produces identical priorities and urgency bits.
+//
+// Usage: maintenance_bench [vehicles] [rounds]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "vehicle.h"
+#include "fleet_store.h"
+#include "services/maintenance_scorer.h"
+using namespace std;
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+
+    mt19937 rng(7);
+    vector<Vehicle*> vehicles;
+    FleetStore fleet;
+    fleet.reserve(numVehicles);
+    for(int i = 0; i < numVehicles; i++) {
+        Vehicle* v = new Vehicle("V" + to_string(i), "REG-" + to_string(i), "Model", "Truck", 2020);
+        v->kilometersRun = (rng() % 2000000) / 10.0;
+        v->daysSinceLastService = rng() % 365;
+        vehicles.push_back(v);
+        fleet.addVehicle(*v);
+    }
+
+    cout << "=== Maintenance Scoring Benchmark ===" << endl;
+    cout << "Vehicles: " << numVehicles << ", rounds: " << rounds << "\n" << endl;
+
+    // Per-object baseline
+    vector<int32_t> expectedPriority(numVehicles);
+    vector<uint64_t> expectedBits((numVehicles + 63) / 64);
+    auto start = chrono::steady_clock::now();
+    for(int round = 0; round < rounds; round++) {
+        fill(expectedBits.begin(), expectedBits.end(), 0);
+        for(int i = 0; i < numVehicles; i++) {
+            expectedPriority[i] = vehicles[i]->getMaintenancePriority();
+            if(vehicles[i]->needsMaintenance()) expectedBits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+    double baseline = chrono::duration<double>(chrono::steady_clock::now() - start).count() / rounds;
+    cout << setw(10) << "object" << fixed << setprecision(3) << setw(10) << baseline * 1000 << " ms" << endl;
+
+    ScoringPath paths[] = {SCORING_SCALAR, SCORING_SSE2, SCORING_AVX2};
+    int failures = 0;
+    for(ScoringPath p : paths) {
+        MaintenanceScorer scorer;
+        if(!scorer.setPath(p)) {
+            cout << setw(10) << (p == SCORING_AVX2 ? "AVX2" : "SSE2") << "   (not supported on this CPU)" << endl;
+            continue;
+        }
+        vector<int32_t> priority;
+        vector<uint64_t> bits;
+        start = chrono::steady_clock::now();
+        for(int round = 0; round < rounds; round++) {
+            scorer.scoreFleet(fleet, priority, bits);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / rounds;
+        bool same = (priority == expectedPriority) && (bits == expectedBits);
+        if(!same) failures++;
+        cout << setw(10) << scorer.getPathName() << setw(10) << seconds * 1000 << " ms   "
+             << setprecision(1) << baseline / seconds << "x" << setprecision(3)
+             << (same ? "" : "   ❌ results differ") << endl;
+    }
+
+    for(size_t i = 0; i < vehicles.size(); i++) {
+        delete vehicles[i];
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// Map matching benchmark.
+// Builds a grid city (200 m blocks, ~10% of the streets missing) and drives
+// <trips> trips along shortest routes between random junctions at
+// 25-50 km/h, reporting a fix every <interval> seconds with ~10 m of
+// Gaussian GPS noise. MapMatcher snaps all traces back onto the roads in
+// parallel; the result is compared with the route actually driven:
+//   * edge recall / precision of the matched edge sequence
+//   * error of the matched driven distance
+// and the measured throughput is extrapolated to a fleet-day of traces.
+//
+// Usage: map_matching_bench [trips] [interval s] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <unordered_set>
+#include <cstdlib>
+#include "services/map_matcher.h"
+using namespace std;
+
+#define CITY_SIZE 120                   // Junctions per side
+#define BLOCK_KM 0.2
+#define GPS_NOISE_KM 0.01
+#define FLEET_DAY_VEHICLES 1000
+#define FLEET_DAY_DRIVING_HOURS 10
+#define FLEET_DAY_TARGET_MINUTES 10
+
+struct DrivenTrip {
+    vector<int> arcs;           // Arcs whose stretch was driven between the first and last fix
+    double distanceKm;          // Driven between the first and last fix
+};
+
+static uint64_t edgeKey(int from, int to) {
+    return ((uint64_t)(uint32_t)from << 32) | (uint32_t)to;
+}
+
+int main(int argc, char** argv) {
+    int numTrips = argc > 1 ? atoi(argv[1]) : 2000;
+    double intervalSec = argc > 2 ? atof(argv[2]) : 5.0;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+
+    // City: junction (r, c) at 200 m spacing, weights in metres
+    const double baseLat = 12.90, baseLon = 77.55;
+    const double latStep = BLOCK_KM / KM_PER_DEGREE;
+    const double lonStep = latStep / cos(baseLat * DEGREES_TO_RADIANS);
+    mt19937 rng(23);
+    int n = CITY_SIZE * CITY_SIZE;
+    vector<Arc> arcs;
+    for(int r = 0; r < CITY_SIZE; r++) {
+        for(int c = 0; c < CITY_SIZE; c++) {
+            int u = r * CITY_SIZE + c;
+            int metres = (int)(BLOCK_KM * 1000);
+            if(c + 1 < CITY_SIZE && rng() % 10 != 0) {
+                arcs.push_back(Arc{u, u + 1, metres});
+                arcs.push_back(Arc{u + 1, u, metres});
+            }
+            if(r + 1 < CITY_SIZE && rng() % 10 != 0) {
+                arcs.push_back(Arc{u, u + CITY_SIZE, metres});
+                arcs.push_back(Arc{u + CITY_SIZE, u, metres});
+            }
+        }
+    }
+    CSRGraph city;
+    city.build(n, arcs);
+    for(int v = 0; v < n; v++) {
+        city.setCoordinates(v, baseLat + (v / CITY_SIZE) * latStep, baseLon + (v % CITY_SIZE) * lonStep);
+    }
+
+    auto start = chrono::steady_clock::now();
+    RoadSegmentIndex index(city);
+    double indexMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // Trips: drive the shortest route at a constant speed, sample with noise
+    DijkstraSearch routing(city);
+    RoutePath route;
+    normal_distribution<double> noise(0.0, GPS_NOISE_KM);
+    uniform_real_distribution<double> speedKmh(25.0, 50.0);
+    vector<vector<GpsPoint>> traces;
+    vector<DrivenTrip> truth;
+    long long totalFixes = 0;
+    while((int)traces.size() < numTrips) {
+        int from = rng() % n, to = rng() % n;
+        if(!routing.findRoute(from, to, route) || route.nodes.size() < 10) continue;
+
+        vector<int> pathArcs;
+        for(size_t i = 0; i + 1 < route.nodes.size(); i++) {
+            int u = route.nodes[i], v = route.nodes[i + 1];
+            for(int a = city.arcBegin(u); a < city.arcEnd(u); a++) {
+                if(city.arcTarget(a) == v) {
+                    pathArcs.push_back(a);
+                    break;
+                }
+            }
+        }
+        double kmPerSec = speedKmh(rng) / 3600.0;
+        double totalKm = (route.nodes.size() - 1) * BLOCK_KM;
+        vector<GpsPoint> trace;
+        DrivenTrip driven;
+        double t = 0, lastKm = 0;
+        for(; t * kmPerSec <= totalKm; t += intervalSec) {
+            double km = t * kmPerSec;
+            size_t seg = min((size_t)(km / BLOCK_KM), pathArcs.size() - 1);
+            double f = (km - seg * BLOCK_KM) / BLOCK_KM;
+            int u = route.nodes[seg], v = route.nodes[seg + 1];
+            double lat = city.latitude(u) + f * (city.latitude(v) - city.latitude(u));
+            double lon = city.longitude(u) + f * (city.longitude(v) - city.longitude(u));
+            trace.push_back(GpsPoint{lat + noise(rng) / KM_PER_DEGREE, lon + noise(rng) * lonStep / BLOCK_KM,
+                                     1700000000000LL + (int64_t)(t * 1000)});
+            lastKm = km;
+        }
+        for(size_t a = 0; a < pathArcs.size() && a * BLOCK_KM <= lastKm; a++) {
+            driven.arcs.push_back(pathArcs[a]);
+        }
+        driven.distanceKm = lastKm;
+        totalFixes += (long long)trace.size();
+        traces.push_back(trace);
+        truth.push_back(driven);
+    }
+
+    cout << "=== Map Matching Benchmark ===" << endl;
+    cout << "City: " << n << " junctions, " << city.getNumArcs() << " arcs (" << BLOCK_KM * 1000 << " m blocks)" << endl;
+    cout << "Trips: " << numTrips << ", " << totalFixes << " fixes every " << intervalSec << " s, noise "
+         << GPS_NOISE_KM * 1000 << " m" << endl;
+    cout << "Segment index built in " << fixed << setprecision(1) << indexMs << " ms\n" << endl;
+
+    ThreadPool pool(threads);
+    MapMatcher matcher(index, pool);
+    vector<MatchedTrip> results;
+    start = chrono::steady_clock::now();
+    double matchedKm = matcher.matchAll(traces, results);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Accuracy against the driven routes
+    long long trueEdges = 0, recalled = 0, matchedEdges = 0, correct = 0;
+    double drivenKm = 0, absErrorKm = 0;
+    int perfect = 0;
+    unordered_set<uint64_t> truthSet, matchedSet;
+    for(int i = 0; i < numTrips; i++) {
+        truthSet.clear();
+        matchedSet.clear();
+        for(int a : truth[i].arcs) truthSet.insert(edgeKey(index.arcSource(a), city.arcTarget(a)));
+        for(const MatchedEdge& e : results[i].edges) matchedSet.insert(edgeKey(e.from, e.to));
+        for(uint64_t k : truthSet) recalled += matchedSet.count(k);
+        for(uint64_t k : matchedSet) correct += truthSet.count(k);
+        trueEdges += (long long)truthSet.size();
+        matchedEdges += (long long)matchedSet.size();
+        if(truthSet == matchedSet) perfect++;
+        drivenKm += truth[i].distanceKm;
+        absErrorKm += fabs(results[i].distanceKm - truth[i].distanceKm);
+    }
+
+    double fixesPerSec = totalFixes / seconds;
+    double fleetDayFixes = FLEET_DAY_VEHICLES * FLEET_DAY_DRIVING_HOURS * 3600.0 / intervalSec;
+    double fleetDayMinutes = fleetDayFixes / fixesPerSec / 60.0;
+    double recall = 100.0 * recalled / trueEdges;
+    double precision = 100.0 * correct / (matchedEdges > 0 ? matchedEdges : 1);
+    double distanceError = 100.0 * absErrorKm / drivenKm;
+
+    cout << setprecision(2);
+    cout << "Matched " << numTrips << " trips in " << seconds << " s on " << pool.getNumThreads() << " threads ("
+         << setprecision(0) << fixesPerSec << " fixes/s)" << endl;
+    cout << setprecision(2) << "Edge recall: " << recall << "%, precision: " << precision << "%, exact routes: "
+         << 100.0 * perfect / numTrips << "%" << endl;
+    cout << "Driven distance: " << drivenKm << " km, matched: " << matchedKm << " km, mean abs error: "
+         << distanceError << "%" << endl;
+    cout << "Fleet-day (" << FLEET_DAY_VEHICLES << " vehicles x " << FLEET_DAY_DRIVING_HOURS << " h, "
+         << setprecision(1) << fleetDayFixes / 1e6 << "M fixes): " << fleetDayMinutes << " min" << endl;
+    matcher.displayStats();
+    index.displayStats();
+
+    bool accurate = recall >= 95.0 && precision >= 95.0 && distanceError <= 5.0;
+    bool fastEnough = fleetDayMinutes <= FLEET_DAY_TARGET_MINUTES;
+    cout << (accurate ? "✅ Matched routes agree with the driven routes" : "❌ Matched routes disagree with the driven routes") << endl;
+    cout << (fastEnough ? "✅" : "❌") << " Fleet-day of traces in " << fleetDayMinutes << " min (target "
+         << FLEET_DAY_TARGET_MINUTES << ")" << endl;
+    return accurate && fastEnough ? 0 : 1;
+}
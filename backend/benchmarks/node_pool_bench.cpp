@@ -0,0 +1,168 @@
+// Node allocation benchmark.
+// Builds and tears down linked chains of road Edges and AuthNodes with one
+// `new` per node versus NodePool, counting calls into the global allocator
+// and timing each phase. Also bulk-loads a road network through Graph.
+//
+// Usage: node_pool_bench [nodes]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "graph.h"
+#include "auth_system.h"
+#include "node_pool.h"
+using namespace std;
+
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* p = malloc(size ? size : 1);
+    if(p == NULL) throw bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, align_val_t align) {
+    allocationCount++;
+    size_t alignment = (size_t)align;
+    void* p = aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if(p == NULL) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, align_val_t) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t, align_val_t) noexcept {
+    free(p);
+}
+
+struct Measurement {
+    size_t allocations;
+    double buildMs;
+    double teardownMs;
+};
+
+void printRow(const char* name, const Measurement& m) {
+    cout << setw(22) << name << setw(14) << m.allocations << fixed << setprecision(1)
+         << setw(12) << m.buildMs << setw(14) << m.teardownMs << endl;
+}
+
+double elapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// One heap allocation per node, chains walked to free them
+template <typename Node, typename MakeNode>
+Measurement runHeap(int count, int chains, MakeNode make) {
+    Measurement m;
+    vector<Node*> heads(chains, (Node*)NULL);
+    size_t before = allocationCount;
+    auto start = chrono::steady_clock::now();
+    for(int i = 0; i < count; i++) {
+        Node* node = make(i, (Node*)NULL);
+        node->next = heads[i % chains];
+        heads[i % chains] = node;
+    }
+    m.buildMs = elapsedMs(start);
+    m.allocations = allocationCount - before;
+
+    start = chrono::steady_clock::now();
+    for(int c = 0; c < chains; c++) {
+        Node* current = heads[c];
+        while(current != NULL) {
+            Node* next = current->next;
+            delete current;
+            current = next;
+        }
+    }
+    m.teardownMs = elapsedMs(start);
+    return m;
+}
+
+template <typename Node, typename MakeNode>
+Measurement runPool(int count, int chains, MakeNode make) {
+    Measurement m;
+    vector<Node*> heads(chains, (Node*)NULL);
+    chrono::steady_clock::time_point start;
+    {
+        NodePool<Node> pool;
+        size_t before = allocationCount;
+        start = chrono::steady_clock::now();
+        for(int i = 0; i < count; i++) {
+            Node* node = make(i, &pool);
+            node->next = heads[i % chains];
+            heads[i % chains] = node;
+        }
+        m.buildMs = elapsedMs(start);
+        m.allocations = allocationCount - before;
+        start = chrono::steady_clock::now();
+    }   // Pool releases every block here
+    m.teardownMs = elapsedMs(start);
+    return m;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    int chains = count / 4 > 0 ? count / 4 : 1;
+
+    cout << "=== Node Pool Benchmark ===" << endl;
+    cout << "Nodes: " << count << "\n" << endl;
+    cout << setw(22) << "" << setw(14) << "allocations" << setw(12) << "build ms" << setw(14) << "teardown ms" << endl;
+
+    printRow("Edge (new/delete)", runHeap<Edge>(count, chains, [](int i, Edge*) {
+        return new Edge(i, i % 97);
+    }));
+    printRow("Edge (NodePool)", runPool<Edge>(count, chains, [](int i, NodePool<Edge>* pool) {
+        return pool->create(i, i % 97);
+    }));
+
+    // Emails short enough for the small-string buffer, so only nodes allocate
+    printRow("AuthNode (new/delete)", runHeap<AuthNode>(count, chains, [](int i, AuthNode*) {
+        return new AuthNode("u" + to_string(i), (uint64_t)i, (User*)NULL);
+    }));
+    printRow("AuthNode (NodePool)", runPool<AuthNode>(count, chains, [](int i, NodePool<AuthNode>* pool) {
+        return pool->create("u" + to_string(i), (uint64_t)i, (User*)NULL);
+    }));
+
+    // Whole road network through Graph (its edges come from a NodePool)
+    int side = 1;
+    while((side + 1) * (side + 1) * 2 <= count) side++;
+    size_t graphAllocations;
+    double buildMs;
+    chrono::steady_clock::time_point start;
+    {
+        Graph city;
+        city.setVerbose(false);
+        size_t before = allocationCount;
+        start = chrono::steady_clock::now();
+        for(int v = 0; v < side * side; v++) {
+            city.addLocation("J");
+        }
+        for(int r = 0; r < side; r++) {
+            for(int c = 0; c < side; c++) {
+                if(c + 1 < side) city.addRoad(r * side + c, r * side + c + 1, 1);
+                if(r + 1 < side) city.addRoad(r * side + c, (r + 1) * side + c, 1);
+            }
+        }
+        buildMs = elapsedMs(start);
+        graphAllocations = allocationCount - before;
+        start = chrono::steady_clock::now();
+    }
+    cout << "\nGraph bulk load: " << 2 * side * (side - 1) << " roads, " << graphAllocations
+         << " allocations, build " << fixed << setprecision(1) << buildMs << " ms, teardown "
+         << elapsedMs(start) << " ms" << endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Session validation benchmark.
+// Starts <sessions> sessions for ACTIVE accounts through AuthSystem, then
+// validates random tokens from 1..64 threads and reports ns per call and
+// total throughput for AuthSystem::validateSession() (session lookup plus
+// the user's active flag), for SessionStore::validate() alone, and for a
+// single unordered_map behind one shared_mutex - what a store without
+// sharding would look like. Finishes with the cost of revoking a user and
+// of sweeping expired sessions.
+//
+// Usage: session_bench [sessions] [validations per thread]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdlib>
+#include "session_store.h"
+#include "auth_system.h"
+using namespace std;
+
+#define BENCH_USERS 1000
+
+// Baseline: one map, one lock
+class GlobalLockSessions {
+private:
+    mutable shared_mutex lock;
+    unordered_map<string, User*> sessions;
+
+public:
+    void add(const string& token, User* user) {
+        unique_lock<shared_mutex> guard(lock);
+        sessions[token] = user;
+    }
+
+    User* validate(string_view token) const {
+        shared_lock<shared_mutex> guard(lock);
+        auto it = sessions.find(string(token));
+        return it == sessions.end() ? NULL : it->second;
+    }
+};
+
+template <typename Validate>
+double runThreads(int threads, int perThread, const vector<string_view>& tokens, Validate validate, long long& misses) {
+    atomic<bool> go(false);
+    atomic<long long> missed(0);
+    vector<thread> workers;
+    for(int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            uint64_t state = 0x9E3779B97F4A7C15ULL * (t + 1);
+            long long localMisses = 0;
+            while(!go.load()) this_thread::yield();
+            for(int i = 0; i < perThread; i++) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                if(validate(tokens[state % tokens.size()]) == NULL) localMisses++;
+            }
+            missed += localMisses;
+        }));
+    }
+    auto start = chrono::steady_clock::now();
+    go.store(true);
+    for(size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    misses = missed.load();
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+}
+
+// Tokens back to back in one buffer, as they would sit in request buffers
+static vector<string_view> packTokens(const vector<string>& tokens, string& bytes) {
+    bytes.clear();
+    for(const string& token : tokens) bytes += token;
+    vector<string_view> views;
+    for(size_t i = 0; i < tokens.size(); i++) {
+        views.push_back(string_view(bytes).substr(i * SESSION_TOKEN_CHARS, SESSION_TOKEN_CHARS));
+    }
+    return views;
+}
+
+int main(int argc, char** argv) {
+    int sessionCount = argc > 1 ? atoi(argv[1]) : 100000;
+    int perThread = argc > 2 ? atoi(argv[2]) : 1000000;
+
+    // Cheap hashing parameters: this is not measuring scrypt
+    AuthSystem auth(ScryptParams(16, 1, 1));
+    auth.setVerbose(false);
+    vector<string> emails;
+    vector<User*> users;
+    for(int i = 0; i < BENCH_USERS; i++) {
+        emails.push_back("driver" + to_string(i) + "@fleet.com");
+        auth.registerUser(emails.back(), "pw", "Driver " + to_string(i));
+        auth.updateUserStatus(emails.back(), "ACTIVE");
+        users.push_back(auth.getUserByEmail(emails.back()));
+    }
+
+    SessionStore store;
+    GlobalLockSessions baseline;
+    vector<string> authTokens, storeTokens;
+    for(int i = 0; i < sessionCount; i++) {
+        authTokens.push_back(auth.startSession(emails[i % BENCH_USERS], "pw"));
+        baseline.add(authTokens.back(), users[i % BENCH_USERS]);
+        storeTokens.push_back(store.issue(users[i % BENCH_USERS], 0));
+    }
+    string authBytes, storeBytes;
+    vector<string_view> authViews = packTokens(authTokens, authBytes);
+    vector<string_view> storeViews = packTokens(storeTokens, storeBytes);
+
+    cout << "=== Session Validation Benchmark ===" << endl;
+    cout << "Sessions: " << auth.getSessionCount() << ", validations per thread: " << perThread
+         << ", hardware threads: " << thread::hardware_concurrency() << "\n" << endl;
+    cout << left << setw(9) << "Threads" << setw(14) << "auth ns/op" << setw(14) << "store ns/op"
+         << setw(15) << "global ns/op" << setw(14) << "auth Mops/s" << "global Mops/s" << endl;
+
+    int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    long long misses = 0;
+    for(int threads : threadCounts) {
+        long long authMisses = 0, storeMisses = 0, globalMisses = 0;
+        double viaAuth = runThreads(threads, perThread, authViews,
+            [&](string_view token) { return auth.validateSession(token); }, authMisses);
+        double viaStore = runThreads(threads, perThread, storeViews,
+            [&](string_view token) { return store.validate(token, 1); }, storeMisses);
+        double global = runThreads(threads, perThread, authViews,
+            [&](string_view token) { return baseline.validate(token); }, globalMisses);
+        misses += authMisses + storeMisses + globalMisses;
+
+        double ops = (double)threads * perThread;
+        // ns/op is wall time over all validations (inverse throughput)
+        cout << left << setw(9) << threads << fixed << setprecision(1)
+             << setw(14) << viaAuth / ops << setw(14) << viaStore / ops << setw(15) << global / ops
+             << setw(14) << ops / viaAuth * 1000.0 << ops / global * 1000.0 << endl;
+    }
+    cout << "\nUnexpected misses: " << misses << (misses == 0 ? " ✅" : " ❌") << endl;
+
+    auto start = chrono::steady_clock::now();
+    int revoked = store.revokeUser(users[0]);
+    double revokeUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    cout << "revokeUser: " << revoked << " sessions in " << setprecision(1) << revokeUs << " us" << endl;
+
+    start = chrono::steady_clock::now();
+    int expired = store.advance(SESSION_DEFAULT_TTL);
+    double sweepMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "advance past TTL: " << expired << " sessions expired in " << setprecision(2) << sweepMs << " ms" << endl;
+    cout << "Sessions left: " << store.size() << (store.size() == 0 ? " ✅" : " ❌") << endl;
+    return 0;
+}
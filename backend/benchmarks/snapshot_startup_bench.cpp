@@ -0,0 +1,153 @@
+// Fleet startup benchmark.
+// Persists the same fleet two ways and times a restart from each:
+//   * FleetJournal snapshot - parse every row, construct one heap Vehicle
+//     per row and insert it into a HashTable (the current startup path);
+//   * MappedFleet snapshot - mmap the file and serve lookups in place.
+// Both files are dropped from the page cache before each timed open, so
+// the numbers include reading from disk. After opening, both sides answer
+// the same random vehicleId lookups and must agree.
+//
+// Usage: snapshot_startup_bench [vehicles] [lookups] [path prefix]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "mapped_fleet.h"
+#include "services/fleet_journal.h"
+using namespace std;
+
+static double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void dropFromPageCache(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 1000000;
+    int lookups = argc > 2 ? atoi(argv[2]) : 10000;
+    string prefix = argc > 3 ? argv[3] : "snapshot_bench";
+    string journalPrefix = prefix + "_journal";
+    string mappedPath = prefix + ".fleet";
+
+    const char* typeNames[] = {"Truck", "Van", "Car", "SUV", "Bus"};
+    const char* models[] = {"Tata Ace", "Ashok Leyland 1616", "Eicher Pro", "Maruti Ertiga", "Force Traveller"};
+    mt19937 rng(5);
+    vector<string> ids;
+    {
+        unlink((journalPrefix + ".wal").c_str());
+        unlink((journalPrefix + ".snap").c_str());
+        HashTable table;
+        table.setVerbose(false);
+        FleetJournal writer(table, journalPrefix);
+        writer.setVerbose(false);
+        writer.recover();
+
+        // Bulk-load behind the journal and checkpoint: only the snapshot matters here
+        table.reserve(numVehicles);
+        for(int i = 0; i < numVehicles; i++) {
+            Vehicle* v = new Vehicle("V" + to_string(i), "REG-" + to_string(100000 + i), models[rng() % 5],
+                                     typeNames[rng() % 5], 2005 + (int)(rng() % 20));
+            v->status = (VehicleStatus)(rng() % VEHICLE_STATUS_COUNT);
+            v->kilometersRun = (double)(rng() % 300000);
+            v->daysSinceLastService = (int)(rng() % 365);
+            if(v->status == VEHICLE_IN_USE) v->assignedDriverId = "D" + to_string(i);
+            table.insert(v);
+            ids.push_back(v->vehicleId);
+        }
+        writer.checkpoint();
+
+        MappedFleetWriter mappedWriter;
+        mappedWriter.addAll(table);
+        mappedWriter.write(mappedPath);
+    }
+
+    vector<string> probes;
+    for(int i = 0; i < lookups; i++) {
+        probes.push_back(rng() % 10 == 0 ? "X" + to_string(i) : ids[rng() % ids.size()]);
+    }
+
+    cout << "=== Fleet Startup Benchmark ===" << endl;
+    cout << "Vehicles: " << numVehicles << ", lookups after start: " << lookups << "\n" << endl;
+
+    // Row-by-row: parse the journal snapshot into heap Vehicles
+    dropFromPageCache(journalPrefix + ".snap");
+    auto start = chrono::steady_clock::now();
+    HashTable restored;
+    restored.setVerbose(false);
+    FleetJournal journal(restored, journalPrefix);
+    journal.setVerbose(false);
+    journal.recover();
+    double rowStartMs = msSince(start);
+    start = chrono::steady_clock::now();
+    size_t rowFound = 0;
+    for(const string& id : probes) {
+        if(restored.search(id) != NULL) rowFound++;
+    }
+    double rowLookupMs = msSince(start);
+
+    // Mapped: header check only, pages fault in on demand
+    dropFromPageCache(mappedPath);
+    start = chrono::steady_clock::now();
+    MappedFleet mapped;
+    mapped.open(mappedPath);
+    double mappedStartMs = msSince(start);
+    start = chrono::steady_clock::now();
+    size_t mappedFound = 0;
+    for(const string& id : probes) {
+        if(mapped.find(id) != MAPPED_NO_ROW) mappedFound++;
+    }
+    double mappedLookupMs = msSince(start);
+
+    dropFromPageCache(mappedPath);
+    start = chrono::steady_clock::now();
+    MappedFleet verified;
+    verified.open(mappedPath, true);
+    double verifiedStartMs = msSince(start);
+
+    // Both sides must describe the same fleet
+    bool same = rowFound == mappedFound && restored.getTotalVehicles() == (int)mapped.size();
+    for(size_t i = 0; i < probes.size() && same; i++) {
+        Vehicle* v = restored.search(probes[i]);
+        uint32_t row = mapped.find(probes[i]);
+        if(v == NULL || row == MAPPED_NO_ROW) {
+            same = (v == NULL) == (row == MAPPED_NO_ROW);
+            continue;
+        }
+        Vehicle loaded;
+        same = mapped.load(row, loaded) && loaded.registrationNumber == v->registrationNumber && loaded.model == v->model &&
+               loaded.type == v->type && loaded.year == v->year && loaded.kilometersRun == v->kilometersRun &&
+               loaded.daysSinceLastService == v->daysSinceLastService && loaded.status == v->status &&
+               loaded.assignedDriverId == v->assignedDriverId;
+    }
+
+    cout << fixed << setprecision(2);
+    cout << left << setw(34) << "Startup path" << right << setw(12) << "open ms" << setw(14) << "lookups ms" << endl;
+    cout << left << setw(34) << "Row-by-row (journal snapshot)" << right << setw(12) << rowStartMs << setw(14) << rowLookupMs << endl;
+    cout << left << setw(34) << "Mapped, header check" << right << setw(12) << mappedStartMs << setw(14) << mappedLookupMs << endl;
+    cout << left << setw(34) << "Mapped, full CRC verify" << right << setw(12) << verifiedStartMs << setw(14) << "-" << endl;
+    cout << "\nStartup speedup: " << setprecision(0) << rowStartMs / (mappedStartMs > 0.001 ? mappedStartMs : 0.001) << "x" << endl;
+    struct stat info;
+    long long journalBytes = stat((journalPrefix + ".snap").c_str(), &info) == 0 ? (long long)info.st_size : 0;
+    cout << "File sizes: journal snapshot " << journalBytes / (1024 * 1024) << " MB, mapped snapshot "
+         << mapped.getFileBytes() / (1024 * 1024) << " MB" << endl;
+    mapped.displayStats();
+    cout << (same ? "✅ Lookups agree" : "❌ Lookups disagree") << " (" << mappedFound << " of " << lookups << " found)" << endl;
+
+    unlink((journalPrefix + ".wal").c_str());
+    unlink((journalPrefix + ".snap").c_str());
+    unlink(mappedPath.c_str());
+    return same ? 0 : 1;
+}
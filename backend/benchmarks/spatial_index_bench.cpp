@@ -0,0 +1,137 @@
+// Spatial index benchmark.
+// Scatters vehicles over a ~40 km metro area with random statuses and
+// times the dispatch questions two ways: a linear scan computing
+// haversineKm() for every vehicle, and SpatialGrid. Queries:
+//   * 5 nearest AVAILABLE vehicles to a pickup point
+//   * every AVAILABLE vehicle within 5 km
+// plus the cost of incremental moves (GPS updates of up to ~50 m).
+// Both methods must return the same vehicles.
+//
+// Usage: spatial_index_bench [vehicles] [queries] [cell km]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "spatial_grid.h"
+using namespace std;
+
+struct Position {
+    string id;
+    double lat;
+    double lon;
+    VehicleStatus status;
+};
+
+static double usSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 100000;
+    int queries = argc > 2 ? atoi(argv[2]) : 2000;
+    double cellKm = argc > 3 ? atof(argv[3]) : 1.0;
+
+    const double centerLat = 12.9716, centerLon = 77.5946, spread = 0.18;    // ~ +/-20 km
+    mt19937 rng(17);
+    uniform_real_distribution<double> offset(-spread, spread);
+    vector<Position> fleet;
+    SpatialGrid grid(cellKm);
+    for(int i = 0; i < numVehicles; i++) {
+        Position p{"V" + to_string(i), centerLat + offset(rng), centerLon + offset(rng), (VehicleStatus)(rng() % VEHICLE_STATUS_COUNT)};
+        grid.upsert(p.id, p.lat, p.lon, p.status);
+        fleet.push_back(p);
+    }
+    vector<pair<double, double>> pickups;
+    for(int q = 0; q < queries; q++) pickups.push_back(make_pair(centerLat + offset(rng), centerLon + offset(rng)));
+
+    cout << "=== Spatial Index Benchmark ===" << endl;
+    cout << "Vehicles: " << numVehicles << ", queries: " << queries << ", cell: " << cellKm << " km\n" << endl;
+
+    uint32_t available = VEHICLE_STATUS_BIT(VEHICLE_AVAILABLE);
+    const size_t k = 5;
+    const double radiusKm = 5.0;
+    int mismatches = 0;
+
+    // k nearest
+    vector<vector<string>> scanKnn(queries);
+    vector<pair<double, int>> scored;
+    auto start = chrono::steady_clock::now();
+    for(int q = 0; q < queries; q++) {
+        scored.clear();
+        for(int i = 0; i < numVehicles; i++) {
+            if(fleet[i].status != VEHICLE_AVAILABLE) continue;
+            scored.push_back(make_pair(haversineKm(pickups[q].first, pickups[q].second, fleet[i].lat, fleet[i].lon), i));
+        }
+        size_t take = min(k, scored.size());
+        partial_sort(scored.begin(), scored.begin() + take, scored.end());
+        for(size_t j = 0; j < take; j++) scanKnn[q].push_back(fleet[scored[j].second].id);
+    }
+    double scanKnnUs = usSince(start) / queries;
+
+    vector<SpatialMatch> matches;
+    start = chrono::steady_clock::now();
+    for(int q = 0; q < queries; q++) {
+        grid.nearest(pickups[q].first, pickups[q].second, k, available, matches);
+        if(matches.size() != scanKnn[q].size()) {
+            mismatches++;
+            continue;
+        }
+        for(size_t j = 0; j < matches.size(); j++) {
+            if(matches[j].vehicleId != scanKnn[q][j]) mismatches++;
+        }
+    }
+    double gridKnnUs = usSince(start) / queries;
+
+    // Radius
+    vector<size_t> scanCounts(queries);
+    start = chrono::steady_clock::now();
+    for(int q = 0; q < queries; q++) {
+        size_t n = 0;
+        for(int i = 0; i < numVehicles; i++) {
+            if(fleet[i].status == VEHICLE_AVAILABLE &&
+               haversineKm(pickups[q].first, pickups[q].second, fleet[i].lat, fleet[i].lon) <= radiusKm) n++;
+        }
+        scanCounts[q] = n;
+    }
+    double scanRadiusUs = usSince(start) / queries;
+
+    size_t radiusTotal = 0;
+    start = chrono::steady_clock::now();
+    for(int q = 0; q < queries; q++) {
+        grid.withinRadius(pickups[q].first, pickups[q].second, radiusKm, available, matches);
+        if(matches.size() != scanCounts[q]) mismatches++;
+        radiusTotal += matches.size();
+    }
+    double gridRadiusUs = usSince(start) / queries;
+
+    // Incremental moves
+    uniform_real_distribution<double> step(-0.00045, 0.00045);
+    int moves = numVehicles * 5;
+    start = chrono::steady_clock::now();
+    for(int m = 0; m < moves; m++) {
+        Position& p = fleet[rng() % numVehicles];
+        p.lat += step(rng);
+        p.lon += step(rng);
+        grid.updatePosition(p.id, p.lat, p.lon);
+    }
+    double moveNs = usSince(start) * 1000.0 / moves;
+    grid.nearest(pickups[0].first, pickups[0].second, k, available, matches);
+
+    cout << fixed << setprecision(2);
+    cout << left << setw(28) << "Query" << right << setw(14) << "scan us" << setw(14) << "grid us" << setw(12) << "speedup" << endl;
+    cout << left << setw(28) << "5 nearest AVAILABLE" << right << setw(14) << scanKnnUs << setw(14) << gridKnnUs
+         << setw(11) << scanKnnUs / gridKnnUs << "x" << endl;
+    cout << left << setw(28) << "AVAILABLE within 5 km" << right << setw(14) << scanRadiusUs << setw(14) << gridRadiusUs
+         << setw(11) << scanRadiusUs / gridRadiusUs << "x" << endl;
+    cout << "\nAverage vehicles within 5 km: " << setprecision(0) << (double)radiusTotal / queries << endl;
+    cout << setprecision(1) << "Incremental move: " << moveNs << " ns" << endl;
+    grid.displayStats();
+    cout << (mismatches == 0 ? "✅ Grid matches linear scan" : "❌ Grid disagrees with linear scan")
+         << " (" << mismatches << " mismatches)" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+// Telemetry history benchmark.
+// Simulates <days> days of tracker data for <vehicles> vehicles: trips of
+// 20-60 minutes reporting every <interval> seconds (a few ms of clock
+// jitter, ~3 m of GPS noise, speed in 0.1 km/h steps), separated by stops
+// where the parked vehicle still reports once a minute. The same history is
+// kept two ways:
+//   * row store: one 32-byte {timestamp, lat, lon, speed} row per sample in
+//     a time-sorted vector per vehicle (binary search for ranges);
+//   * TimeSeriesStore: Gorilla-compressed blocks with min/max time index.
+// Then random 1-day and 7-day per-vehicle range scans run on both and must
+// return the same samples; the store is also saved and reloaded, and
+// hand-built files whose speed column holds a bad XOR window (with valid
+// CRCs) must be refused by load().
+//
+// Usage: telemetry_history_bench [vehicles] [days] [interval s] [queries]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "time_series_store.h"
+#include "crc32.h"
+#include "geo.h"
+using namespace std;
+
+#define DAY_MS 86400000LL
+#define HISTORY_FILE "telemetry_history_bench.fts"
+#define CORRUPT_FILE "telemetry_history_bench_corrupt.fts"
+
+struct Row {
+    int64_t timestampMs;
+    double latitude;
+    double longitude;
+    float speed;
+};
+
+static void writeColumn(FILE* f, const BitColumn& c) {
+    uint64_t n = (c.bitCount + 63) / 64;
+    fwrite(&c.bitCount, sizeof(c.bitCount), 1, f);
+    fwrite(&n, sizeof(n), 1, f);
+    fwrite(c.words.data(), sizeof(uint64_t), n, f);
+}
+
+// One vehicle, one block, one sample at t=0 whose speed is XOR-coded with
+// the given window: control bits '11' + lead + (length - 1) for a new
+// window, '10' to reuse one. The CRC is valid, so only decoding can tell.
+static bool loadsWithWindow(bool newWindow, int lead, int length) {
+    BitColumn columns[4];
+    columns[0].write(0, 1);     // Timestamp, latitude, longitude: zero deltas
+    columns[1].write(0, 1);
+    columns[2].write(0, 1);
+    columns[3].write(1, 1);     // Not in tenths -> XOR code
+    columns[3].write(1, 1);     // Value changed
+    columns[3].write(newWindow ? 1 : 0, 1);
+    if(newWindow) {
+        columns[3].write((uint64_t)lead, 5);
+        columns[3].write((uint64_t)(length - 1), 5);
+    }
+    columns[3].write(0xFFFFFFFFu, 32);
+
+    int64_t minMs = 0, maxMs = 0;
+    uint32_t count = 1;
+    uint32_t crc = crc32(&minMs, sizeof(minMs));
+    crc = crc32(&maxMs, sizeof(maxMs), crc);
+    crc = crc32(&count, sizeof(count), crc);
+    for(int c = 0; c < 4; c++) {
+        crc = crc32(&columns[c].bitCount, sizeof(columns[c].bitCount), crc);
+        crc = crc32(columns[c].words.data(), (columns[c].bitCount + 63) / 64 * 8, crc);
+    }
+
+    FILE* f = fopen(CORRUPT_FILE, "wb");
+    if(f == NULL) return false;
+    uint32_t head[2] = {SERIES_MAGIC, SERIES_VERSION};
+    uint64_t numVehicles = 1, numBlocks = 1;
+    uint32_t idLength = 2;
+    fwrite(head, sizeof(head), 1, f);
+    fwrite(&numVehicles, sizeof(numVehicles), 1, f);
+    fwrite(&idLength, sizeof(idLength), 1, f);
+    fwrite("V0", 1, idLength, f);
+    fwrite(&numBlocks, sizeof(numBlocks), 1, f);
+    fwrite(&minMs, sizeof(minMs), 1, f);
+    fwrite(&maxMs, sizeof(maxMs), 1, f);
+    fwrite(&count, sizeof(count), 1, f);
+    for(int c = 0; c < 4; c++) writeColumn(f, columns[c]);
+    fwrite(&crc, sizeof(crc), 1, f);
+    fclose(f);
+
+    TimeSeriesStore store;
+    bool loaded = store.load(CORRUPT_FILE);
+    remove(CORRUPT_FILE);
+    return loaded;
+}
+
+static double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 20;
+    int days = argc > 2 ? atoi(argv[2]) : 90;
+    int intervalSec = argc > 3 ? atoi(argv[3]) : 10;
+    int queries = argc > 4 ? atoi(argv[4]) : 200;
+
+    mt19937 rng(24);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    normal_distribution<double> gpsNoise(0.0, 3.0 / 111195.0);     // ~3 m in degrees
+    vector<string> ids;
+    vector<vector<Row>> rows(numVehicles);
+    TimeSeriesStore store;
+    const int64_t epoch = 1700000000000LL;
+
+    double appendMs = 0;
+    for(int v = 0; v < numVehicles; v++) {
+        ids.push_back("V" + to_string(1000 + v));
+        double lat = 12.9716 + (unit(rng) - 0.5) * 0.2, lon = 77.5946 + (unit(rng) - 0.5) * 0.2;
+        for(int d = 0; d < days; d++) {
+            // Working day 08:00-18:00 in alternating trips and stops
+            int64_t t = epoch + d * DAY_MS + 8 * 3600000LL;
+            int64_t endOfDay = epoch + d * DAY_MS + 18 * 3600000LL;
+            while(t < endOfDay) {
+                int64_t tripEnd = t + (int64_t)(20 + unit(rng) * 40) * 60000;
+                double heading = unit(rng) * 6.2831853, kmh = 30;
+                for(; t < tripEnd; t += intervalSec * 1000LL + (int64_t)(rng() % 7) - 3) {
+                    kmh = min(70.0, max(5.0, kmh + (unit(rng) - 0.5) * 8));
+                    heading += (unit(rng) - 0.5) * 0.3;
+                    double km = kmh * intervalSec / 3600.0;
+                    lat += km * cos(heading) / 111.195;
+                    lon += km * sin(heading) / (111.195 * cos(lat * DEGREES_TO_RADIANS));
+                    float speed = (float)(round(kmh * 10) / 10);
+                    rows[v].push_back(Row{t, lat + gpsNoise(rng), lon + gpsNoise(rng), speed});
+                }
+                int64_t stopEnd = t + (int64_t)(5 + unit(rng) * 55) * 60000;
+                double parkedLat = lat + gpsNoise(rng), parkedLon = lon + gpsNoise(rng);
+                for(; t < stopEnd; t += 60000) rows[v].push_back(Row{t, parkedLat, parkedLon, 0.0f});
+            }
+        }
+
+        auto start = chrono::steady_clock::now();
+        for(Row& r : rows[v]) {
+            store.append(ids[v], TelemetrySample{r.timestampMs, r.latitude, r.longitude, r.speed});
+        }
+        appendMs += msSince(start);
+        // Compare against what the store keeps: 1e-7 degree coordinates
+        for(Row& r : rows[v]) {
+            r.latitude = llround(r.latitude * SERIES_COORD_SCALE) / SERIES_COORD_SCALE;
+            r.longitude = llround(r.longitude * SERIES_COORD_SCALE) / SERIES_COORD_SCALE;
+        }
+    }
+
+    long long samples = store.getSampleCount();
+    size_t rowBytes = (size_t)samples * sizeof(Row);
+    size_t storeBytes = store.getCompressedBytes();
+    cout << "=== Telemetry History Benchmark ===" << endl;
+    cout << "Vehicles: " << numVehicles << ", days: " << days << ", driving fix every " << intervalSec << " s, "
+         << samples << " samples" << endl;
+    cout << fixed << setprecision(1) << "Append: " << samples / (appendMs / 1000.0) / 1e6 << "M samples/s\n" << endl;
+
+    // Range scans: 1-day and 7-day windows of random vehicles
+    int mismatches = 0;
+    double rowScanMs[2] = {0, 0}, storeScanMs[2] = {0, 0}, countMs = 0;
+    long long scanned[2] = {0, 0};
+    vector<TelemetrySample> out;
+    int windows[2] = {1, 7};
+    for(int w = 0; w < 2; w++) {
+        for(int q = 0; q < queries; q++) {
+            int v = rng() % numVehicles;
+            int64_t from = epoch + (int64_t)(rng() % max(1, days - windows[w] + 1)) * DAY_MS;
+            int64_t to = from + windows[w] * DAY_MS - 1;
+
+            auto start = chrono::steady_clock::now();
+            auto first = lower_bound(rows[v].begin(), rows[v].end(), from, [](const Row& r, int64_t t) {
+                return r.timestampMs < t;
+            });
+            double rowChecksum = 0;
+            size_t rowCount = 0;
+            for(auto it = first; it != rows[v].end() && it->timestampMs <= to; ++it) {
+                rowChecksum += it->latitude + it->speed;
+                rowCount++;
+            }
+            rowScanMs[w] += msSince(start);
+
+            start = chrono::steady_clock::now();
+            double storeChecksum = 0;
+            size_t storeCount = store.forEachInRange(ids[v], from, to, [&](const TelemetrySample& s) {
+                storeChecksum += s.latitude + s.speed;
+            });
+            storeScanMs[w] += msSince(start);
+            scanned[w] += (long long)storeCount;
+
+            start = chrono::steady_clock::now();
+            size_t counted = store.count(ids[v], from, to);
+            countMs += msSince(start);
+
+            if(rowCount != storeCount || counted != rowCount || rowChecksum != storeChecksum) mismatches++;
+            if(q % 20 == 0) {
+                // Field-by-field check on a sample of the queries
+                out.clear();
+                store.scan(ids[v], from, to, out);
+                for(size_t i = 0; i < out.size(); i++) {
+                    const Row& r = first[i];
+                    if(out[i].timestampMs != r.timestampMs || out[i].latitude != r.latitude ||
+                       out[i].longitude != r.longitude || out[i].speed != r.speed) {
+                        mismatches++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Persistence round trip
+    auto start = chrono::steady_clock::now();
+    bool saved = store.save(HISTORY_FILE);
+    double saveMs = msSince(start);
+    TimeSeriesStore reloaded;
+    start = chrono::steady_clock::now();
+    bool loaded = reloaded.load(HISTORY_FILE);
+    double loadMs = msSince(start);
+    remove(HISTORY_FILE);
+    bool roundTrip = saved && loaded && reloaded.getSampleCount() == samples;
+    for(int v = 0; roundTrip && v < numVehicles; v++) {
+        roundTrip = reloaded.count(ids[v], INT64_MIN, INT64_MAX) == rows[v].size();
+    }
+
+    // A full 32-bit window loads; one wider than 32 bits, or a reused
+    // window before any was written, must not
+    bool corruptRejected = loadsWithWindow(true, 0, 32) && !loadsWithWindow(true, 31, 32) &&
+                           !loadsWithWindow(false, 0, 0);
+
+    cout << left << setw(24) << "Layout" << right << setw(12) << "MB" << setw(12) << "B/sample"
+         << setw(14) << "1-day ms" << setw(14) << "7-day ms" << endl;
+    cout << left << setw(24) << "Row store" << right << setw(12) << rowBytes / 1048576.0 << setw(12)
+         << (double)rowBytes / samples << setw(14) << setprecision(3) << rowScanMs[0] / queries
+         << setw(14) << rowScanMs[1] / queries << endl;
+    cout << left << setw(24) << "TimeSeriesStore" << right << setw(12) << setprecision(1) << storeBytes / 1048576.0
+         << setw(12) << setprecision(2) << (double)storeBytes / samples << setw(14) << setprecision(3)
+         << storeScanMs[0] / queries << setw(14) << storeScanMs[1] / queries << endl;
+    cout << setprecision(1) << "\nFootprint: " << (double)rowBytes / storeBytes << "x smaller; scan decodes "
+         << (scanned[0] + scanned[1]) / ((storeScanMs[0] + storeScanMs[1]) / 1000.0) / 1e6 << "M samples/s" << endl;
+    cout << setprecision(3) << "count() per query: " << countMs / (2 * queries) << " ms" << endl;
+    cout << setprecision(1) << "Save: " << saveMs << " ms, load: " << loadMs << " ms" << endl;
+    store.displayStats();
+
+    bool compact = rowBytes >= 4 * storeBytes;
+    cout << (mismatches == 0 ? "✅ Range scans match the row store" : "❌ Range scans differ from the row store")
+         << " (" << mismatches << " mismatches)" << endl;
+    cout << (roundTrip ? "✅ Save/load round trip" : "❌ Save/load round trip failed") << endl;
+    cout << (corruptRejected ? "✅ Corrupt XOR windows rejected on load" : "❌ Corrupt XOR window accepted or valid one refused")
+         << endl;
+    cout << (compact ? "✅" : "❌") << " " << setprecision(1) << (double)rowBytes / storeBytes
+         << "x smaller than rows (target 4x)" << endl;
+    return mismatches == 0 && roundTrip && corruptRejected && compact ? 0 : 1;
+}
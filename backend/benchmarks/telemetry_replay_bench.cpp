@@ -0,0 +1,169 @@
+// GPS telemetry replay benchmark.
+// Simulates <trips> ongoing trips each reporting once per second for
+// <seconds> seconds, with ~2% of pings delivered two seconds late (after
+// newer ones), packed into text frames of <frame> lines as a batching
+// client would POST them. The frames are replayed on one thread two ways:
+//   * per-ping: parse, update a mutex-guarded map, and build one UPDATE
+//     statement per ping (what /api/trips/location does today, minus the
+//     round trip to Postgres);
+//   * TelemetryIngest: lock-free position table, flushed every <flush ms>
+//     of simulated time as one multi-row UPDATE per batch.
+// Both must end with the same latest position for every trip.
+//
+// Usage: telemetry_replay_bench [trips] [seconds] [flush ms] [frame lines]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <cstdio>
+#include <cstdlib>
+#include "services/telemetry_ingest.h"
+using namespace std;
+
+#define REPLAY_TARGET_PINGS_PER_SEC 100000
+
+struct Frame {
+    string text;
+    int64_t sentMs;
+};
+
+// UPDATE text for one position; both paths pay for formatting their rows
+static void appendRow(string& sql, string_view tripId, double lat, double lon) {
+    char row[96];
+    int n = snprintf(row, sizeof(row), "('%.*s',%.7f,%.7f),", (int)tripId.size(), tripId.data(), lat, lon);
+    sql.append(row, (size_t)n);
+}
+
+int main(int argc, char** argv) {
+    int numTrips = argc > 1 ? atoi(argv[1]) : 20000;
+    int seconds = argc > 2 ? atoi(argv[2]) : 60;
+    int flushMs = argc > 3 ? atoi(argv[3]) : 5000;
+    int frameLines = argc > 4 ? atoi(argv[4]) : 500;
+
+    // Build the replay: every trip drives a random walk around Bengaluru
+    mt19937 rng(21);
+    uniform_real_distribution<double> step(-0.0003, 0.0003);
+    vector<string> tripIds;
+    vector<double> lat(numTrips), lon(numTrips);
+    for(int t = 0; t < numTrips; t++) {
+        tripIds.push_back("TRIP-" + to_string(1700000000 + t));
+        lat[t] = 12.9716 + step(rng) * 300;
+        lon[t] = 77.5946 + step(rng) * 300;
+    }
+    vector<Frame> frames;
+    string current;
+    vector<string> lateFor(seconds + 2);
+    long long totalPings = 0;
+    char line[128];
+    for(int s = 0; s < seconds; s++) {
+        current += lateFor[s];
+        for(int t = 0; t < numTrips; t++) {
+            lat[t] += step(rng);
+            lon[t] += step(rng);
+            int64_t ts = 1700000000000LL + s * 1000LL + t % 1000;
+            int n = snprintf(line, sizeof(line), "%s,%.7f,%.7f,%.1f,%lld\n", tripIds[t].c_str(), lat[t], lon[t],
+                             (double)(rng() % 900) / 10, (long long)ts);
+            (rng() % 50 == 0 ? lateFor[s + 2] : current).append(line, (size_t)n);
+            totalPings++;
+            if(totalPings % frameLines == 0) {
+                frames.push_back(Frame{current, 1700000000000LL + s * 1000LL});
+                current.clear();
+            }
+        }
+    }
+    current += lateFor[seconds] + lateFor[seconds + 1];
+    if(!current.empty()) frames.push_back(Frame{current, 1700000000000LL + seconds * 1000LL});
+
+    cout << "=== Telemetry Replay Benchmark ===" << endl;
+    cout << "Trips: " << numTrips << ", " << seconds << " s at 1 Hz, " << totalPings << " pings in "
+         << frames.size() << " frames, flush every " << flushMs << " ms\n" << endl;
+
+    // Per-ping path
+    unordered_map<string, TripPosition> latest;
+    mutex latestLock;
+    long long perPingStatements = 0;
+    size_t perPingSqlBytes = 0;
+    auto start = chrono::steady_clock::now();
+    for(const Frame& f : frames) {
+        string_view rest = f.text;
+        while(!rest.empty()) {
+            size_t newline = rest.find('\n');
+            string_view row = rest.substr(0, newline);
+            rest.remove_prefix(newline == string_view::npos ? rest.size() : newline + 1);
+            size_t c1 = row.find(','), c2 = row.find(',', c1 + 1), c3 = row.find(',', c2 + 1), c4 = row.find(',', c3 + 1);
+            string trip(row.substr(0, c1));
+            double la = strtod(string(row.substr(c1 + 1, c2 - c1 - 1)).c_str(), NULL);
+            double lo = strtod(string(row.substr(c2 + 1, c3 - c2 - 1)).c_str(), NULL);
+            long long ts = strtoll(string(row.substr(c4 + 1)).c_str(), NULL, 10);
+            lock_guard<mutex> guard(latestLock);
+            TripPosition& p = latest[trip];
+            if(p.tripId.empty() || ts > p.timestampMs) {
+                p.tripId = trip;
+                p.latitude = la;
+                p.longitude = lo;
+                p.timestampMs = ts;
+                string sql = "UPDATE trips SET (current_lat, current_lon) = ";
+                appendRow(sql, trip, la, lo);
+                perPingSqlBytes += sql.size();
+                perPingStatements++;
+            }
+        }
+    }
+    double perPingSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // TelemetryIngest path
+    TelemetryIngest ingest((size_t)numTrips, flushMs);
+    long long batches = 0;
+    size_t batchSqlBytes = 0;
+    string sql;
+    ingest.setSink([&](const vector<TripPosition>& batch) {
+        sql = "UPDATE trips SET current_lat = v.lat, current_lon = v.lon FROM (VALUES ";
+        for(const TripPosition& p : batch) appendRow(sql, p.tripId, p.latitude, p.longitude);
+        batchSqlBytes += sql.size();
+        batches++;
+        return true;
+    });
+    for(const string& id : tripIds) ingest.startTrip(id);
+    start = chrono::steady_clock::now();
+    for(const Frame& f : frames) {
+        ingest.ingestFrame(f.text);
+        ingest.flushIfDue(f.sentMs);
+    }
+    ingest.flush(1700000000000LL + (seconds + 2) * 1000LL);
+    double ingestSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Same final state
+    int mismatches = 0;
+    for(const string& id : tripIds) {
+        TripPosition p;
+        const TripPosition& expected = latest[id];
+        if(!ingest.getPosition(id, p) || p.timestampMs != expected.timestampMs ||
+           llround(p.latitude * 1e7) != llround(expected.latitude * 1e7) ||
+           llround(p.longitude * 1e7) != llround(expected.longitude * 1e7)) {
+            mismatches++;
+        }
+    }
+
+    double perPingRate = totalPings / perPingSeconds;
+    double ingestRate = totalPings / ingestSeconds;
+    cout << fixed << setprecision(0);
+    cout << left << setw(26) << "Path" << right << setw(14) << "pings/s" << setw(14) << "DB writes" << setw(12) << "SQL KB" << endl;
+    cout << left << setw(26) << "Per-ping UPDATE" << right << setw(14) << perPingRate << setw(14) << perPingStatements
+         << setw(12) << perPingSqlBytes / 1024.0 << endl;
+    cout << left << setw(26) << "TelemetryIngest" << right << setw(14) << ingestRate << setw(14) << batches
+         << setw(12) << batchSqlBytes / 1024.0 << endl;
+    cout << setprecision(1) << "\nSpeedup: " << ingestRate / perPingRate << "x, rows per flush: "
+         << (double)ingest.getRowsFlushed() / (batches > 0 ? batches : 1) << endl;
+    ingest.displayStats();
+
+    bool fastEnough = ingestRate >= REPLAY_TARGET_PINGS_PER_SEC;
+    cout << (mismatches == 0 ? "✅ Final positions match" : "❌ Final positions differ") << " (" << mismatches << " mismatches)" << endl;
+    cout << (fastEnough ? "✅" : "❌") << " One core sustains " << setprecision(0) << ingestRate << " pings/s (target "
+         << REPLAY_TARGET_PINGS_PER_SEC << ")" << endl;
+    return mismatches == 0 && fastEnough ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Vehicle secondary index benchmark.
+// Loads a HashTable with random statuses, types and driver assignments and
+// times the admin dashboard filters two ways: walking every vehicle and
+// comparing fields (what displayAll-style code does), and the status/type
+// bitmaps and driver map. Both must return the same answers.
+//
+// Usage: vehicle_index_bench [vehicles] [rounds]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "hash_table.h"
+using namespace std;
+
+int main(int argc, char** argv) {
+    int numVehicles = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+
+    const char* typeNames[] = {"Truck", "Van", "Car", "SUV", "Bus"};
+    mt19937 rng(11);
+    HashTable table;
+    table.setVerbose(false);
+    table.reserve(numVehicles);
+    vector<Vehicle*> all;
+    for(int i = 0; i < numVehicles; i++) {
+        Vehicle* v = new Vehicle("V" + to_string(i), "REG-" + to_string(i), "Model", typeNames[rng() % 5], 2020);
+        v->status = (VehicleStatus)(rng() % VEHICLE_STATUS_COUNT);
+        if(v->status == VEHICLE_IN_USE) v->assignedDriverId = "D" + to_string(i);
+        table.insert(v);
+        all.push_back(v);
+    }
+
+    cout << "=== Vehicle Index Benchmark ===" << endl;
+    cout << "Vehicles: " << table.getTotalVehicles() << ", rounds: " << rounds << "\n" << endl;
+
+    uint32_t inUse = VEHICLE_STATUS_BIT(VEHICLE_IN_USE);
+    uint32_t vans = VEHICLE_TYPE_BIT(VEHICLE_VAN);
+    uint32_t offRoad = VEHICLE_STATUS_BIT(VEHICLE_MAINTENANCE) | VEHICLE_STATUS_BIT(VEHICLE_RETIRED);
+    uint32_t heavy = VEHICLE_TYPE_BIT(VEHICLE_TRUCK) | VEHICLE_TYPE_BIT(VEHICLE_VAN);
+
+    // IN_USE vans
+    size_t scanCount = 0, indexCount = 0;
+    auto start = chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++) {
+        scanCount = 0;
+        for(size_t i = 0; i < all.size(); i++) {
+            if(all[i]->status == VEHICLE_IN_USE && all[i]->type == VEHICLE_VAN) scanCount++;
+        }
+    }
+    double scanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+    start = chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++) {
+        indexCount = table.query(inUse, vans).size();
+    }
+    double queryMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+    start = chrono::steady_clock::now();
+    size_t counted = 0;
+    for(int r = 0; r < rounds; r++) {
+        counted = table.count(inUse, vans);
+    }
+    double countMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+    // (MAINTENANCE or RETIRED) and (Truck or Van)
+    size_t scanOffRoad = 0;
+    for(size_t i = 0; i < all.size(); i++) {
+        Vehicle* v = all[i];
+        bool statusMatch = v->status == VEHICLE_MAINTENANCE || v->status == VEHICLE_RETIRED;
+        bool typeMatch = v->type == VEHICLE_TRUCK || v->type == VEHICLE_VAN;
+        if(statusMatch && typeMatch) scanOffRoad++;
+    }
+    start = chrono::steady_clock::now();
+    size_t indexOffRoad = 0;
+    for(int r = 0; r < rounds; r++) {
+        indexOffRoad = table.count(offRoad, heavy);
+    }
+    double orMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+
+    // Vehicle of a driver
+    int lookups = 100;
+    int scanFound = 0, indexFound = 0;
+    start = chrono::steady_clock::now();
+    for(int q = 0; q < lookups; q++) {
+        string driver = "D" + to_string((q * 7919) % numVehicles);
+        for(size_t i = 0; i < all.size(); i++) {
+            if(all[i]->assignedDriverId == driver) {
+                scanFound++;
+                break;
+            }
+        }
+    }
+    double driverScanUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / lookups;
+
+    start = chrono::steady_clock::now();
+    for(int q = 0; q < lookups; q++) {
+        string driver = "D" + to_string((q * 7919) % numVehicles);
+        if(table.findByDriver(driver) != NULL) indexFound++;
+    }
+    double driverIndexUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / lookups;
+
+    cout << fixed << setprecision(3);
+    cout << "IN_USE vans (" << indexCount << ")" << endl;
+    cout << "  scan:          " << scanMs << " ms" << endl;
+    cout << "  bitmap query:  " << queryMs << " ms (" << scanMs / queryMs << "x)" << endl;
+    cout << "  bitmap count:  " << countMs << " ms (" << scanMs / countMs << "x)" << endl;
+    cout << "Off-road trucks/vans (" << indexOffRoad << ")" << endl;
+    cout << "  bitmap count:  " << orMs << " ms" << endl;
+    cout << "Driver -> vehicle (" << indexFound << "/" << lookups << " assigned)" << endl;
+    cout << "  scan:          " << driverScanUs << " us" << endl;
+    cout << "  driver map:    " << driverIndexUs << " us" << endl;
+
+    bool match = scanCount == indexCount && scanCount == counted && scanOffRoad == indexOffRoad && scanFound == indexFound;
+    cout << "\nResults match: " << (match ? "✅" : "❌") << endl;
+    return match ? 0 : 1;
+}
@@ -3,8 +3,38 @@
 
 #include <iostream>
 #include <string>
+#include <cstdint>
 using namespace std;
 
+enum DriverStatus : uint8_t {
+    DRIVER_AVAILABLE,
+    DRIVER_ON_DUTY,
+    DRIVER_ON_LEAVE,
+    DRIVER_INACTIVE
+};
+#define DRIVER_STATUS_COUNT 4
+
+inline const char* driverStatusName(DriverStatus status) {
+    static const char* names[DRIVER_STATUS_COUNT] = {"AVAILABLE", "ON_DUTY", "ON_LEAVE", "INACTIVE"};
+    return status < DRIVER_STATUS_COUNT ? names[status] : "UNKNOWN";
+}
+
+// Accepts the names above plus the frontend's ASSIGNED (on duty). False
+// for anything else; 'out' is then untouched.
+inline bool parseDriverStatus(const string& name, DriverStatus& out) {
+    for(int s = 0; s < DRIVER_STATUS_COUNT; s++) {
+        if(name == driverStatusName((DriverStatus)s)) {
+            out = (DriverStatus)s;
+            return true;
+        }
+    }
+    if(name == "ASSIGNED") {
+        out = DRIVER_ON_DUTY;
+        return true;
+    }
+    return false;
+}
+
 class Driver {
 public:
     string driverId;
@@ -12,7 +42,7 @@ public:
     string licenseNumber;
     string phoneNumber;
     int experience;  // years
-    string status;  // "AVAILABLE", "ON_DUTY", "ON_LEAVE", "INACTIVE"
+    DriverStatus status;
     string assignedVehicleId;
 
     // Constructor
@@ -22,7 +52,7 @@ public:
         licenseNumber = "";
         phoneNumber = "";
         experience = 0;
-        status = "AVAILABLE";
+        status = DRIVER_AVAILABLE;
         assignedVehicleId = "";
     }
 
@@ -32,12 +62,12 @@ public:
         licenseNumber = license;
         phoneNumber = phone;
         experience = exp;
-        status = "AVAILABLE";
+        status = DRIVER_AVAILABLE;
         assignedVehicleId = "";
     }
 
     bool isAvailable() {
-        return status == "AVAILABLE";
+        return status == DRIVER_AVAILABLE;
     }
 
     void display() {
@@ -47,7 +77,7 @@ public:
         cout << "License: " << licenseNumber << endl;
         cout << "Phone: " << phoneNumber << endl;
         cout << "Experience: " << experience << " years" << endl;
-        cout << "Status: " << status << endl;
+        cout << "Status: " << driverStatusName(status) << endl;
         if(assignedVehicleId != "") {
             cout << "Assigned Vehicle: " << assignedVehicleId << endl;
         }
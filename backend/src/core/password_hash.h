@@ -0,0 +1,351 @@
+#ifndef PASSWORD_HASH_H
+#define PASSWORD_HASH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <random>
+using namespace std;
+
+#define PASSWORD_SALT_BYTES 16
+#define PASSWORD_HASH_BYTES 32
+#define SCRYPT_MAX_MEMORY (256ull << 20)     // Cap on 128 * r * N per hash
+
+// scrypt cost settings. Memory per hash is 128 * r * N bytes
+// (16 MB for the defaults); time grows linearly with N and p.
+struct ScryptParams {
+    uint32_t N;     // CPU/memory cost, power of two
+    uint32_t r;     // Block size
+    uint32_t p;     // Parallelization
+
+    ScryptParams(uint32_t n = 16384, uint32_t blockSize = 8, uint32_t parallel = 1) {
+        N = n;
+        r = blockSize;
+        p = parallel;
+    }
+};
+
+// Stored credential: salt, derived key and the parameters used.
+// Fixed size, so verifying a login never allocates.
+struct PasswordHash {
+    uint8_t salt[PASSWORD_SALT_BYTES];
+    uint8_t hash[PASSWORD_HASH_BYTES];
+    ScryptParams params;
+
+    PasswordHash() {
+        memset(salt, 0, sizeof(salt));
+        memset(hash, 0, sizeof(hash));
+    }
+};
+
+// ---------- SHA-256 (FIPS 180-4) ----------
+
+class Sha256 {
+private:
+    uint32_t state[8];
+    uint8_t buffer[64];
+    uint64_t totalBytes;
+    size_t bufferLen;
+
+    static uint32_t rotr(uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    void compress(const uint8_t* block) {
+        static const uint32_t K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        uint32_t w[64];
+        for(int i = 0; i < 16; i++) {
+            w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+                   ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+        }
+        for(int i = 16; i < 64; i++) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for(int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+public:
+    Sha256() {
+        reset();
+    }
+
+    void reset() {
+        static const uint32_t init[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        memcpy(state, init, sizeof(state));
+        totalBytes = 0;
+        bufferLen = 0;
+    }
+
+    void update(const uint8_t* data, size_t len) {
+        totalBytes += len;
+        if(bufferLen > 0) {
+            size_t take = 64 - bufferLen < len ? 64 - bufferLen : len;
+            memcpy(buffer + bufferLen, data, take);
+            bufferLen += take;
+            data += take;
+            len -= take;
+            if(bufferLen == 64) {
+                compress(buffer);
+                bufferLen = 0;
+            }
+        }
+        while(len >= 64) {
+            compress(data);
+            data += 64;
+            len -= 64;
+        }
+        memcpy(buffer, data, len);
+        bufferLen += len;
+    }
+
+    void finish(uint8_t out[32]) {
+        uint64_t bits = totalBytes * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        uint8_t zero = 0;
+        while(bufferLen != 56) update(&zero, 1);
+        uint8_t length[8];
+        for(int i = 0; i < 8; i++) {
+            length[i] = (uint8_t)(bits >> (56 - 8 * i));
+        }
+        update(length, 8);
+        for(int i = 0; i < 8; i++) {
+            out[i * 4] = (uint8_t)(state[i] >> 24);
+            out[i * 4 + 1] = (uint8_t)(state[i] >> 16);
+            out[i * 4 + 2] = (uint8_t)(state[i] >> 8);
+            out[i * 4 + 3] = (uint8_t)state[i];
+        }
+    }
+};
+
+// ---------- HMAC-SHA256 / PBKDF2-HMAC-SHA256 (RFC 2104 / RFC 8018) ----------
+
+class HmacSha256 {
+private:
+    Sha256 inner;
+    Sha256 outer;
+
+public:
+    HmacSha256(const uint8_t* key, size_t keyLen) {
+        uint8_t block[64];
+        uint8_t keyHash[32];
+        memset(block, 0, sizeof(block));
+        if(keyLen > 64) {
+            Sha256 h;
+            h.update(key, keyLen);
+            h.finish(keyHash);
+            memcpy(block, keyHash, 32);
+        } else {
+            memcpy(block, key, keyLen);
+        }
+
+        uint8_t pad[64];
+        for(int i = 0; i < 64; i++) pad[i] = block[i] ^ 0x36;
+        inner.update(pad, 64);
+        for(int i = 0; i < 64; i++) pad[i] = block[i] ^ 0x5c;
+        outer.update(pad, 64);
+    }
+
+    void update(const uint8_t* data, size_t len) {
+        inner.update(data, len);
+    }
+
+    void finish(uint8_t out[32]) {
+        uint8_t innerHash[32];
+        inner.finish(innerHash);
+        outer.update(innerHash, 32);
+        outer.finish(out);
+    }
+};
+
+inline void pbkdf2HmacSha256(const uint8_t* password, size_t passwordLen, const uint8_t* salt, size_t saltLen,
+                             uint32_t iterations, uint8_t* out, size_t outLen) {
+    HmacSha256 keyed(password, passwordLen);     // Pads computed once, copied per block
+    for(uint32_t blockIndex = 1; outLen > 0; blockIndex++) {
+        uint8_t counter[4] = {(uint8_t)(blockIndex >> 24), (uint8_t)(blockIndex >> 16),
+                              (uint8_t)(blockIndex >> 8), (uint8_t)blockIndex};
+        uint8_t u[32];
+        uint8_t t[32];
+        HmacSha256 mac = keyed;
+        mac.update(salt, saltLen);
+        mac.update(counter, 4);
+        mac.finish(u);
+        memcpy(t, u, 32);
+        for(uint32_t i = 1; i < iterations; i++) {
+            HmacSha256 next = keyed;
+            next.update(u, 32);
+            next.finish(u);
+            for(int k = 0; k < 32; k++) t[k] ^= u[k];
+        }
+        size_t take = outLen < 32 ? outLen : 32;
+        memcpy(out, t, take);
+        out += take;
+        outLen -= take;
+    }
+}
+
+// ---------- scrypt (RFC 7914) ----------
+
+inline void salsa208(uint32_t b[16]) {
+    uint32_t x[16];
+    memcpy(x, b, sizeof(x));
+#define SCRYPT_R(a, n) (((a) << (n)) | ((a) >> (32 - (n))))
+    for(int i = 0; i < 8; i += 2) {
+        x[4] ^= SCRYPT_R(x[0] + x[12], 7);   x[8] ^= SCRYPT_R(x[4] + x[0], 9);
+        x[12] ^= SCRYPT_R(x[8] + x[4], 13);  x[0] ^= SCRYPT_R(x[12] + x[8], 18);
+        x[9] ^= SCRYPT_R(x[5] + x[1], 7);    x[13] ^= SCRYPT_R(x[9] + x[5], 9);
+        x[1] ^= SCRYPT_R(x[13] + x[9], 13);  x[5] ^= SCRYPT_R(x[1] + x[13], 18);
+        x[14] ^= SCRYPT_R(x[10] + x[6], 7);  x[2] ^= SCRYPT_R(x[14] + x[10], 9);
+        x[6] ^= SCRYPT_R(x[2] + x[14], 13);  x[10] ^= SCRYPT_R(x[6] + x[2], 18);
+        x[3] ^= SCRYPT_R(x[15] + x[11], 7);  x[7] ^= SCRYPT_R(x[3] + x[15], 9);
+        x[11] ^= SCRYPT_R(x[7] + x[3], 13);  x[15] ^= SCRYPT_R(x[11] + x[7], 18);
+        x[1] ^= SCRYPT_R(x[0] + x[3], 7);    x[2] ^= SCRYPT_R(x[1] + x[0], 9);
+        x[3] ^= SCRYPT_R(x[2] + x[1], 13);   x[0] ^= SCRYPT_R(x[3] + x[2], 18);
+        x[6] ^= SCRYPT_R(x[5] + x[4], 7);    x[7] ^= SCRYPT_R(x[6] + x[5], 9);
+        x[4] ^= SCRYPT_R(x[7] + x[6], 13);   x[5] ^= SCRYPT_R(x[4] + x[7], 18);
+        x[11] ^= SCRYPT_R(x[10] + x[9], 7);  x[8] ^= SCRYPT_R(x[11] + x[10], 9);
+        x[9] ^= SCRYPT_R(x[8] + x[11], 13);  x[10] ^= SCRYPT_R(x[9] + x[8], 18);
+        x[12] ^= SCRYPT_R(x[15] + x[14], 7); x[13] ^= SCRYPT_R(x[12] + x[15], 9);
+        x[14] ^= SCRYPT_R(x[13] + x[12], 13); x[15] ^= SCRYPT_R(x[14] + x[13], 18);
+    }
+#undef SCRYPT_R
+    for(int i = 0; i < 16; i++) b[i] += x[i];
+}
+
+// B (2r 64-byte blocks) -> Y, result written back to B in the shuffled order
+inline void scryptBlockMix(uint32_t* b, uint32_t* y, uint32_t r) {
+    uint32_t x[16];
+    memcpy(x, &b[(2 * r - 1) * 16], 64);
+    for(uint32_t i = 0; i < 2 * r; i++) {
+        for(int k = 0; k < 16; k++) x[k] ^= b[i * 16 + k];
+        salsa208(x);
+        memcpy(&y[i * 16], x, 64);
+    }
+    for(uint32_t i = 0; i < r; i++) {
+        memcpy(&b[i * 16], &y[(2 * i) * 16], 64);
+        memcpy(&b[(r + i) * 16], &y[(2 * i + 1) * 16], 64);
+    }
+}
+
+// scratch must hold (N + 2) * 32 * r words; it is reused across calls
+inline void scryptROMix(uint8_t* block, uint32_t r, uint32_t N, uint32_t* scratch) {
+    size_t words = 32 * (size_t)r;
+    uint32_t* x = scratch;
+    uint32_t* y = scratch + words;
+    uint32_t* v = scratch + 2 * words;
+
+    for(size_t k = 0; k < words; k++) {
+        x[k] = (uint32_t)block[4 * k] | ((uint32_t)block[4 * k + 1] << 8) |
+               ((uint32_t)block[4 * k + 2] << 16) | ((uint32_t)block[4 * k + 3] << 24);
+    }
+    for(uint32_t i = 0; i < N; i++) {
+        memcpy(&v[i * words], x, words * 4);
+        scryptBlockMix(x, y, r);
+    }
+    for(uint32_t i = 0; i < N; i++) {
+        uint32_t j = x[(2 * r - 1) * 16] & (N - 1);
+        for(size_t k = 0; k < words; k++) x[k] ^= v[j * words + k];
+        scryptBlockMix(x, y, r);
+    }
+    for(size_t k = 0; k < words; k++) {
+        block[4 * k] = (uint8_t)x[k];
+        block[4 * k + 1] = (uint8_t)(x[k] >> 8);
+        block[4 * k + 2] = (uint8_t)(x[k] >> 16);
+        block[4 * k + 3] = (uint8_t)(x[k] >> 24);
+    }
+}
+
+// Derive outLen bytes. The large memory area lives in a thread_local buffer
+// that only grows, so repeated logins on a thread do not allocate.
+// Returns false for invalid parameters, including any needing more than
+// SCRYPT_MAX_MEMORY bytes.
+inline bool scrypt(string_view password, const uint8_t* salt, size_t saltLen, const ScryptParams& params,
+                   uint8_t* out, size_t outLen) {
+    uint32_t N = params.N, r = params.r, p = params.p;
+    if(N < 2 || (N & (N - 1)) != 0 || r == 0 || r > 256 || p == 0 || p > 16) return false;
+    if(128ull * r * N > SCRYPT_MAX_MEMORY) return false;     // Bounded memory
+
+    thread_local vector<uint32_t> romScratch;
+    thread_local vector<uint8_t> blockScratch;
+    size_t blockBytes = 128 * (size_t)r;
+    if(romScratch.size() < ((size_t)N + 2) * 32 * r) romScratch.resize(((size_t)N + 2) * 32 * r);
+    if(blockScratch.size() < blockBytes * p) blockScratch.resize(blockBytes * p);
+
+    const uint8_t* pw = (const uint8_t*)password.data();
+    pbkdf2HmacSha256(pw, password.size(), salt, saltLen, 1, blockScratch.data(), blockBytes * p);
+    for(uint32_t i = 0; i < p; i++) {
+        scryptROMix(blockScratch.data() + i * blockBytes, r, N, romScratch.data());
+    }
+    pbkdf2HmacSha256(pw, password.size(), blockScratch.data(), blockBytes * p, 1, out, outLen);
+    return true;
+}
+
+// ---------- Credentials ----------
+
+// Compare without an early exit, so timing does not reveal how many
+// leading bytes matched
+inline bool constantTimeEqual(const uint8_t* a, const uint8_t* b, size_t len) {
+    volatile uint8_t diff = 0;
+    for(size_t i = 0; i < len; i++) {
+        diff = diff | (a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+inline void randomSalt(uint8_t* salt, size_t len) {
+    thread_local random_device device;
+    for(size_t i = 0; i < len; i += 4) {
+        uint32_t word = device();
+        for(size_t k = 0; k < 4 && i + k < len; k++) {
+            salt[i + k] = (uint8_t)(word >> (8 * k));
+        }
+    }
+}
+
+// New salted hash of 'password'
+inline bool hashPassword(string_view password, const ScryptParams& params, PasswordHash& out) {
+    randomSalt(out.salt, PASSWORD_SALT_BYTES);
+    out.params = params;
+    return scrypt(password, out.salt, PASSWORD_SALT_BYTES, params, out.hash, PASSWORD_HASH_BYTES);
+}
+
+inline bool verifyPassword(string_view password, const PasswordHash& stored) {
+    uint8_t candidate[PASSWORD_HASH_BYTES];
+    if(!scrypt(password, stored.salt, PASSWORD_SALT_BYTES, stored.params, candidate, PASSWORD_HASH_BYTES)) {
+        return false;
+    }
+    return constantTimeEqual(candidate, stored.hash, PASSWORD_HASH_BYTES);
+}
+
+#endif
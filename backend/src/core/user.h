@@ -3,33 +3,37 @@
 
 #include <iostream>
 #include <string>
+#include <atomic>
+#include "password_hash.h"
 using namespace std;
 
 class User {
 public:
     string userId;
     string email;
-    string password;
+    PasswordHash passwordHash;  // Salted scrypt hash, never the plaintext
     string name;
     string role;      // "ADMIN" or "EMPLOYEE"
     string status;    // "ACTIVE", "PENDING", "INACTIVE"
+    atomic<bool> active;    // status == "ACTIVE", readable without AuthSystem's lock
     
     User() {
         userId = "";
         email = "";
-        password = "";
         name = "";
         role = "EMPLOYEE";
         status = "PENDING";
+        active = false;
     }
     
-    User(string id, string e, string p, string n, string r, string s) {
+    User(string id, string e, const PasswordHash& p, string n, string r, string s) {
         userId = id;
         email = e;
-        password = p;
+        passwordHash = p;
         name = n;
         role = r;
         status = s;
+        active = s == "ACTIVE";
     }
     
     void display() {
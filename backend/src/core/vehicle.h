@@ -3,18 +3,86 @@
 
 #include <iostream>
 #include <string>
+#include <cstdint>
 using namespace std;
 
+enum VehicleStatus : uint8_t {
+    VEHICLE_AVAILABLE,
+    VEHICLE_IN_USE,
+    VEHICLE_MAINTENANCE,
+    VEHICLE_RETIRED
+};
+#define VEHICLE_STATUS_COUNT 4
+
+enum VehicleType : uint8_t {
+    VEHICLE_TRUCK,
+    VEHICLE_VAN,
+    VEHICLE_CAR,
+    VEHICLE_SUV,
+    VEHICLE_OTHER       // Anything not listed above
+};
+#define VEHICLE_TYPE_COUNT 5
+
+// Query masks: OR of bits within a field, AND across fields
+#define VEHICLE_STATUS_BIT(s) (1u << (s))
+#define VEHICLE_TYPE_BIT(t) (1u << (t))
+#define VEHICLE_ANY_STATUS ((1u << VEHICLE_STATUS_COUNT) - 1)
+#define VEHICLE_ANY_TYPE ((1u << VEHICLE_TYPE_COUNT) - 1)
+
+// Maintenance scoring; MaintenanceScorer uses the same values
+#define MAINTENANCE_KM_PER_POINT 5000.0     // Every 5000 km adds one priority point
+#define MAINTENANCE_DAYS_PER_POINT 30       // So does every 30 days since service
+#define MAINTENANCE_URGENT_KM 10000.0
+#define MAINTENANCE_URGENT_DAYS 90
+
+inline const char* vehicleStatusName(VehicleStatus status) {
+    static const char* names[VEHICLE_STATUS_COUNT] = {"AVAILABLE", "IN_USE", "MAINTENANCE", "RETIRED"};
+    return status < VEHICLE_STATUS_COUNT ? names[status] : "UNKNOWN";
+}
+
+inline const char* vehicleTypeName(VehicleType type) {
+    static const char* names[VEHICLE_TYPE_COUNT] = {"Truck", "Van", "Car", "SUV", "Other"};
+    return type < VEHICLE_TYPE_COUNT ? names[type] : "Other";
+}
+
+// Accepts the names above plus the frontend's ASSIGNED (in use) and
+// INACTIVE (retired). False for anything else; 'out' is then untouched.
+inline bool parseVehicleStatus(const string& name, VehicleStatus& out) {
+    for(int s = 0; s < VEHICLE_STATUS_COUNT; s++) {
+        if(name == vehicleStatusName((VehicleStatus)s)) {
+            out = (VehicleStatus)s;
+            return true;
+        }
+    }
+    if(name == "ASSIGNED") {
+        out = VEHICLE_IN_USE;
+        return true;
+    }
+    if(name == "INACTIVE") {
+        out = VEHICLE_RETIRED;
+        return true;
+    }
+    return false;
+}
+
+// Unknown names map to VEHICLE_OTHER
+inline VehicleType parseVehicleType(const string& name) {
+    for(int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        if(name == vehicleTypeName((VehicleType)t)) return (VehicleType)t;
+    }
+    return VEHICLE_OTHER;
+}
+
 class Vehicle {
 public:
     string vehicleId;
     string registrationNumber;
     string model;
-    string type;  // Truck, Van, Car
+    VehicleType type;
     int year;
     double kilometersRun;
     int daysSinceLastService;
-    string status;  // "AVAILABLE", "IN_USE", "MAINTENANCE", "RETIRED"
+    VehicleStatus status;
     string assignedDriverId;
 
     // Constructor
@@ -22,11 +90,11 @@ public:
         vehicleId = "";
         registrationNumber = "";
         model = "";
-        type = "";
+        type = VEHICLE_OTHER;
         year = 0;
         kilometersRun = 0.0;
         daysSinceLastService = 0;
-        status = "AVAILABLE";
+        status = VEHICLE_AVAILABLE;
         assignedDriverId = "";
     }
 
@@ -34,11 +102,11 @@ public:
         vehicleId = id;
         registrationNumber = regNum;
         model = mdl;
-        type = tp;
+        type = parseVehicleType(tp);
         year = yr;
         kilometersRun = 0.0;
         daysSinceLastService = 0;
-        status = "AVAILABLE";
+        status = VEHICLE_AVAILABLE;
         assignedDriverId = "";
     }
 
@@ -47,16 +115,20 @@ public:
         int priority = 0;
         
         // Every 5000 km adds to priority
-        priority += (int)(kilometersRun / 5000);
+        priority += (int)(kilometersRun / MAINTENANCE_KM_PER_POINT);
         
         // Days since last service
-        priority += daysSinceLastService / 30;  // Every 30 days
+        priority += daysSinceLastService / MAINTENANCE_DAYS_PER_POINT;
         
         return priority;
     }
 
+    bool isAvailable() {
+        return status == VEHICLE_AVAILABLE;
+    }
+
     bool needsMaintenance() {
-        return (kilometersRun > 10000) || (daysSinceLastService > 90);
+        return (kilometersRun > MAINTENANCE_URGENT_KM) || (daysSinceLastService > MAINTENANCE_URGENT_DAYS);
     }
 
     void display() {
@@ -64,11 +136,11 @@ public:
         cout << "ID: " << vehicleId << endl;
         cout << "Registration: " << registrationNumber << endl;
         cout << "Model: " << model << endl;
-        cout << "Type: " << type << endl;
+        cout << "Type: " << vehicleTypeName(type) << endl;
         cout << "Year: " << year << endl;
         cout << "Kilometers: " << kilometersRun << " km" << endl;
         cout << "Days Since Service: " << daysSinceLastService << " days" << endl;
-        cout << "Status: " << status << endl;
+        cout << "Status: " << vehicleStatusName(status) << endl;
         cout << "Maintenance Priority: " << getMaintenancePriority() << endl;
         cout << "Needs Maintenance: " << (needsMaintenance() ? "YES" : "NO") << endl;
         if(assignedDriverId != "") {
@@ -0,0 +1,221 @@
+#ifndef ASTAR_SEARCH_H
+#define ASTAR_SEARCH_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "csr_graph.h"
+#include "geo.h"
+using namespace std;
+
+// A* route search over a CSRGraph.
+// The lower bound for "distance left to the destination" is the maximum of
+//  - the straight-line (haversine) distance, when both ends have coordinates
+//  - ALT bounds |d(L, t) - d(L, v)| from precomputed landmarks L
+// Both never overestimate a road distance, so the route is still exact.
+// Road weights are assumed to be in km; use setWeightPerKm() otherwise.
+// The workspace is generation-stamped and reused like DijkstraSearch.
+class AStarSearch {
+private:
+    struct HeapItem {
+        int key;        // dist + heuristic
+        int node;
+        bool operator>(const HeapItem& other) const {
+            return key > other.key;
+        }
+    };
+
+    const CSRGraph* graph;
+    double weightPerKm;
+
+    vector<int> dist;
+    vector<int> parent;
+    vector<int> heuristic;      // Cached per query
+    vector<uint32_t> stamp;
+    uint32_t generation;
+    vector<HeapItem> heap;
+
+    int numLandmarks;
+    vector<int> landmarkDist;   // [landmark * n + v], INF if unreachable
+
+    // Query-constant data for the heuristic
+    int target;
+    bool targetHasCoords;
+    double targetLat;
+    double targetLon;
+
+    int computeHeuristic(int v) {
+        double bound = 0.0;
+        if(targetHasCoords && graph->hasCoordinates(v)) {
+            bound = haversineKm(graph->latitude(v), graph->longitude(v), targetLat, targetLon) * weightPerKm;
+        }
+
+        int n = graph->getNumVertices();
+        for(int l = 0; l < numLandmarks; l++) {
+            int dv = landmarkDist[(size_t)l * n + v];
+            int dt = landmarkDist[(size_t)l * n + target];
+            if(dv == INF || dt == INF) continue;
+            int diff = dv > dt ? dv - dt : dt - dv;
+            if(diff > bound) bound = diff;
+        }
+        return (int)bound;  // Truncation keeps it a lower bound
+    }
+
+    // Plain one-to-all Dijkstra, used for landmark tables
+    void distancesFrom(int source, int* out) {
+        int n = graph->getNumVertices();
+        for(int v = 0; v < n; v++) out[v] = INF;
+        vector<HeapItem> q;
+        out[source] = 0;
+        q.push_back(HeapItem{0, source});
+
+        while(!q.empty()) {
+            pop_heap(q.begin(), q.end(), greater<HeapItem>());
+            HeapItem top = q.back();
+            q.pop_back();
+            if(top.key > out[top.node]) continue;
+
+            for(int a = graph->arcBegin(top.node); a < graph->arcEnd(top.node); a++) {
+                int v = graph->arcTarget(a);
+                int nd = top.key + graph->arcWeight(a);
+                if(nd < out[v]) {
+                    out[v] = nd;
+                    q.push_back(HeapItem{nd, v});
+                    push_heap(q.begin(), q.end(), greater<HeapItem>());
+                }
+            }
+        }
+    }
+
+public:
+    AStarSearch(const CSRGraph& g) {
+        graph = &g;
+        weightPerKm = 1.0;
+        generation = 0;
+        numLandmarks = 0;
+        target = -1;
+        targetHasCoords = false;
+        targetLat = targetLon = 0.0;
+    }
+
+    void setWeightPerKm(double w) {
+        weightPerKm = w;
+    }
+
+    // Drop landmark tables (the graph changed)
+    void resetLandmarks() {
+        numLandmarks = 0;
+        landmarkDist.clear();
+    }
+
+    // Pick 'count' landmarks by farthest-point selection and store their
+    // distances to every vertex. O(count * (V + E) log V), count * V ints.
+    void prepareLandmarks(int count) {
+        int n = graph->getNumVertices();
+        resetLandmarks();
+        if(n == 0 || count <= 0) return;
+
+        landmarkDist.assign((size_t)count * n, INF);
+        vector<int> nearest(n, INF);   // Distance to the closest chosen landmark
+        int next = 0;
+
+        for(int l = 0; l < count; l++) {
+            int* row = &landmarkDist[(size_t)l * n];
+            distancesFrom(next, row);
+            numLandmarks++;
+
+            // Next landmark: the reachable vertex farthest from all chosen ones
+            int best = -1;
+            int bestDist = -1;
+            for(int v = 0; v < n; v++) {
+                if(row[v] < nearest[v]) nearest[v] = row[v];
+                if(nearest[v] != INF && nearest[v] > bestDist) {
+                    bestDist = nearest[v];
+                    best = v;
+                }
+            }
+            if(best == -1 || bestDist == 0) break;
+            next = best;
+        }
+        landmarkDist.resize((size_t)numLandmarks * n);
+    }
+
+    int getNumLandmarks() const {
+        return numLandmarks;
+    }
+
+    bool findRoute(int source, int destination, RoutePath& out) {
+        out.clear();
+        int n = graph->getNumVertices();
+        if(source < 0 || source >= n || destination < 0 || destination >= n) {
+            return false;
+        }
+
+        if((int)stamp.size() != n) {
+            dist.assign(n, INF);
+            parent.assign(n, -1);
+            heuristic.assign(n, 0);
+            stamp.assign(n, 0);
+            generation = 0;
+        }
+        generation++;
+        if(generation == 0) {
+            fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        heap.clear();
+
+        target = destination;
+        targetHasCoords = graph->hasCoordinates(destination);
+        targetLat = graph->latitude(destination);
+        targetLon = graph->longitude(destination);
+
+        stamp[source] = generation;
+        dist[source] = 0;
+        parent[source] = -1;
+        heuristic[source] = computeHeuristic(source);
+        heap.push_back(HeapItem{heuristic[source], source});
+
+        while(!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<HeapItem>());
+            HeapItem top = heap.back();
+            heap.pop_back();
+            int u = top.node;
+            if(top.key > dist[u] + heuristic[u]) continue;    // Stale entry
+
+            out.settledNodes++;
+            if(u == destination) break;
+
+            for(int a = graph->arcBegin(u); a < graph->arcEnd(u); a++) {
+                int v = graph->arcTarget(a);
+                int nd = dist[u] + graph->arcWeight(a);
+                if(stamp[v] != generation) {
+                    stamp[v] = generation;
+                    heuristic[v] = computeHeuristic(v);
+                } else if(nd >= dist[v]) {
+                    continue;
+                }
+                dist[v] = nd;
+                parent[v] = u;
+                heap.push_back(HeapItem{nd + heuristic[v], v});
+                push_heap(heap.begin(), heap.end(), greater<HeapItem>());
+            }
+        }
+
+        if(stamp[destination] != generation) {
+            return false;
+        }
+
+        out.found = true;
+        out.distance = dist[destination];
+        for(int v = destination; v != -1; v = parent[v]) {
+            out.nodes.push_back(v);
+        }
+        reverse(out.nodes.begin(), out.nodes.end());
+        return true;
+    }
+};
+
+#endif
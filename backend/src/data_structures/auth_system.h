@@ -3,169 +3,316 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include "../core/user.h"
+#include "../core/password_hash.h"
+#include "node_pool.h"
+#include "string_hash.h"
+#include "session_store.h"
 using namespace std;
 
-#define AUTH_TABLE_SIZE 100
+#define AUTH_INITIAL_BUCKETS 64     // Power of two
+#define AUTH_MAX_LOAD 1             // Users per bucket before doubling
+
+enum UserChange : uint8_t {
+    USER_ADDED,
+    USER_STATUS_CHANGED
+};
+
+// previousStatus is only set for USER_STATUS_CHANGED
+struct UserEvent {
+    UserChange change;
+    const User* user;
+    string_view previousStatus;
+};
+
+// Runs under the table's exclusive lock: keep it short and never call back
+// into the AuthSystem from it.
+typedef function<void(const UserEvent& event)> UserObserver;
 
 class AuthNode {
 public:
     string email;
+    uint64_t hash;      // hashString(email), checked before comparing strings
     User* user;
     AuthNode* next;
-    
-    AuthNode(string e, User* u) {
-        email = e;
+
+    AuthNode(string_view e, uint64_t h, User* u) : email(e) {
+        hash = h;
         user = u;
         next = NULL;
     }
 };
 
+// User accounts keyed by email.
+// Passwords are stored only as salted scrypt hashes (see password_hash.h)
+// and checked with a constant-time compare; an unknown email is checked
+// against a dummy hash so it takes as long as a wrong password. Lookups take
+// string_view and hash once, the chained table doubles as it fills, and a
+// shared_mutex lets many logins read at once - the expensive scrypt step
+// runs after the lock is released.
+//
+// startSession() logs in and returns an opaque token; later requests call
+// validateSession() instead of repeating the password check or the email
+// lookup. Only ACTIVE users get or keep a session: moving a user off ACTIVE
+// revokes their tokens, and both calls re-check the user's active flag.
+//
+// Registrations and status changes are reported to observers (see
+// addObserver) while the exclusive lock is held, so an observer sees every
+// change exactly once and in table order.
 class AuthSystem {
 private:
-    AuthNode* table[AUTH_TABLE_SIZE];
+    vector<AuthNode*> buckets;
+    NodePool<AuthNode> nodePool;
     int totalUsers;
-    
-    int hashFunction(string email) {
-        int hash = 0;
-        for(int i = 0; i < email.length(); i++) {
-            hash = (hash * 31 + email[i]) % AUTH_TABLE_SIZE;
+    ScryptParams params;
+    PasswordHash dummyHash;         // For logins with an unknown email
+    mutable shared_mutex tableLock;
+    SessionStore sessions;
+    vector<UserObserver> observers;
+    bool verbose;
+
+    AuthNode* findNode(string_view email, uint64_t hash) const {
+        for(AuthNode* current = buckets[hash & (buckets.size() - 1)]; current != NULL; current = current->next) {
+            if(current->hash == hash && current->email == email) {
+                return current;
+            }
+        }
+        return NULL;
+    }
+
+    // Caller holds the exclusive lock
+    void insertNode(AuthNode* node) {
+        size_t index = node->hash & (buckets.size() - 1);
+        node->next = buckets[index];
+        buckets[index] = node;
+        totalUsers++;
+
+        if((size_t)totalUsers > buckets.size() * AUTH_MAX_LOAD) {
+            vector<AuthNode*> larger(buckets.size() * 2, (AuthNode*)NULL);
+            for(size_t b = 0; b < buckets.size(); b++) {
+                AuthNode* current = buckets[b];
+                while(current != NULL) {
+                    AuthNode* next = current->next;
+                    size_t target = current->hash & (larger.size() - 1);
+                    current->next = larger[target];
+                    larger[target] = current;
+                    current = next;
+                }
+            }
+            buckets.swap(larger);
         }
-        return hash >= 0 ? hash : -hash;
     }
-    
+
+    // Caller holds the exclusive lock
+    void notify(UserChange change, const User* user, string_view previousStatus) {
+        UserEvent event{change, user, previousStatus};
+        for(const UserObserver& observer : observers) observer(event);
+    }
+
 public:
-    AuthSystem() {
+    AuthSystem(const ScryptParams& hashParams = ScryptParams()) {
+        buckets.assign(AUTH_INITIAL_BUCKETS, (AuthNode*)NULL);
         totalUsers = 0;
-        for(int i = 0; i < AUTH_TABLE_SIZE; i++) {
-            table[i] = NULL;
-        }
+        params = hashParams;
+        verbose = true;
+        hashPassword("", params, dummyHash);
         initializeAdmin();
     }
-    
+
+    AuthSystem(const AuthSystem&) = delete;
+    AuthSystem& operator=(const AuthSystem&) = delete;
+
+    void setVerbose(bool v) {
+        verbose = v;
+    }
+
+    // Subscribe to account changes. Existing users are replayed as
+    // USER_ADDED under the same lock, so none is missed or counted twice.
+    void addObserver(UserObserver observer) {
+        unique_lock<shared_mutex> lock(tableLock);
+        for(size_t i = 0; i < buckets.size(); i++) {
+            for(AuthNode* current = buckets[i]; current != NULL; current = current->next) {
+                observer(UserEvent{USER_ADDED, current->user, ""});
+            }
+        }
+        observers.push_back(observer);
+    }
+
     void initializeAdmin() {
         // Hardcoded admin - only this email can be admin
-        User* admin = new User("U001", "admin@fleet.com", "admin123", "System Administrator", "ADMIN", "ACTIVE");
-        int index = hashFunction(admin->email);
-        AuthNode* newNode = new AuthNode(admin->email, admin);
-        table[index] = newNode;
-        totalUsers++;
-        cout << "✅ Admin account initialized: admin@fleet.com" << endl;
-    }
-    
-    bool registerUser(string email, string password, string name) {
-        int index = hashFunction(email);
-        
-        // Check if email already exists
-        AuthNode* current = table[index];
-        while(current != NULL) {
-            if(current->email == email) {
+        PasswordHash adminHash;
+        hashPassword("admin123", params, adminHash);
+        User* admin = new User("U001", "admin@fleet.com", adminHash, "System Administrator", "ADMIN", "ACTIVE");
+
+        unique_lock<shared_mutex> lock(tableLock);
+        insertNode(nodePool.create(admin->email, hashString(admin->email), admin));
+        notify(USER_ADDED, admin, "");
+        if(verbose) cout << "✅ Admin account initialized: admin@fleet.com" << endl;
+    }
+
+    bool registerUser(string_view email, string_view password, string_view name) {
+        if(email == "admin@fleet.com") {
+            return false;  // Admin already exists
+        }
+
+        uint64_t hash = hashString(email);
+        {
+            shared_lock<shared_mutex> lock(tableLock);
+            if(findNode(email, hash) != NULL) {
                 return false;  // Email already registered
             }
-            current = current->next;
         }
-        
-        // Generate user ID
-        string userId = "U" + to_string(totalUsers + 1);
-        
-        // Check if this is admin email
-        string role = "EMPLOYEE";
-        string status = "PENDING";
-        
-        if(email == "admin@fleet.com") {
-            return false;  // Admin already exists
+
+        // Hash outside the lock; it is deliberately slow
+        PasswordHash credential;
+        if(!hashPassword(password, params, credential)) {
+            return false;
         }
-        
-        // Create new user
-        User* newUser = new User(userId, email, password, name, role, status);
-        
-        // Insert into hash table
-        AuthNode* newNode = new AuthNode(email, newUser);
-        newNode->next = table[index];
-        table[index] = newNode;
-        totalUsers++;
-        
-        cout << "✅ User registered: " << email << " (Status: PENDING)" << endl;
+
+        unique_lock<shared_mutex> lock(tableLock);
+        if(findNode(email, hash) != NULL) {
+            return false;  // Registered concurrently
+        }
+        string userId = "U" + to_string(totalUsers + 1);
+        User* newUser = new User(userId, string(email), credential, string(name), "EMPLOYEE", "PENDING");
+        insertNode(nodePool.create(email, hash, newUser));
+        notify(USER_ADDED, newUser, "");
+
+        if(verbose) cout << "✅ User registered: " << email << " (Status: PENDING)" << endl;
         return true;
     }
-    
-    User* login(string email, string password) {
-        int index = hashFunction(email);
-        AuthNode* current = table[index];
-        
-        while(current != NULL) {
-            if(current->email == email && current->user->password == password) {
-                return current->user;
-            }
-            current = current->next;
-        }
-        
-        return NULL;  // Login failed
-    }
-    
-    User* getUserByEmail(string email) {
-        int index = hashFunction(email);
-        AuthNode* current = table[index];
-        
-        while(current != NULL) {
-            if(current->email == email) {
-                return current->user;
+
+    // NULL on unknown email or wrong password (indistinguishable by timing)
+    User* login(string_view email, string_view password) {
+        PasswordHash stored;
+        User* user = NULL;
+        {
+            shared_lock<shared_mutex> lock(tableLock);
+            AuthNode* node = findNode(email, hashString(email));
+            if(node != NULL) {
+                user = node->user;
+                stored = user->passwordHash;
             }
-            current = current->next;
         }
-        
-        return NULL;
+
+        bool match = verifyPassword(password, user != NULL ? stored : dummyHash);
+        return (match && user != NULL) ? user : NULL;
+    }
+
+    // Token for a successful login of an ACTIVE user, "" otherwise
+    string startSession(string_view email, string_view password) {
+        User* user = login(email, password);
+        if(user == NULL || !user->active.load(memory_order_acquire)) return "";
+        return sessions.issue(user);
+    }
+
+    // User behind a live token, NULL if unknown, expired or revoked. The
+    // user's active flag is checked again so a token issued while the user
+    // was being deactivated is refused even if revokeUser() missed it. No
+    // table lock: one session shard and the User itself.
+    User* validateSession(string_view token) const {
+        User* user = sessions.validate(token);
+        return user != NULL && user->active.load(memory_order_acquire) ? user : NULL;
     }
-    
-    bool updateUserStatus(string email, string newStatus) {
-        User* user = getUserByEmail(email);
-        if(user != NULL) {
-            user->status = newStatus;
-            cout << "✅ User status updated: " << email << " -> " << newStatus << endl;
-            return true;
+
+    bool endSession(string_view token) {
+        return sessions.revoke(token);
+    }
+
+    // Drop expired sessions; call from a housekeeping timer
+    int expireSessions() {
+        return sessions.advance();
+    }
+
+    size_t getSessionCount() const {
+        return sessions.size();
+    }
+
+    User* getUserByEmail(string_view email) {
+        shared_lock<shared_mutex> lock(tableLock);
+        AuthNode* node = findNode(email, hashString(email));
+        return node != NULL ? node->user : NULL;
+    }
+
+    bool updateUserStatus(string_view email, string_view newStatus) {
+        User* user = NULL;
+        {
+            unique_lock<shared_mutex> lock(tableLock);
+            AuthNode* node = findNode(email, hashString(email));
+            if(node == NULL) return false;
+            user = node->user;
+            string previous = string(newStatus);
+            previous.swap(user->status);
+            // Cleared before revokeUser() below, so a session issued in between is refused
+            user->active.store(newStatus == "ACTIVE", memory_order_release);
+            notify(USER_STATUS_CHANGED, user, previous);
+        }
+        if(verbose) cout << "✅ User status updated: " << email << " -> " << newStatus << endl;
+
+        if(newStatus != "ACTIVE") {
+            int revoked = sessions.revokeUser(user);
+            if(verbose && revoked > 0) cout << "✅ Revoked " << revoked << " session(s) for " << email << endl;
         }
-        return false;
+        return true;
     }
-    
+
     void displayAllUsers() {
+        shared_lock<shared_mutex> lock(tableLock);
         cout << "\n=== All Registered Users ===" << endl;
         cout << "Total Users: " << totalUsers << endl;
         cout << "============================\n" << endl;
-        
-        for(int i = 0; i < AUTH_TABLE_SIZE; i++) {
-            AuthNode* current = table[i];
-            while(current != NULL) {
+
+        for(size_t i = 0; i < buckets.size(); i++) {
+            for(AuthNode* current = buckets[i]; current != NULL; current = current->next) {
                 current->user->display();
-                current = current->next;
             }
         }
     }
-    
+
     void displayPendingUsers() {
+        shared_lock<shared_mutex> lock(tableLock);
         cout << "\n=== Pending User Approvals ===" << endl;
         int pendingCount = 0;
-        
-        for(int i = 0; i < AUTH_TABLE_SIZE; i++) {
-            AuthNode* current = table[i];
-            while(current != NULL) {
+
+        for(size_t i = 0; i < buckets.size(); i++) {
+            for(AuthNode* current = buckets[i]; current != NULL; current = current->next) {
                 if(current->user->status == "PENDING") {
                     current->user->display();
                     pendingCount++;
                 }
-                current = current->next;
             }
         }
-        
+
         if(pendingCount == 0) {
             cout << "No pending user approvals." << endl;
         }
         cout << "\nTotal Pending: " << pendingCount << endl;
         cout << "==============================\n" << endl;
     }
-    
+
     int getTotalUsers() {
+        shared_lock<shared_mutex> lock(tableLock);
         return totalUsers;
     }
+
+    int getBucketCount() {
+        shared_lock<shared_mutex> lock(tableLock);
+        return (int)buckets.size();
+    }
+
+    // Users are owned here; chain nodes are released in bulk by nodePool
+    ~AuthSystem() {
+        for(size_t i = 0; i < buckets.size(); i++) {
+            for(AuthNode* current = buckets[i]; current != NULL; current = current->next) {
+                delete current->user;
+            }
+        }
+    }
 };
 
 #endif
@@ -3,100 +3,639 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
 #include "vehicle.h"
+#include "buffer_pool.h"
 using namespace std;
 
-#define MAX_VEHICLES 100
+#define BTREE_MAGIC 0x42545246u     // "FRTB"
+#define BTREE_VERSION 1
+#define BTREE_KEY_SIZE 16           // Vehicle IDs up to 15 chars
+#define BTREE_DEFAULT_FANOUT 64
+#define BTREE_DEFAULT_CACHE_PAGES 256
+#define BTREE_HEADER_SIZE 16
 
-// Simple B-Tree simulation using sorted array
+// Fixed-width on-disk copy of a Vehicle (strings are zero-padded)
+struct VehicleRecord {
+    char registrationNumber[24];
+    char model[32];
+    char type[16];
+    char status[16];
+    char assignedDriverId[16];
+    int32_t year;
+    int32_t daysSinceLastService;
+    double kilometersRun;
+};
+
+struct LeafEntry {
+    char key[BTREE_KEY_SIZE];
+    VehicleRecord record;
+};
+
+// Page 0 of the index file
+struct BTreeMeta {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t rootPage;
+    uint32_t firstLeaf;
+    uint32_t fanout;
+    uint32_t height;
+    uint64_t count;
+};
+
+// Header at the start of every node page
+struct NodeHeader {
+    uint8_t isLeaf;
+    uint8_t reserved;
+    uint16_t numKeys;
+    uint32_t nextLeaf;  // Leaf sibling link (INVALID_PAGE at the end)
+    uint32_t prevLeaf;
+    uint32_t unused;
+};
+
+#define BTREE_MAX_LEAF_KEYS ((PAGE_SIZE - BTREE_HEADER_SIZE) / (int)sizeof(LeafEntry))
+#define BTREE_MAX_INTERNAL_KEYS ((PAGE_SIZE - BTREE_HEADER_SIZE - 4) / (BTREE_KEY_SIZE + 4))
+
+// Disk-backed B+Tree keyed on vehicleId.
+// Pages are PAGE_SIZE bytes in a single file and go through an LRU
+// BufferPool. Internal nodes hold separator keys and child page numbers;
+// leaves hold the full VehicleRecord and are chained left-to-right, so a
+// range scan is one root-to-leaf descent followed by a sibling walk.
+// The index persists across restarts: reopening the same file reloads the
+// tree from its meta page.
 class BTree {
 private:
-    Vehicle* vehicles[MAX_VEHICLES];
-    int count;
-
-    // Binary search
-    int binarySearch(string vehicleId) {
-        int left = 0;
-        int right = count - 1;
-        
-        while(left <= right) {
-            int mid = left + (right - left) / 2;
-            
-            if(vehicles[mid]->vehicleId == vehicleId) {
-                return mid;
+    BufferPool pool;
+    BTreeMeta meta;
+    int maxLeafKeys;
+    int maxInternalKeys;
+    bool verbose;
+
+    // ---- Page layout helpers ----
+    static NodeHeader* header(char* page) {
+        return reinterpret_cast<NodeHeader*>(page);
+    }
+
+    static LeafEntry* leafEntries(char* page) {
+        return reinterpret_cast<LeafEntry*>(page + BTREE_HEADER_SIZE);
+    }
+
+    static char* internalKey(char* page, int i) {
+        return page + BTREE_HEADER_SIZE + i * BTREE_KEY_SIZE;
+    }
+
+    static uint32_t* internalChildren(char* page) {
+        return reinterpret_cast<uint32_t*>(page + BTREE_HEADER_SIZE + BTREE_MAX_INTERNAL_KEYS * BTREE_KEY_SIZE);
+    }
+
+    static int compareKeys(const char* a, const char* b) {
+        return memcmp(a, b, BTREE_KEY_SIZE);
+    }
+
+    static bool makeKey(const string& id, char* key) {
+        if(id.empty() || id.size() >= BTREE_KEY_SIZE) return false;
+        memset(key, 0, BTREE_KEY_SIZE);
+        memcpy(key, id.data(), id.size());
+        return true;
+    }
+
+    static void copyField(char* dst, size_t size, const string& src) {
+        memset(dst, 0, size);
+        memcpy(dst, src.data(), src.size() < size - 1 ? src.size() : size - 1);
+    }
+
+    static void toRecord(const Vehicle& v, VehicleRecord& r) {
+        copyField(r.registrationNumber, sizeof(r.registrationNumber), v.registrationNumber);
+        copyField(r.model, sizeof(r.model), v.model);
+        copyField(r.type, sizeof(r.type), vehicleTypeName(v.type));
+        copyField(r.status, sizeof(r.status), vehicleStatusName(v.status));
+        copyField(r.assignedDriverId, sizeof(r.assignedDriverId), v.assignedDriverId);
+        r.year = v.year;
+        r.daysSinceLastService = v.daysSinceLastService;
+        r.kilometersRun = v.kilometersRun;
+    }
+
+    // False if the stored status is not a known name (corrupt record)
+    static bool fromEntry(const LeafEntry& e, Vehicle& v) {
+        v.vehicleId = string(e.key, strnlen(e.key, BTREE_KEY_SIZE));
+        v.registrationNumber = e.record.registrationNumber;
+        v.model = e.record.model;
+        v.type = parseVehicleType(e.record.type);
+        string status(e.record.status, strnlen(e.record.status, sizeof(e.record.status)));
+        if(!parseVehicleStatus(status, v.status)) {
+            cout << "❌ Unknown status '" << status << "' stored for " << v.vehicleId << endl;
+            return false;
+        }
+        v.assignedDriverId = e.record.assignedDriverId;
+        v.year = e.record.year;
+        v.daysSinceLastService = e.record.daysSinceLastService;
+        v.kilometersRun = e.record.kilometersRun;
+        return true;
+    }
+
+    // First leaf slot whose key is >= key
+    static int leafLowerBound(char* page, const char* key) {
+        int lo = 0;
+        int hi = header(page)->numKeys;
+        LeafEntry* entries = leafEntries(page);
+        while(lo < hi) {
+            int mid = (lo + hi) / 2;
+            if(compareKeys(entries[mid].key, key) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Child to follow: number of separators <= key
+    static int childIndex(char* page, const char* key) {
+        int lo = 0;
+        int hi = header(page)->numKeys;
+        while(lo < hi) {
+            int mid = (lo + hi) / 2;
+            if(compareKeys(internalKey(page, mid), key) <= 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    char* newNode(uint32_t& pageId, bool leaf) {
+        char* page = pool.allocatePage(pageId);
+        if(page == NULL) return NULL;
+        NodeHeader* h = header(page);
+        h->isLeaf = leaf ? 1 : 0;
+        h->numKeys = 0;
+        h->nextLeaf = INVALID_PAGE;
+        h->prevLeaf = INVALID_PAGE;
+        return page;
+    }
+
+    // Pin a node page and check its header against this tree's limits.
+    // A corrupt page (key count over capacity, or a child / sibling id past
+    // the end of the file) is released and reported as NULL, so callers
+    // never index into it.
+    char* fetchNode(uint32_t pageId) {
+        if(pageId == 0 || pageId >= pool.getNumPages()) {
+            cout << "❌ B-Tree page id " << pageId << " is out of range!" << endl;
+            return NULL;
+        }
+        char* page = pool.fetchPage(pageId);
+        if(page == NULL) return NULL;
+
+        NodeHeader* h = header(page);
+        uint32_t numPages = pool.getNumPages();
+        bool valid = h->isLeaf <= 1;
+        if(valid && h->isLeaf) {
+            valid = h->numKeys <= maxLeafKeys &&
+                    (h->nextLeaf == INVALID_PAGE || (h->nextLeaf != 0 && h->nextLeaf < numPages)) &&
+                    (h->prevLeaf == INVALID_PAGE || (h->prevLeaf != 0 && h->prevLeaf < numPages));
+        } else if(valid) {
+            valid = h->numKeys <= maxInternalKeys;
+            uint32_t* children = internalChildren(page);
+            for(int i = 0; valid && i <= h->numKeys; i++) {
+                valid = children[i] != 0 && children[i] < numPages;
             }
-            
-            if(vehicles[mid]->vehicleId < vehicleId) {
-                left = mid + 1;
-            } else {
-                right = mid - 1;
+        }
+        if(!valid) {
+            pool.unpinPage(pageId, false);
+            cout << "❌ B-Tree page " << pageId << " is corrupt!" << endl;
+            return NULL;
+        }
+        return page;
+    }
+
+    void writeMeta() {
+        char* page = pool.fetchPage(0);
+        if(page == NULL) return;
+        memcpy(page, &meta, sizeof(meta));
+        pool.unpinPage(0, true);
+    }
+
+    // Descend to the leaf that would hold key; returns its page id, or
+    // INVALID_PAGE if a page is unreadable or the path is deeper than height
+    uint32_t findLeaf(const char* key) {
+        uint32_t pageId = meta.rootPage;
+        for(uint32_t depth = 0; depth < meta.height; depth++) {
+            char* page = fetchNode(pageId);
+            if(page == NULL) return INVALID_PAGE;
+            if(header(page)->isLeaf) {
+                pool.unpinPage(pageId, false);
+                return pageId;
             }
+            uint32_t child = internalChildren(page)[childIndex(page, key)];
+            pool.unpinPage(pageId, false);
+            pageId = child;
         }
-        
-        return -1;
+        cout << "❌ B-Tree is deeper than its recorded height!" << endl;
+        return INVALID_PAGE;
     }
 
-    // Find insertion position
-    int findInsertPosition(string vehicleId) {
-        int pos = 0;
-        while(pos < count && vehicles[pos]->vehicleId < vehicleId) {
-            pos++;
+    enum InsertResult { INSERT_FAILED, INSERT_DUPLICATE, INSERT_OK, INSERT_SPLIT };
+
+    // Recursive insert. On INSERT_SPLIT, splitKey/splitPage describe the new
+    // right sibling the caller must link in. Pages are never held pinned
+    // across the recursive call, so the pool only needs a handful of frames.
+    InsertResult insertInto(uint32_t pageId, uint32_t depth, const LeafEntry& entry, char* splitKey, uint32_t& splitPage) {
+        if(depth >= meta.height) {
+            cout << "❌ B-Tree is deeper than its recorded height!" << endl;
+            return INSERT_FAILED;
+        }
+        char* page = fetchNode(pageId);
+        if(page == NULL) return INSERT_FAILED;
+
+        if(header(page)->isLeaf) {
+            InsertResult result = insertIntoLeaf(pageId, page, entry, splitKey, splitPage);
+            return result;
         }
-        return pos;
+
+        int idx = childIndex(page, entry.key);
+        uint32_t child = internalChildren(page)[idx];
+        pool.unpinPage(pageId, false);
+
+        char childKey[BTREE_KEY_SIZE];
+        uint32_t childPage = INVALID_PAGE;
+        InsertResult result = insertInto(child, depth + 1, entry, childKey, childPage);
+        if(result != INSERT_SPLIT) return result;
+
+        page = fetchNode(pageId);
+        if(page == NULL) return INSERT_FAILED;
+        return insertIntoInternal(pageId, page, idx, childKey, childPage, splitKey, splitPage);
+    }
+
+    InsertResult insertIntoLeaf(uint32_t pageId, char* page, const LeafEntry& entry, char* splitKey, uint32_t& splitPage) {
+        NodeHeader* h = header(page);
+        LeafEntry* entries = leafEntries(page);
+        int pos = leafLowerBound(page, entry.key);
+
+        if(pos < h->numKeys && compareKeys(entries[pos].key, entry.key) == 0) {
+            pool.unpinPage(pageId, false);
+            return INSERT_DUPLICATE;
+        }
+
+        if(h->numKeys < maxLeafKeys) {
+            memmove(&entries[pos + 1], &entries[pos], (h->numKeys - pos) * sizeof(LeafEntry));
+            entries[pos] = entry;
+            h->numKeys++;
+            pool.unpinPage(pageId, true);
+            return INSERT_OK;
+        }
+
+        // Split: gather n+1 entries, keep the left half, move the rest right
+        vector<LeafEntry> all(entries, entries + h->numKeys);
+        all.insert(all.begin() + pos, entry);
+        int leftCount = (int)all.size() / 2;
+
+        uint32_t rightId;
+        char* right = newNode(rightId, true);
+        if(right == NULL) {
+            pool.unpinPage(pageId, false);
+            return INSERT_FAILED;
+        }
+        NodeHeader* rh = header(right);
+        rh->numKeys = (uint16_t)(all.size() - leftCount);
+        memcpy(leafEntries(right), &all[leftCount], rh->numKeys * sizeof(LeafEntry));
+        rh->nextLeaf = h->nextLeaf;
+        rh->prevLeaf = pageId;
+
+        memcpy(entries, &all[0], leftCount * sizeof(LeafEntry));
+        h->numKeys = (uint16_t)leftCount;
+        uint32_t oldNext = h->nextLeaf;
+        h->nextLeaf = rightId;
+
+        memcpy(splitKey, leafEntries(right)[0].key, BTREE_KEY_SIZE);
+        splitPage = rightId;
+        pool.unpinPage(rightId, true);
+        pool.unpinPage(pageId, true);
+
+        if(oldNext != INVALID_PAGE) {
+            char* next = fetchNode(oldNext);
+            if(next != NULL) {
+                header(next)->prevLeaf = rightId;
+                pool.unpinPage(oldNext, true);
+            }
+        }
+        return INSERT_SPLIT;
+    }
+
+    InsertResult insertIntoInternal(uint32_t pageId, char* page, int idx, const char* key, uint32_t child,
+                                    char* splitKey, uint32_t& splitPage) {
+        NodeHeader* h = header(page);
+        uint32_t* children = internalChildren(page);
+        int n = h->numKeys;
+
+        if(n < maxInternalKeys) {
+            memmove(internalKey(page, idx + 1), internalKey(page, idx), (n - idx) * BTREE_KEY_SIZE);
+            memcpy(internalKey(page, idx), key, BTREE_KEY_SIZE);
+            memmove(&children[idx + 2], &children[idx + 1], (n - idx) * sizeof(uint32_t));
+            children[idx + 1] = child;
+            h->numKeys++;
+            pool.unpinPage(pageId, true);
+            return INSERT_OK;
+        }
+
+        // Split: middle separator moves up and is not kept in either half
+        vector<char> keys((n + 1) * BTREE_KEY_SIZE);
+        vector<uint32_t> kids(n + 2);
+        // Pointer arithmetic, not operator[]: when idx == n the tail copies
+        // start one past the end (with zero length)
+        memcpy(keys.data(), internalKey(page, 0), idx * BTREE_KEY_SIZE);
+        memcpy(keys.data() + idx * BTREE_KEY_SIZE, key, BTREE_KEY_SIZE);
+        memcpy(keys.data() + (idx + 1) * BTREE_KEY_SIZE, internalKey(page, idx), (n - idx) * BTREE_KEY_SIZE);
+        memcpy(kids.data(), children, (idx + 1) * sizeof(uint32_t));
+        kids[idx + 1] = child;
+        memcpy(kids.data() + idx + 2, children + idx + 1, (n - idx) * sizeof(uint32_t));
+
+        int total = n + 1;
+        int mid = total / 2;
+
+        uint32_t rightId;
+        char* right = newNode(rightId, false);
+        if(right == NULL) {
+            pool.unpinPage(pageId, false);
+            return INSERT_FAILED;
+        }
+        int rightKeys = total - mid - 1;
+        header(right)->numKeys = (uint16_t)rightKeys;
+        memcpy(internalKey(right, 0), keys.data() + (mid + 1) * BTREE_KEY_SIZE, rightKeys * BTREE_KEY_SIZE);
+        memcpy(internalChildren(right), kids.data() + mid + 1, (rightKeys + 1) * sizeof(uint32_t));
+
+        h->numKeys = (uint16_t)mid;
+        memcpy(internalKey(page, 0), keys.data(), mid * BTREE_KEY_SIZE);
+        memcpy(children, kids.data(), (mid + 1) * sizeof(uint32_t));
+
+        memcpy(splitKey, keys.data() + mid * BTREE_KEY_SIZE, BTREE_KEY_SIZE);
+        splitPage = rightId;
+        pool.unpinPage(rightId, true);
+        pool.unpinPage(pageId, true);
+        return INSERT_SPLIT;
+    }
+
+    void initEmpty(int fanout) {
+        memset(&meta, 0, sizeof(meta));
+        meta.magic = BTREE_MAGIC;
+        meta.version = BTREE_VERSION;
+        meta.fanout = (uint32_t)fanout;
+        meta.height = 1;
+        meta.count = 0;
+
+        uint32_t metaId;
+        char* metaPage = pool.allocatePage(metaId);
+        if(metaPage == NULL) return;
+        pool.unpinPage(metaId, true);
+
+        uint32_t rootId;
+        if(newNode(rootId, true) == NULL) return;
+        pool.unpinPage(rootId, true);
+        meta.rootPage = rootId;
+        meta.firstLeaf = rootId;
+        writeMeta();
+    }
+
+    void configureFanout() {
+        // fanout = max children per internal node; leaves hold fanout-1 entries,
+        // both clamped to what physically fits in a page
+        int fanout = (int)meta.fanout < 3 ? 3 : (int)meta.fanout;
+        maxInternalKeys = fanout - 1 < BTREE_MAX_INTERNAL_KEYS ? fanout - 1 : BTREE_MAX_INTERNAL_KEYS;
+        maxLeafKeys = fanout - 1 < BTREE_MAX_LEAF_KEYS ? fanout - 1 : BTREE_MAX_LEAF_KEYS;
+        if(maxLeafKeys < 2) maxLeafKeys = 2;
     }
 
 public:
-    BTree() {
-        count = 0;
-        for(int i = 0; i < MAX_VEHICLES; i++) {
-            vehicles[i] = NULL;
+    // Opens (or creates) the index file. An existing file keeps its stored
+    // fanout; pass truncate=true to start from an empty tree.
+    BTree(const string& filePath = "vehicle_index.db", int fanout = BTREE_DEFAULT_FANOUT,
+          bool truncate = false, int cachePages = BTREE_DEFAULT_CACHE_PAGES)
+        : pool(filePath, cachePages, truncate) {
+        verbose = true;
+        memset(&meta, 0, sizeof(meta));
+
+        if(pool.isOpen() && pool.getNumPages() > 0) {
+            char* page = pool.fetchPage(0);
+            if(page != NULL) {
+                memcpy(&meta, page, sizeof(meta));
+                pool.unpinPage(0, false);
+            }
+            uint32_t numPages = pool.getNumPages();
+            if(meta.magic != BTREE_MAGIC || meta.version != BTREE_VERSION) {
+                cout << "❌ " << filePath << " is not a vehicle index file!" << endl;
+                meta.magic = 0;
+            } else if(meta.rootPage == 0 || meta.rootPage >= numPages ||
+                      meta.firstLeaf == 0 || meta.firstLeaf >= numPages ||
+                      meta.height == 0 || meta.height >= numPages) {
+                // Every level needs at least one page besides the meta page
+                cout << "❌ " << filePath << " has a corrupt meta page!" << endl;
+                meta.magic = 0;
+            }
+            configureFanout();
+            if(meta.magic == BTREE_MAGIC) {
+                char* root = fetchNode(meta.rootPage);
+                if(root == NULL) meta.magic = 0;
+                else pool.unpinPage(meta.rootPage, false);
+            }
+        } else if(pool.isOpen()) {
+            initEmpty(fanout);
+            configureFanout();
         }
     }
 
-    // Insert vehicle - maintains sorted order
-    void insert(Vehicle* vehicle) {
-        if(count >= MAX_VEHICLES) {
-            cout << "❌ B-Tree is full!" << endl;
-            return;
+    BTree(const BTree&) = delete;
+    BTree& operator=(const BTree&) = delete;
+
+    bool isOpen() {
+        return pool.isOpen() && meta.magic == BTREE_MAGIC;
+    }
+
+    // Turn off per-operation console output (bulk loads, benchmarks)
+    void setVerbose(bool v) {
+        verbose = v;
+    }
+
+    // Insert vehicle - O(log n), rejects duplicate IDs
+    bool insert(Vehicle* vehicle) {
+        if(vehicle == NULL || !isOpen()) return false;
+
+        LeafEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        if(!makeKey(vehicle->vehicleId, entry.key)) {
+            if(verbose) cout << "❌ Vehicle ID must be 1-" << (BTREE_KEY_SIZE - 1) << " characters!" << endl;
+            return false;
+        }
+        toRecord(*vehicle, entry.record);
+
+        char splitKey[BTREE_KEY_SIZE];
+        uint32_t splitPage = INVALID_PAGE;
+        InsertResult result = insertInto(meta.rootPage, 0, entry, splitKey, splitPage);
+
+        if(result == INSERT_DUPLICATE) {
+            if(verbose) cout << "❌ Vehicle " << vehicle->vehicleId << " already in B-Tree!" << endl;
+            return false;
+        }
+        if(result == INSERT_FAILED) {
+            if(verbose) cout << "❌ B-Tree insert failed (I/O error or corrupt page)" << endl;
+            return false;
+        }
+
+        if(result == INSERT_SPLIT) {
+            // Root split - tree grows by one level
+            uint32_t newRootId;
+            char* root = newNode(newRootId, false);
+            if(root == NULL) return false;
+            header(root)->numKeys = 1;
+            memcpy(internalKey(root, 0), splitKey, BTREE_KEY_SIZE);
+            internalChildren(root)[0] = meta.rootPage;
+            internalChildren(root)[1] = splitPage;
+            pool.unpinPage(newRootId, true);
+            meta.rootPage = newRootId;
+            meta.height++;
+        }
+
+        meta.count++;
+        writeMeta();
+
+        if(verbose) cout << "✅ Vehicle " << vehicle->vehicleId << " inserted into B-Tree" << endl;
+        return true;
+    }
+
+    // Overwrite the stored record of an existing vehicle - O(log n)
+    bool update(const Vehicle& vehicle) {
+        if(!isOpen()) return false;
+        char key[BTREE_KEY_SIZE];
+        if(!makeKey(vehicle.vehicleId, key)) return false;
+
+        uint32_t leafId = findLeaf(key);
+        if(leafId == INVALID_PAGE) return false;
+        char* page = fetchNode(leafId);
+        if(page == NULL) return false;
+
+        int pos = leafLowerBound(page, key);
+        bool found = pos < header(page)->numKeys && compareKeys(leafEntries(page)[pos].key, key) == 0;
+        if(found) {
+            toRecord(vehicle, leafEntries(page)[pos].record);
         }
-        
-        int pos = findInsertPosition(vehicle->vehicleId);
-        
-        // Shift elements to make space
-        for(int i = count; i > pos; i--) {
-            vehicles[i] = vehicles[i - 1];
+        pool.unpinPage(leafId, found);
+        return found;
+    }
+
+    // Remove a vehicle from its leaf - O(log n).
+    // Leaves are allowed to underflow (no merging); separators stay valid
+    // because they only need to bound their subtrees.
+    bool remove(const string& vehicleId) {
+        if(!isOpen()) return false;
+        char key[BTREE_KEY_SIZE];
+        if(!makeKey(vehicleId, key)) return false;
+
+        uint32_t leafId = findLeaf(key);
+        if(leafId == INVALID_PAGE) return false;
+        char* page = fetchNode(leafId);
+        if(page == NULL) return false;
+
+        NodeHeader* h = header(page);
+        LeafEntry* entries = leafEntries(page);
+        int pos = leafLowerBound(page, key);
+        if(pos >= h->numKeys || compareKeys(entries[pos].key, key) != 0) {
+            pool.unpinPage(leafId, false);
+            return false;
         }
-        
-        vehicles[pos] = vehicle;
-        count++;
-        
-        cout << "✅ Vehicle " << vehicle->vehicleId << " inserted into B-Tree at position " << pos << endl;
+
+        memmove(&entries[pos], &entries[pos + 1], (h->numKeys - pos - 1) * sizeof(LeafEntry));
+        h->numKeys--;
+        pool.unpinPage(leafId, true);
+
+        meta.count--;
+        writeMeta();
+        return true;
     }
 
-    // Search - O(log n) binary search
-    Vehicle* search(string vehicleId) {
-        int index = binarySearch(vehicleId);
-        if(index != -1) {
-            return vehicles[index];
+    // Search - O(log n), copies the stored record into 'out'; false if the
+    // ID is absent or its record is corrupt
+    bool search(const string& vehicleId, Vehicle& out) {
+        if(!isOpen()) return false;
+        char key[BTREE_KEY_SIZE];
+        if(!makeKey(vehicleId, key)) return false;
+
+        uint32_t leafId = findLeaf(key);
+        if(leafId == INVALID_PAGE) return false;
+        char* page = fetchNode(leafId);
+        if(page == NULL) return false;
+
+        int pos = leafLowerBound(page, key);
+        bool found = pos < header(page)->numKeys && compareKeys(leafEntries(page)[pos].key, key) == 0;
+        if(found) {
+            found = fromEntry(leafEntries(page)[pos], out);
         }
-        return NULL;
+        pool.unpinPage(leafId, false);
+        return found;
     }
 
-    // Display all vehicles (already sorted)
+    // Range query [start, end] - O(log n + k): one descent, then follow
+    // leaf sibling links until a key passes 'end'
+    int rangeQuery(const string& start, const string& end, vector<Vehicle>& out) {
+        out.clear();
+        if(!isOpen()) return 0;
+
+        char startKey[BTREE_KEY_SIZE];
+        char endKey[BTREE_KEY_SIZE];
+        memset(startKey, 0, BTREE_KEY_SIZE);
+        memset(endKey, 0, BTREE_KEY_SIZE);
+        memcpy(startKey, start.data(), start.size() < BTREE_KEY_SIZE ? start.size() : BTREE_KEY_SIZE);
+        memcpy(endKey, end.data(), end.size() < BTREE_KEY_SIZE ? end.size() : BTREE_KEY_SIZE);
+
+        uint32_t leafId = findLeaf(startKey);
+        int pos = -1;
+
+        // A sane leaf chain visits each page at most once
+        for(uint32_t visited = 0; leafId != INVALID_PAGE && visited < pool.getNumPages(); visited++) {
+            char* page = fetchNode(leafId);
+            if(page == NULL) break;
+
+            NodeHeader* h = header(page);
+            LeafEntry* entries = leafEntries(page);
+            if(pos == -1) pos = leafLowerBound(page, startKey);
+
+            for(; pos < h->numKeys; pos++) {
+                if(compareKeys(entries[pos].key, endKey) > 0) {
+                    pool.unpinPage(leafId, false);
+                    return (int)out.size();
+                }
+                Vehicle v;
+                if(fromEntry(entries[pos], v)) out.push_back(v);
+            }
+
+            uint32_t next = h->nextLeaf;
+            pool.unpinPage(leafId, false);
+            leafId = next;
+            pos = 0;
+        }
+        return (int)out.size();
+    }
+
+    // Display all vehicles by walking the leaf chain (already sorted)
     void displayAll() {
-        if(count == 0) {
+        if(meta.count == 0) {
             cout << "\n📦 B-Tree is EMPTY" << endl;
             return;
         }
-        
+
         cout << "\n========== B-TREE SORTED INDEX ==========" << endl;
-        cout << "Total Vehicles: " << count << endl;
+        cout << "Total Vehicles: " << meta.count << endl;
         cout << "=========================================\n" << endl;
-        
-        for(int i = 0; i < count; i++) {
-            cout << (i + 1) << ". " << vehicles[i]->vehicleId 
-                 << " - " << vehicles[i]->registrationNumber 
-                 << " (" << vehicles[i]->model << ")" << endl;
+
+        int rank = 1;
+        uint32_t leafId = meta.firstLeaf;
+        for(uint32_t visited = 0; leafId != INVALID_PAGE && visited < pool.getNumPages(); visited++) {
+            char* page = fetchNode(leafId);
+            if(page == NULL) break;
+            NodeHeader* h = header(page);
+            for(int i = 0; i < h->numKeys; i++) {
+                LeafEntry& e = leafEntries(page)[i];
+                cout << rank++ << ". " << string(e.key, strnlen(e.key, BTREE_KEY_SIZE))
+                     << " - " << e.record.registrationNumber
+                     << " (" << e.record.model << ")" << endl;
+            }
+            uint32_t next = h->nextLeaf;
+            pool.unpinPage(leafId, false);
+            leafId = next;
         }
         cout << endl;
     }
@@ -104,16 +643,14 @@ public:
     // Display range of vehicles
     void displayRange(string start, string end) {
         cout << "\n=== RANGE QUERY: " << start << " to " << end << " ===" << endl;
-        
-        bool found = false;
-        for(int i = 0; i < count; i++) {
-            if(vehicles[i]->vehicleId >= start && vehicles[i]->vehicleId <= end) {
-                cout << vehicles[i]->vehicleId << " - " << vehicles[i]->model << endl;
-                found = true;
-            }
+
+        vector<Vehicle> result;
+        rangeQuery(start, end, result);
+        for(size_t i = 0; i < result.size(); i++) {
+            cout << result[i].vehicleId << " - " << result[i].model << endl;
         }
-        
-        if(!found) {
+
+        if(result.empty()) {
             cout << "No vehicles in range" << endl;
         }
         cout << "==============================\n" << endl;
@@ -122,20 +659,36 @@ public:
     // Display statistics
     void displayStats() {
         cout << "\n=== B-Tree Statistics ===" << endl;
-        cout << "Total Vehicles: " << count << endl;
-        cout << "Storage Type: Sorted Array (B-Tree simulation)" << endl;
+        cout << "Total Vehicles: " << meta.count << endl;
+        cout << "Storage Type: Disk B+Tree (" << PAGE_SIZE << "-byte pages)" << endl;
+        cout << "Fanout: " << maxInternalKeys + 1 << " (leaf capacity " << maxLeafKeys << ")" << endl;
+        cout << "Height: " << meta.height << endl;
+        cout << "Pages: " << pool.getNumPages() << endl;
+        cout << "Buffer Pool: " << pool.getCapacity() << " frames, "
+             << pool.getHits() << " hits / " << pool.getMisses() << " misses" << endl;
         cout << "Search Complexity: O(log n)" << endl;
-        cout << "Insert Complexity: O(n)" << endl;
-        cout << "Tree Status: " << (count == 0 ? "EMPTY" : "ACTIVE") << endl;
+        cout << "Insert Complexity: O(log n)" << endl;
+        cout << "Tree Status: " << (meta.count == 0 ? "EMPTY" : "ACTIVE") << endl;
         cout << "=========================\n" << endl;
     }
 
     int getTotalVehicles() {
-        return count;
+        return (int)meta.count;
+    }
+
+    int getHeight() {
+        return (int)meta.height;
+    }
+
+    // Persist meta and dirty pages
+    bool flush() {
+        if(!isOpen()) return false;
+        writeMeta();
+        return pool.flushAll();
     }
 
     ~BTree() {
-        // Vehicles are managed elsewhere
+        flush();
     }
 };
 
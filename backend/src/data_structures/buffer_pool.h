@@ -0,0 +1,213 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+using namespace std;
+
+#define PAGE_SIZE 4096
+#define INVALID_PAGE 0xFFFFFFFFu
+
+// One cached page frame
+struct PageFrame {
+    alignas(8) char data[PAGE_SIZE];
+    uint32_t pageId;
+    int pinCount;
+    bool dirty;
+    int prev;       // LRU list links (frame indices)
+    int next;
+};
+
+// Fixed-size page cache over a single file with LRU eviction.
+// Callers pin a page with fetchPage() and must release it with unpinPage();
+// only unpinned frames are eviction candidates. Dirty frames are written
+// back on eviction and on flushAll().
+class BufferPool {
+private:
+    FILE* file;
+    vector<PageFrame> frames;
+    unordered_map<uint32_t, int> frameOf;   // pageId -> frame index
+    vector<int> freeFrames;
+    int lruHead;    // Most recently used
+    int lruTail;    // Least recently used
+    uint32_t numPages;
+
+    long long hits;
+    long long misses;
+    long long evictions;
+
+    void lruRemove(int f) {
+        if(frames[f].prev != -1) frames[frames[f].prev].next = frames[f].next;
+        else lruHead = frames[f].next;
+        if(frames[f].next != -1) frames[frames[f].next].prev = frames[f].prev;
+        else lruTail = frames[f].prev;
+        frames[f].prev = frames[f].next = -1;
+    }
+
+    void lruPushFront(int f) {
+        frames[f].prev = -1;
+        frames[f].next = lruHead;
+        if(lruHead != -1) frames[lruHead].prev = f;
+        lruHead = f;
+        if(lruTail == -1) lruTail = f;
+    }
+
+    bool writeFrame(int f) {
+        if(fseek(file, (long)frames[f].pageId * PAGE_SIZE, SEEK_SET) != 0) return false;
+        if(fwrite(frames[f].data, PAGE_SIZE, 1, file) != 1) return false;
+        frames[f].dirty = false;
+        return true;
+    }
+
+    // Find a frame to load a page into, evicting the LRU unpinned page
+    int grabFrame() {
+        if(!freeFrames.empty()) {
+            int f = freeFrames.back();
+            freeFrames.pop_back();
+            return f;
+        }
+
+        for(int f = lruTail; f != -1; f = frames[f].prev) {
+            if(frames[f].pinCount == 0) {
+                if(frames[f].dirty && !writeFrame(f)) return -1;
+                lruRemove(f);
+                frameOf.erase(frames[f].pageId);
+                evictions++;
+                return f;
+            }
+        }
+
+        cout << "❌ Buffer pool exhausted: all pages pinned!" << endl;
+        return -1;
+    }
+
+public:
+    BufferPool(const string& path, int capacityPages, bool truncate) {
+        file = NULL;
+        lruHead = lruTail = -1;
+        numPages = 0;
+        hits = misses = evictions = 0;
+
+        if(!truncate) {
+            file = fopen(path.c_str(), "r+b");
+        }
+        if(file == NULL) {
+            file = fopen(path.c_str(), "w+b");
+        }
+        if(file == NULL) {
+            cout << "❌ Cannot open page file: " << path << endl;
+            return;
+        }
+
+        fseek(file, 0, SEEK_END);
+        numPages = (uint32_t)(ftell(file) / PAGE_SIZE);
+
+        frames.resize(capacityPages < 4 ? 4 : capacityPages);
+        for(int i = (int)frames.size() - 1; i >= 0; i--) {
+            frames[i].pageId = INVALID_PAGE;
+            frames[i].pinCount = 0;
+            frames[i].dirty = false;
+            frames[i].prev = frames[i].next = -1;
+            freeFrames.push_back(i);
+        }
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    bool isOpen() const {
+        return file != NULL;
+    }
+
+    uint32_t getNumPages() const {
+        return numPages;
+    }
+
+    // Pin a page and return its bytes, or NULL on I/O failure
+    char* fetchPage(uint32_t pageId) {
+        unordered_map<uint32_t, int>::iterator it = frameOf.find(pageId);
+        if(it != frameOf.end()) {
+            int f = it->second;
+            hits++;
+            frames[f].pinCount++;
+            lruRemove(f);
+            lruPushFront(f);
+            return frames[f].data;
+        }
+
+        if(pageId >= numPages) return NULL;
+
+        int f = grabFrame();
+        if(f == -1) return NULL;
+
+        misses++;
+        if(fseek(file, (long)pageId * PAGE_SIZE, SEEK_SET) != 0 ||
+           fread(frames[f].data, PAGE_SIZE, 1, file) != 1) {
+            // Short read: hand the frame back instead of serving zeroes
+            clearerr(file);
+            frames[f].pageId = INVALID_PAGE;
+            freeFrames.push_back(f);
+            return NULL;
+        }
+        frames[f].pageId = pageId;
+        frames[f].pinCount = 1;
+        frames[f].dirty = false;
+        frameOf[pageId] = f;
+        lruPushFront(f);
+        return frames[f].data;
+    }
+
+    // Append a zeroed page to the file; it is returned pinned and dirty
+    char* allocatePage(uint32_t& pageId) {
+        int f = grabFrame();
+        if(f == -1) return NULL;
+
+        pageId = numPages++;
+        memset(frames[f].data, 0, PAGE_SIZE);
+        frames[f].pageId = pageId;
+        frames[f].pinCount = 1;
+        frames[f].dirty = true;
+        frameOf[pageId] = f;
+        lruPushFront(f);
+        return frames[f].data;
+    }
+
+    void unpinPage(uint32_t pageId, bool dirty) {
+        unordered_map<uint32_t, int>::iterator it = frameOf.find(pageId);
+        if(it == frameOf.end()) return;
+        PageFrame& frame = frames[it->second];
+        if(frame.pinCount > 0) frame.pinCount--;
+        if(dirty) frame.dirty = true;
+    }
+
+    // Write every dirty page back and sync the stdio buffer
+    bool flushAll() {
+        if(file == NULL) return false;
+        bool ok = true;
+        for(size_t f = 0; f < frames.size(); f++) {
+            if(frames[f].pageId != INVALID_PAGE && frames[f].dirty) {
+                ok = writeFrame((int)f) && ok;
+            }
+        }
+        return fflush(file) == 0 && ok;
+    }
+
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    long long getEvictions() const { return evictions; }
+    int getCapacity() const { return (int)frames.size(); }
+
+    ~BufferPool() {
+        if(file != NULL) {
+            flushAll();
+            fclose(file);
+        }
+    }
+};
+
+#endif
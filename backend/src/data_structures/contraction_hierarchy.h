@@ -0,0 +1,573 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "csr_graph.h"
+using namespace std;
+
+#define CH_MAGIC 0x31484346u        // "FCH1"
+#define CH_VERSION 1
+#define CH_WITNESS_SETTLE_LIMIT 500
+
+// Edge of the contraction hierarchy. 'middle' is the vertex a shortcut
+// bypasses (-1 for an original road).
+struct CHEdge {
+    int to;
+    int weight;
+    int middle;
+};
+
+// Contraction Hierarchy over an undirected road graph (every road is stored
+// as two arcs, as Graph::addRoad does).
+//
+// Preprocessing contracts vertices one at a time in order of importance
+// (edge difference, contracted neighbours and depth; neighbours are
+// re-scored after each contraction, everything else lazily). Contracting v
+// adds a shortcut u-w for each neighbour pair whose shortest path runs
+// through v, unless a bounded witness search finds an equally short detour.
+// The result is kept as an "upward" CSR graph: each vertex only stores arcs
+// to vertices contracted after it.
+//
+// A query runs Dijkstra upward from both endpoints and meets at the highest
+// vertex of the shortest path, so it settles a few hundred vertices even on
+// metro-scale maps. Shortcuts are unpacked recursively into road vertices.
+class ContractionHierarchy {
+private:
+    struct HeapItem {
+        int key;
+        int node;
+        bool operator>(const HeapItem& other) const {
+            return key > other.key;
+        }
+    };
+
+    // Per-direction query workspace (generation-stamped like DijkstraSearch)
+    struct SearchSide {
+        vector<int> dist;
+        vector<int> parent;
+        vector<int> parentArc;
+        vector<uint32_t> stamp;
+        vector<HeapItem> heap;
+    };
+
+    int numVertices;
+    vector<int> rank;               // Contraction order
+    vector<int> upOffsets;
+    vector<int> upTargets;
+    vector<int> upWeights;
+    vector<int> upMiddle;
+    int numShortcuts;
+
+    SearchSide forward;
+    SearchSide backward;
+    uint32_t generation;
+
+    static void heapPush(vector<HeapItem>& heap, int key, int node) {
+        heap.push_back(HeapItem{key, node});
+        push_heap(heap.begin(), heap.end(), greater<HeapItem>());
+    }
+
+    static HeapItem heapPop(vector<HeapItem>& heap) {
+        pop_heap(heap.begin(), heap.end(), greater<HeapItem>());
+        HeapItem top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    // Insert edge or lower the weight of an existing one to the same vertex
+    static void addOrImprove(vector<CHEdge>& list, int to, int weight, int middle) {
+        for(size_t i = 0; i < list.size(); i++) {
+            if(list[i].to == to) {
+                if(weight < list[i].weight) {
+                    list[i].weight = weight;
+                    list[i].middle = middle;
+                }
+                return;
+            }
+        }
+        list.push_back(CHEdge{to, weight, middle});
+    }
+
+    // ---- Preprocessing state (only alive during build) ----
+    struct Shortcut {
+        int from;
+        int to;
+        int weight;
+    };
+
+    struct BuildState {
+        vector<vector<CHEdge> > adj;
+        vector<int> contractedNeighbors;
+        vector<int> level;
+        vector<int> priority;           // Current key; older heap entries are stale
+        vector<int> witnessDist;
+        vector<uint32_t> witnessStamp;
+        uint32_t witnessGeneration;
+        vector<HeapItem> witnessHeap;
+        vector<Shortcut> shortcuts;
+    };
+
+    // Bounded Dijkstra from source in the remaining graph, skipping 'avoid'
+    static void witnessSearch(BuildState& st, int source, int avoid, int maxDist) {
+        st.witnessGeneration++;
+        st.witnessHeap.clear();
+        st.witnessStamp[source] = st.witnessGeneration;
+        st.witnessDist[source] = 0;
+        heapPush(st.witnessHeap, 0, source);
+
+        int settled = 0;
+        while(!st.witnessHeap.empty()) {
+            HeapItem top = heapPop(st.witnessHeap);
+            int u = top.node;
+            if(top.key > st.witnessDist[u]) continue;
+            if(top.key > maxDist || ++settled > CH_WITNESS_SETTLE_LIMIT) break;
+
+            const vector<CHEdge>& edges = st.adj[u];
+            for(size_t i = 0; i < edges.size(); i++) {
+                int v = edges[i].to;
+                if(v == avoid) continue;
+                int nd = top.key + edges[i].weight;
+                if(st.witnessStamp[v] != st.witnessGeneration || nd < st.witnessDist[v]) {
+                    st.witnessStamp[v] = st.witnessGeneration;
+                    st.witnessDist[v] = nd;
+                    heapPush(st.witnessHeap, nd, v);
+                }
+            }
+        }
+    }
+
+    // Fill st.shortcuts with the shortcuts contracting v would need
+    static void findShortcuts(BuildState& st, int v) {
+        st.shortcuts.clear();
+        const vector<CHEdge>& edges = st.adj[v];
+
+        for(size_t i = 0; i < edges.size(); i++) {
+            int maxVia = 0;
+            for(size_t j = i + 1; j < edges.size(); j++) {
+                maxVia = max(maxVia, edges[j].weight);
+            }
+            if(i + 1 == edges.size()) break;
+
+            int u = edges[i].to;
+            witnessSearch(st, u, v, edges[i].weight + maxVia);
+
+            for(size_t j = i + 1; j < edges.size(); j++) {
+                int w = edges[j].to;
+                int via = edges[i].weight + edges[j].weight;
+                bool witnessed = st.witnessStamp[w] == st.witnessGeneration && st.witnessDist[w] <= via;
+                if(!witnessed) {
+                    st.shortcuts.push_back(Shortcut{u, w, via});
+                }
+            }
+        }
+    }
+
+    // Edge difference, plus terms that spread contractions evenly over the
+    // map: already-contracted neighbours and the vertex's hierarchy depth
+    static int priorityOf(BuildState& st, int v) {
+        findShortcuts(st, v);
+        int edgeDifference = (int)st.shortcuts.size() - (int)st.adj[v].size();
+        return 2 * edgeDifference + st.contractedNeighbors[v] + st.level[v];
+    }
+
+    // Recursively expand the hierarchy edge a -> b into road vertices,
+    // appending everything after a (up to and including b)
+    void unpackEdge(int a, int b, int middle, vector<int>& nodes) const {
+        if(middle == -1) {
+            nodes.push_back(b);
+            return;
+        }
+        // Both halves were stored at 'middle', which was contracted first
+        int middleToA = -1;
+        int middleToB = -1;
+        for(int arc = upOffsets[middle]; arc < upOffsets[middle + 1]; arc++) {
+            if(upTargets[arc] == a) middleToA = upMiddle[arc];
+            if(upTargets[arc] == b) middleToB = upMiddle[arc];
+        }
+        unpackEdge(a, middle, middleToA, nodes);
+        unpackEdge(middle, b, middleToB, nodes);
+    }
+
+    void prepareSide(SearchSide& side) {
+        if((int)side.stamp.size() != numVertices) {
+            side.dist.assign(numVertices, INF);
+            side.parent.assign(numVertices, -1);
+            side.parentArc.assign(numVertices, -1);
+            side.stamp.assign(numVertices, 0);
+        }
+        side.heap.clear();
+    }
+
+    void resetWorkspaces() {
+        forward = SearchSide();
+        backward = SearchSide();
+        generation = 0;
+    }
+
+    template<typename T>
+    static bool writeArray(FILE* f, const vector<T>& a) {
+        uint64_t n = a.size();
+        if(fwrite(&n, sizeof(n), 1, f) != 1) return false;
+        return n == 0 || fwrite(a.data(), sizeof(T), n, f) == n;
+    }
+
+    static uint64_t bytesLeft(FILE* f) {
+        long here = ftell(f);
+        if(here < 0 || fseek(f, 0, SEEK_END) != 0) return 0;
+        long end = ftell(f);
+        fseek(f, here, SEEK_SET);
+        return end > here ? (uint64_t)(end - here) : 0;
+    }
+
+    // At most maxCount elements, and no more than the file still holds
+    template<typename T>
+    static bool readArray(FILE* f, vector<T>& a, uint64_t maxCount) {
+        uint64_t n;
+        if(fread(&n, sizeof(n), 1, f) != 1 || n > maxCount || n > bytesLeft(f) / sizeof(T)) return false;
+        a.resize(n);
+        return n == 0 || fread(a.data(), sizeof(T), n, f) == n;
+    }
+
+    // A loaded file must describe a real hierarchy: ranks are a permutation,
+    // offsets never go back, every arc goes up to a vertex in range with a
+    // usable weight, and a shortcut's middle ranks below both of its ends
+    // (which is what makes unpackEdge() terminate).
+    bool validUpwardGraph() const {
+        int n = numVertices;
+        vector<char> rankSeen(n, 0);
+        for(int v = 0; v < n; v++) {
+            if(rank[v] < 0 || rank[v] >= n || rankSeen[rank[v]]) return false;
+            rankSeen[rank[v]] = 1;
+        }
+        if(upOffsets[0] != 0) return false;
+        for(int v = 0; v < n; v++) {
+            if(upOffsets[v + 1] < upOffsets[v]) return false;
+            for(int arc = upOffsets[v]; arc < upOffsets[v + 1]; arc++) {
+                int target = upTargets[arc];
+                int middle = upMiddle[arc];
+                if(target < 0 || target >= n || rank[target] <= rank[v]) return false;
+                if(upWeights[arc] < 0 || upWeights[arc] >= INF) return false;
+                if(middle != -1 && (middle < 0 || middle >= n || rank[middle] >= rank[v])) return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    ContractionHierarchy() {
+        numVertices = 0;
+        numShortcuts = 0;
+        generation = 0;
+        upOffsets.assign(1, 0);
+    }
+
+    // Preprocess the road graph. O(n log n) contractions, each bounded by
+    // the witness-search settle limit.
+    void build(const CSRGraph& g) {
+        int n = g.getNumVertices();
+        numVertices = n;
+        numShortcuts = 0;
+        resetWorkspaces();
+
+        BuildState st;
+        st.adj.assign(n, vector<CHEdge>());
+        st.contractedNeighbors.assign(n, 0);
+        st.level.assign(n, 0);
+        st.priority.assign(n, 0);
+        st.witnessDist.assign(n, INF);
+        st.witnessStamp.assign(n, 0);
+        st.witnessGeneration = 0;
+
+        for(int u = 0; u < n; u++) {
+            for(int a = g.arcBegin(u); a < g.arcEnd(u); a++) {
+                if(g.arcTarget(a) != u) {
+                    addOrImprove(st.adj[u], g.arcTarget(a), g.arcWeight(a), -1);
+                }
+            }
+        }
+
+        vector<HeapItem> queue;
+        queue.reserve(n);
+        for(int v = 0; v < n; v++) {
+            st.priority[v] = priorityOf(st, v);
+            queue.push_back(HeapItem{st.priority[v], v});
+        }
+        make_heap(queue.begin(), queue.end(), greater<HeapItem>());
+
+        vector<vector<CHEdge> > up(n);
+        vector<bool> contracted(n, false);
+        rank.assign(n, -1);
+        int order = 0;
+
+        while(!queue.empty()) {
+            HeapItem top = heapPop(queue);
+            int v = top.node;
+            if(contracted[v] || top.key != st.priority[v]) continue;
+
+            // Lazy update: re-evaluate, and defer if no longer the minimum
+            int priority = priorityOf(st, v);
+            if(!queue.empty() && priority > queue.front().key) {
+                st.priority[v] = priority;
+                heapPush(queue, priority, v);
+                continue;
+            }
+
+            // st.shortcuts now holds v's shortcuts (computed by priorityOf)
+            up[v] = st.adj[v];
+            for(size_t i = 0; i < st.shortcuts.size(); i++) {
+                const Shortcut& s = st.shortcuts[i];
+                addOrImprove(st.adj[s.from], s.to, s.weight, v);
+                addOrImprove(st.adj[s.to], s.from, s.weight, v);
+            }
+            numShortcuts += (int)st.shortcuts.size();
+
+            for(size_t i = 0; i < up[v].size(); i++) {
+                vector<CHEdge>& list = st.adj[up[v][i].to];
+                for(size_t j = 0; j < list.size(); j++) {
+                    if(list[j].to == v) {
+                        list[j] = list.back();
+                        list.pop_back();
+                        break;
+                    }
+                }
+                st.contractedNeighbors[up[v][i].to]++;
+                st.level[up[v][i].to] = max(st.level[up[v][i].to], st.level[v] + 1);
+            }
+            st.adj[v].clear();
+            st.adj[v].shrink_to_fit();
+            contracted[v] = true;
+            rank[v] = order++;
+
+            // Neighbours changed the most - refresh their keys now
+            for(size_t i = 0; i < up[v].size(); i++) {
+                int u = up[v][i].to;
+                st.priority[u] = priorityOf(st, u);
+                heapPush(queue, st.priority[u], u);
+            }
+        }
+
+        upOffsets.assign(n + 1, 0);
+        for(int v = 0; v < n; v++) {
+            upOffsets[v + 1] = upOffsets[v] + (int)up[v].size();
+        }
+        upTargets.resize(upOffsets[n]);
+        upWeights.resize(upOffsets[n]);
+        upMiddle.resize(upOffsets[n]);
+        for(int v = 0; v < n; v++) {
+            int pos = upOffsets[v];
+            for(size_t i = 0; i < up[v].size(); i++, pos++) {
+                upTargets[pos] = up[v][i].to;
+                upWeights[pos] = up[v][i].weight;
+                upMiddle[pos] = up[v][i].middle;
+            }
+        }
+    }
+
+    // Point-to-point query by bidirectional upward search
+    bool findRoute(int source, int destination, RoutePath& out) {
+        out.clear();
+        if(source < 0 || source >= numVertices || destination < 0 || destination >= numVertices) {
+            return false;
+        }
+
+        prepareSide(forward);
+        prepareSide(backward);
+        generation++;
+        if(generation == 0) {
+            fill(forward.stamp.begin(), forward.stamp.end(), 0);
+            fill(backward.stamp.begin(), backward.stamp.end(), 0);
+            generation = 1;
+        }
+
+        forward.stamp[source] = generation;
+        forward.dist[source] = 0;
+        forward.parent[source] = -1;
+        heapPush(forward.heap, 0, source);
+        backward.stamp[destination] = generation;
+        backward.dist[destination] = 0;
+        backward.parent[destination] = -1;
+        heapPush(backward.heap, 0, destination);
+
+        int best = INF;
+        int meet = -1;
+
+        while(!forward.heap.empty() || !backward.heap.empty()) {
+            bool useForward;
+            if(forward.heap.empty()) useForward = false;
+            else if(backward.heap.empty()) useForward = true;
+            else useForward = forward.heap.front().key <= backward.heap.front().key;
+
+            SearchSide& side = useForward ? forward : backward;
+            SearchSide& other = useForward ? backward : forward;
+
+            // Both frontiers are at least 'best' away - nothing can improve it
+            if(side.heap.front().key >= best) break;
+
+            HeapItem top = heapPop(side.heap);
+            int u = top.node;
+            if(top.key > side.dist[u]) continue;
+            out.settledNodes++;
+
+            if(other.stamp[u] == generation && top.key + other.dist[u] < best) {
+                best = top.key + other.dist[u];
+                meet = u;
+            }
+
+            // Stall on demand: roads are undirected, so an upward arc u-w
+            // also leads down from w. If w already offers a shorter way to
+            // u, u is not on a shortest path and its arcs need no scan.
+            bool stalled = false;
+            for(int arc = upOffsets[u]; arc < upOffsets[u + 1]; arc++) {
+                int w = upTargets[arc];
+                if(side.stamp[w] == generation && side.dist[w] + upWeights[arc] < top.key) {
+                    stalled = true;
+                    break;
+                }
+            }
+            if(stalled) continue;
+
+            for(int arc = upOffsets[u]; arc < upOffsets[u + 1]; arc++) {
+                int v = upTargets[arc];
+                int nd = top.key + upWeights[arc];
+                if(side.stamp[v] != generation || nd < side.dist[v]) {
+                    side.stamp[v] = generation;
+                    side.dist[v] = nd;
+                    side.parent[v] = u;
+                    side.parentArc[v] = arc;
+                    heapPush(side.heap, nd, v);
+                }
+            }
+        }
+
+        if(meet == -1) {
+            return false;
+        }
+
+        out.found = true;
+        out.distance = best;
+
+        // source -> meet: collect the upward chain, then unpack it in order
+        vector<int>& nodes = out.nodes;
+        int chainStart = (int)nodes.size();
+        for(int v = meet; v != source; v = forward.parent[v]) {
+            nodes.push_back(v);
+        }
+        reverse(nodes.begin() + chainStart, nodes.end());
+        vector<int> chain(nodes.begin() + chainStart, nodes.end());
+        nodes.resize(chainStart);
+        nodes.push_back(source);
+        int prev = source;
+        for(size_t i = 0; i < chain.size(); i++) {
+            int v = chain[i];
+            unpackEdge(prev, v, upMiddle[forward.parentArc[v]], nodes);
+            prev = v;
+        }
+
+        // meet -> destination: walk the backward parents downward
+        for(int v = meet; v != destination; v = backward.parent[v]) {
+            unpackEdge(v, backward.parent[v], upMiddle[backward.parentArc[v]], nodes);
+        }
+        return true;
+    }
+
+    RoutePath findRoute(int source, int destination) {
+        RoutePath path;
+        findRoute(source, destination, path);
+        return path;
+    }
+
+    // ---- Binary file format: header, rank, upward CSR arrays ----
+    bool save(const string& path) const {
+        FILE* f = fopen(path.c_str(), "wb");
+        if(f == NULL) return false;
+
+        uint32_t head[4] = {CH_MAGIC, CH_VERSION, (uint32_t)numVertices, (uint32_t)numShortcuts};
+        bool ok = fwrite(head, sizeof(head), 1, f) == 1 &&
+                  writeArray(f, rank) && writeArray(f, upOffsets) &&
+                  writeArray(f, upTargets) && writeArray(f, upWeights) && writeArray(f, upMiddle);
+        return fclose(f) == 0 && ok;
+    }
+
+    // Rejects (and leaves the hierarchy empty on) a file that does not pass
+    // validUpwardGraph()
+    bool load(const string& path) {
+        FILE* f = fopen(path.c_str(), "rb");
+        if(f == NULL) return false;
+
+        uint32_t head[4];
+        bool ok = fread(head, sizeof(head), 1, f) == 1 && head[0] == CH_MAGIC && head[1] == CH_VERSION;
+        if(ok) {
+            uint64_t n = head[2];
+            // Arc arrays are bounded by the last offset, so a bad length
+            // fails here instead of asking for a huge allocation
+            ok = n < (uint64_t)INT32_MAX && readArray(f, rank, n) && readArray(f, upOffsets, n + 1) &&
+                 rank.size() == n && upOffsets.size() == n + 1 && upOffsets[n] >= 0;
+            uint64_t arcs = ok ? (uint64_t)upOffsets[n] : 0;
+            ok = ok && readArray(f, upTargets, arcs) && readArray(f, upWeights, arcs) && readArray(f, upMiddle, arcs) &&
+                 upTargets.size() == arcs && upWeights.size() == arcs && upMiddle.size() == arcs;
+            if(ok) {
+                numVertices = (int)n;
+                numShortcuts = (int)head[3];
+                ok = validUpwardGraph();
+            }
+        }
+        fclose(f);
+
+        if(!ok) {
+            numVertices = 0;
+            numShortcuts = 0;
+            rank.clear();
+            upOffsets.assign(1, 0);
+            upTargets.clear();
+            upWeights.clear();
+            upMiddle.clear();
+        }
+        resetWorkspaces();
+        return ok;
+    }
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+
+    int getNumShortcuts() const {
+        return numShortcuts;
+    }
+
+    int getNumUpwardArcs() const {
+        return (int)upTargets.size();
+    }
+
+    // Read-only access to the upward graph (for many-to-many searches)
+    int upwardBegin(int v) const {
+        return upOffsets[v];
+    }
+
+    int upwardEnd(int v) const {
+        return upOffsets[v + 1];
+    }
+
+    int upwardTarget(int arc) const {
+        return upTargets[arc];
+    }
+
+    int upwardWeight(int arc) const {
+        return upWeights[arc];
+    }
+
+    void displayStats() {
+        cout << "\n=== Contraction Hierarchy Statistics ===" << endl;
+        cout << "Vertices: " << numVertices << endl;
+        cout << "Shortcuts Added: " << numShortcuts << endl;
+        cout << "Upward Arcs: " << upTargets.size() << endl;
+        cout << "=======================================\n" << endl;
+    }
+};
+
+#endif
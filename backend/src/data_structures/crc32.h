@@ -0,0 +1,33 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+// CRC-32 (IEEE 802.3, as in zlib/PNG) for on-disk record checksums.
+// Pass the previous result as 'crc' to checksum data in pieces.
+inline uint32_t crc32(const void* data, size_t length, uint32_t crc = 0) {
+    struct Table {
+        uint32_t entries[256];
+        Table() {
+            for(uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for(int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                entries[i] = c;
+            }
+        }
+    };
+    static const Table table;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for(size_t i = 0; i < length; i++) {
+        crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+#endif
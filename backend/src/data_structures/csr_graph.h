@@ -0,0 +1,303 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+using namespace std;
+
+#ifndef INF
+#define INF INT_MAX
+#endif
+
+// Directed arc used while building a CSR graph
+struct Arc {
+    int from;
+    int to;
+    int weight;
+};
+
+// Result of a point-to-point route query
+struct RoutePath {
+    bool found;
+    int distance;
+    vector<int> nodes;      // source ... destination
+    int settledNodes;       // Vertices taken off the queue (search effort)
+
+    RoutePath() {
+        clear();
+    }
+
+    void clear() {
+        found = false;
+        distance = INF;
+        nodes.clear();
+        settledNodes = 0;
+    }
+};
+
+// Compressed sparse row road graph: the arcs leaving vertex u are
+// targets/weights[offsets[u] .. offsets[u+1]). Immutable once built, so a
+// single instance can be shared by any number of searches.
+class CSRGraph {
+private:
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+    vector<double> latitudes;   // NAN where a location has no coordinates
+    vector<double> longitudes;
+    int numVertices;
+
+public:
+    CSRGraph() {
+        numVertices = 0;
+        offsets.assign(1, 0);
+    }
+
+    // Counting-sort the arcs by source vertex
+    void build(int n, const vector<Arc>& arcs) {
+        numVertices = n;
+        offsets.assign(n + 1, 0);
+        for(size_t i = 0; i < arcs.size(); i++) {
+            offsets[arcs[i].from + 1]++;
+        }
+        for(int u = 0; u < n; u++) {
+            offsets[u + 1] += offsets[u];
+        }
+
+        targets.resize(arcs.size());
+        weights.resize(arcs.size());
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for(size_t i = 0; i < arcs.size(); i++) {
+            int pos = cursor[arcs[i].from]++;
+            targets[pos] = arcs[i].to;
+            weights[pos] = arcs[i].weight;
+        }
+        latitudes.assign(n, NAN);
+        longitudes.assign(n, NAN);
+    }
+
+    void setCoordinates(int v, double lat, double lon) {
+        latitudes[v] = lat;
+        longitudes[v] = lon;
+    }
+
+    bool hasCoordinates(int v) const {
+        return !std::isnan(latitudes[v]) && !std::isnan(longitudes[v]);
+    }
+
+    double latitude(int v) const {
+        return latitudes[v];
+    }
+
+    double longitude(int v) const {
+        return longitudes[v];
+    }
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+
+    int getNumArcs() const {
+        return (int)targets.size();
+    }
+
+    int arcBegin(int u) const {
+        return offsets[u];
+    }
+
+    int arcEnd(int u) const {
+        return offsets[u + 1];
+    }
+
+    int arcTarget(int a) const {
+        return targets[a];
+    }
+
+    int arcWeight(int a) const {
+        return weights[a];
+    }
+
+    // Cheapest direct arc u -> v, or INF
+    int edgeWeight(int u, int v) const {
+        int best = INF;
+        for(int a = offsets[u]; a < offsets[u + 1]; a++) {
+            if(targets[a] == v && weights[a] < best) {
+                best = weights[a];
+            }
+        }
+        return best;
+    }
+};
+
+// Reusable Dijkstra workspace over a CSRGraph.
+// dist/parent are only valid where stamp[v] == generation, so starting a new
+// query is O(1) instead of clearing V entries, and the heap keeps its
+// capacity between queries: after warm-up a query allocates nothing (beyond
+// growing the caller's RoutePath the first time).
+class DijkstraSearch {
+private:
+    struct HeapItem {
+        int dist;
+        int node;
+        bool operator>(const HeapItem& other) const {
+            return dist > other.dist;
+        }
+    };
+
+    const CSRGraph* graph;
+    vector<int> dist;
+    vector<int> parent;
+    vector<uint32_t> stamp;
+    vector<uint32_t> targetStamp;   // Marks one-to-many targets of this query
+    uint32_t generation;
+    vector<HeapItem> heap;      // Binary min-heap with lazy deletion
+
+    void beginQuery() {
+        int n = graph->getNumVertices();
+        if((int)stamp.size() != n) {
+            dist.assign(n, INF);
+            parent.assign(n, -1);
+            stamp.assign(n, 0);
+            targetStamp.assign(n, 0);
+            generation = 0;
+        }
+        generation++;
+        if(generation == 0) {
+            // Stamp counter wrapped - one full reset every 2^32 queries
+            fill(stamp.begin(), stamp.end(), 0);
+            fill(targetStamp.begin(), targetStamp.end(), 0);
+            generation = 1;
+        }
+        heap.clear();
+    }
+
+    void push(int node, int d) {
+        heap.push_back(HeapItem{d, node});
+        push_heap(heap.begin(), heap.end(), greater<HeapItem>());
+    }
+
+    HeapItem pop() {
+        pop_heap(heap.begin(), heap.end(), greater<HeapItem>());
+        HeapItem top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+public:
+    DijkstraSearch(const CSRGraph& g) {
+        graph = &g;
+        generation = 0;
+    }
+
+    // Re-target the workspace (e.g. after the graph was rebuilt)
+    void setGraph(const CSRGraph& g) {
+        graph = &g;
+    }
+
+    // Shortest path source -> destination. Stops as soon as the destination
+    // is settled. Returns out.found.
+    bool findRoute(int source, int destination, RoutePath& out) {
+        out.clear();
+        int n = graph->getNumVertices();
+        if(source < 0 || source >= n || destination < 0 || destination >= n) {
+            return false;
+        }
+
+        beginQuery();
+        stamp[source] = generation;
+        dist[source] = 0;
+        parent[source] = -1;
+        push(source, 0);
+
+        while(!heap.empty()) {
+            HeapItem top = pop();
+            int u = top.node;
+            if(top.dist > dist[u]) continue;    // Stale entry
+
+            out.settledNodes++;
+            if(u == destination) break;
+
+            for(int a = graph->arcBegin(u); a < graph->arcEnd(u); a++) {
+                int v = graph->arcTarget(a);
+                int nd = top.dist + graph->arcWeight(a);
+                if(stamp[v] != generation) {
+                    stamp[v] = generation;
+                    dist[v] = nd;
+                    parent[v] = u;
+                    push(v, nd);
+                } else if(nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    push(v, nd);
+                }
+            }
+        }
+
+        if(stamp[destination] != generation) {
+            return false;
+        }
+
+        out.found = true;
+        out.distance = dist[destination];
+        for(int v = destination; v != -1; v = parent[v]) {
+            out.nodes.push_back(v);
+        }
+        reverse(out.nodes.begin(), out.nodes.end());
+        return true;
+    }
+
+    // One-to-many: out[i] = distance source -> targets[i] (INF if
+    // unreachable). The search stops once every target has been settled.
+    // Returns the number of settled vertices.
+    int distancesTo(int source, const vector<int>& targets, int* out) {
+        int n = graph->getNumVertices();
+        for(size_t i = 0; i < targets.size(); i++) out[i] = INF;
+        if(source < 0 || source >= n) return 0;
+
+        beginQuery();
+        int pending = 0;
+        for(size_t i = 0; i < targets.size(); i++) {
+            int t = targets[i];
+            if(t >= 0 && t < n && targetStamp[t] != generation) {
+                targetStamp[t] = generation;
+                pending++;
+            }
+        }
+
+        stamp[source] = generation;
+        dist[source] = 0;
+        push(source, 0);
+        int settled = 0;
+
+        while(!heap.empty() && pending > 0) {
+            HeapItem top = pop();
+            int u = top.node;
+            if(top.dist > dist[u]) continue;
+            settled++;
+            if(targetStamp[u] == generation) pending--;
+
+            for(int a = graph->arcBegin(u); a < graph->arcEnd(u); a++) {
+                int v = graph->arcTarget(a);
+                int nd = top.dist + graph->arcWeight(a);
+                if(stamp[v] != generation || nd < dist[v]) {
+                    stamp[v] = generation;
+                    dist[v] = nd;
+                    parent[v] = u;
+                    push(v, nd);
+                }
+            }
+        }
+
+        for(size_t i = 0; i < targets.size(); i++) {
+            int t = targets[i];
+            if(t >= 0 && t < n && stamp[t] == generation) out[i] = dist[t];
+        }
+        return settled;
+    }
+};
+
+#endif
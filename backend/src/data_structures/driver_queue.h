@@ -3,126 +3,261 @@
 
 #include <iostream>
 #include <string>
+#include <atomic>
+#include <memory>
+#include <cstddef>
 #include "driver.h"
 using namespace std;
 
-// Queue Node
-struct QueueNode {
-    Driver* driver;
-    QueueNode* next;
-    
-    QueueNode(Driver* d) {
-        driver = d;
-        next = NULL;
+#define DRIVER_QUEUE_DEFAULT_CAPACITY 1024
+#define DRIVER_QUEUE_BANDS 4            // Experience bands in priority mode
+#define DRIVER_QUEUE_BAND_YEARS 5       // 0-4, 5-9, 10-14, 15+ years
+#define CACHE_LINE_SIZE 64
+
+enum DriverQueueMode {
+    QUEUE_FIFO,             // Longest-waiting driver first
+    QUEUE_BY_EXPERIENCE     // Most experienced band first, FIFO inside a band
+};
+
+// Bounded multi-producer / multi-consumer ring of Driver pointers.
+// Each cell carries a sequence number that tells producers and consumers
+// whether it is free for the current lap, so enqueue/dequeue are one CAS on
+// a position counter plus one store - no locks and no allocation.
+class DriverRing {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        Driver* driver;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(CACHE_LINE_SIZE) atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE_SIZE) atomic<size_t> dequeuePos;
+
+public:
+    // Capacity is rounded up to a power of two
+    DriverRing(size_t capacity = DRIVER_QUEUE_DEFAULT_CAPACITY) {
+        size_t size = 2;
+        while(size < capacity) size <<= 1;
+        cells.reset(new Cell[size]);
+        for(size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+            cells[i].driver = NULL;
+        }
+        mask = size - 1;
+        enqueuePos.store(0, memory_order_relaxed);
+        dequeuePos.store(0, memory_order_relaxed);
+    }
+
+    DriverRing(const DriverRing&) = delete;
+    DriverRing& operator=(const DriverRing&) = delete;
+
+    // False when the ring is full
+    bool push(Driver* driver) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while(true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+            if(diff == 0) {
+                if(enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.driver = driver;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // NULL when the ring is empty
+    Driver* pop() {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while(true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+            if(diff == 0) {
+                if(dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    Driver* driver = cell.driver;
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return driver;
+                }
+            } else if(diff < 0) {
+                return NULL;
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Oldest driver, or NULL. Only meaningful while no consumer is running.
+    Driver* front() const {
+        size_t pos = dequeuePos.load(memory_order_acquire);
+        const Cell& cell = cells[pos & mask];
+        if(cell.sequence.load(memory_order_acquire) != pos + 1) return NULL;
+        return cell.driver;
+    }
+
+    // Driver at 'offset' from the front. Not safe during concurrent updates.
+    Driver* at(size_t offset) const {
+        return cells[(dequeuePos.load(memory_order_acquire) + offset) & mask].driver;
+    }
+
+    // Approximate while producers/consumers are running
+    size_t size() const {
+        size_t tail = enqueuePos.load(memory_order_acquire);
+        size_t head = dequeuePos.load(memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
     }
 };
 
+// Drivers waiting for a vehicle.
+// enqueue/dequeue/getSize may be called from any number of threads at once
+// (shift-change check-ins arrive from concurrent request handlers).
+// peek/displayQueue walk the rings directly and are for a quiet queue only.
 class DriverQueue {
 private:
-    QueueNode* front;
-    QueueNode* rear;
-    int size;
+    DriverQueueMode mode;
+    DriverRing* bands[DRIVER_QUEUE_BANDS];  // FIFO mode only uses bands[0]
+    int numBands;
+    bool verbose;
+
+    int bandOf(const Driver* driver) const {
+        if(mode == QUEUE_FIFO) return 0;
+        int band = driver->experience / DRIVER_QUEUE_BAND_YEARS;
+        if(band < 0) band = 0;
+        if(band >= numBands) band = numBands - 1;
+        return band;
+    }
 
 public:
-    DriverQueue() {
-        front = NULL;
-        rear = NULL;
-        size = 0;
-    }
-
-    // Enqueue - Add driver to queue (FIFO)
-    void enqueue(Driver* driver) {
-        if(driver == NULL) return;
-        
-        QueueNode* newNode = new QueueNode(driver);
-        
-        if(rear == NULL) {
-            // Queue is empty
-            front = rear = newNode;
-        } else {
-            rear->next = newNode;
-            rear = newNode;
+    // Capacity applies per band in priority mode
+    DriverQueue(size_t capacity = DRIVER_QUEUE_DEFAULT_CAPACITY, DriverQueueMode queueMode = QUEUE_FIFO) {
+        mode = queueMode;
+        numBands = (mode == QUEUE_FIFO) ? 1 : DRIVER_QUEUE_BANDS;
+        for(int b = 0; b < DRIVER_QUEUE_BANDS; b++) {
+            bands[b] = (b < numBands) ? new DriverRing(capacity) : NULL;
         }
-        size++;
-        cout << "✅ Driver " << driver->name << " added to queue" << endl;
+        verbose = true;
     }
 
-    // Dequeue - Remove and return front driver (FIFO)
-    Driver* dequeue() {
-        if(isEmpty()) {
-            cout << "❌ Queue is empty!" << endl;
-            return NULL;
+    DriverQueue(const DriverQueue&) = delete;
+    DriverQueue& operator=(const DriverQueue&) = delete;
+
+    void setVerbose(bool v) {
+        verbose = v;
+    }
+
+    DriverQueueMode getMode() const {
+        return mode;
+    }
+
+    // Enqueue - Add driver to queue; false if the queue is full
+    bool enqueue(Driver* driver) {
+        if(driver == NULL) return false;
+
+        if(!bands[bandOf(driver)]->push(driver)) {
+            if(verbose) cout << "❌ Queue is full! Driver " << driver->name << " not added" << endl;
+            return false;
         }
-        
-        QueueNode* temp = front;
-        Driver* driver = temp->driver;
-        front = front->next;
-        
-        if(front == NULL) {
-            rear = NULL;  // Queue became empty
+        if(verbose) cout << "✅ Driver " << driver->name << " added to queue" << endl;
+        return true;
+    }
+
+    // Dequeue - Remove and return the next driver (highest band first)
+    Driver* dequeue() {
+        for(int b = numBands - 1; b >= 0; b--) {
+            Driver* driver = bands[b]->pop();
+            if(driver != NULL) {
+                if(verbose) cout << "✅ Driver " << driver->name << " assigned from queue" << endl;
+                return driver;
+            }
         }
-        
-        delete temp;
-        size--;
-        
-        cout << "✅ Driver " << driver->name << " assigned from queue" << endl;
-        return driver;
+        if(verbose) cout << "❌ Queue is empty!" << endl;
+        return NULL;
     }
 
-    // Peek - View front driver without removing
+    // Peek - View next driver without removing
     Driver* peek() {
-        if(isEmpty()) {
-            return NULL;
+        for(int b = numBands - 1; b >= 0; b--) {
+            Driver* driver = bands[b]->front();
+            if(driver != NULL) return driver;
         }
-        return front->driver;
+        return NULL;
     }
 
     // Check if empty
     bool isEmpty() {
-        return front == NULL;
+        return getSize() == 0;
     }
 
     // Get size
     int getSize() {
-        return size;
+        size_t total = 0;
+        for(int b = 0; b < numBands; b++) {
+            total += bands[b]->size();
+        }
+        return (int)total;
     }
 
-    // Display all drivers in queue
+    int getCapacity() {
+        return (int)bands[0]->capacity() * numBands;
+    }
+
+    // Display all drivers in dequeue order
     void displayQueue() {
         if(isEmpty()) {
             cout << "\n📋 Driver Queue is EMPTY" << endl;
             return;
         }
-        
+
         cout << "\n========== DRIVER QUEUE ==========" << endl;
-        cout << "Total Drivers Waiting: " << size << endl;
+        cout << "Total Drivers Waiting: " << getSize() << endl;
         cout << "==================================\n" << endl;
-        
-        QueueNode* current = front;
+
         int position = 1;
-        
-        while(current != NULL) {
-            cout << "Position " << position << ":" << endl;
-            current->driver->display();
-            current = current->next;
-            position++;
+        for(int b = numBands - 1; b >= 0; b--) {
+            size_t count = bands[b]->size();
+            for(size_t i = 0; i < count; i++) {
+                cout << "Position " << position << ":" << endl;
+                bands[b]->at(i)->display();
+                position++;
+            }
         }
     }
 
     // Display statistics
     void displayStats() {
         cout << "\n=== Queue Statistics ===" << endl;
-        cout << "Total Drivers: " << size << endl;
+        cout << "Mode: " << (mode == QUEUE_FIFO ? "FIFO" : "BY EXPERIENCE") << endl;
+        cout << "Total Drivers: " << getSize() << " / " << getCapacity() << endl;
+        if(mode == QUEUE_BY_EXPERIENCE) {
+            for(int b = numBands - 1; b >= 0; b--) {
+                cout << "  " << b * DRIVER_QUEUE_BAND_YEARS << (b == numBands - 1 ? "+" : "-" + to_string((b + 1) * DRIVER_QUEUE_BAND_YEARS - 1))
+                     << " years: " << bands[b]->size() << endl;
+            }
+        }
         cout << "Queue Status: " << (isEmpty() ? "EMPTY" : "ACTIVE") << endl;
-        if(!isEmpty()) {
-            cout << "Next Driver: " << front->driver->name << endl;
+        Driver* next = peek();
+        if(next != NULL) {
+            cout << "Next Driver: " << next->name << endl;
         }
         cout << "=======================\n" << endl;
     }
 
+    // Drivers are owned by the caller; only the rings are freed
     ~DriverQueue() {
-        while(!isEmpty()) {
-            dequeue();
+        for(int b = 0; b < numBands; b++) {
+            delete bands[b];
         }
     }
 };
@@ -0,0 +1,46 @@
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+
+#include <string>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+// Helpers for the temp file, fsync, rename pattern used by the snapshot
+// writers. Write the temp file with writeFileDurably(), rename it over the
+// target, then syncDirectory() the target so the rename itself survives a
+// crash.
+
+// Replace the file's contents and fsync them before returning
+inline bool writeFileDurably(const string& path, const string& contents) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) return false;
+    const char* data = contents.data();
+    size_t left = contents.size();
+    while(left > 0) {
+        ssize_t written = ::write(fd, data, left);
+        if(written < 0) {
+            if(errno == EINTR) continue;
+            ::close(fd);
+            return false;
+        }
+        data += written;
+        left -= (size_t)written;
+    }
+    bool ok = fsync(fd) == 0;
+    return ::close(fd) == 0 && ok;
+}
+
+// fsync the directory holding 'path' so a rename inside it is durable
+inline void syncDirectory(const string& path) {
+    size_t slash = path.find_last_of('/');
+    string dir = slash == string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if(fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef FLEET_STORE_H
+#define FLEET_STORE_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "vehicle.h"
+#include "string_interner.h"
+using namespace std;
+
+#define FLEET_NO_ROW 0xFFFFFFFFu
+
+// Columnar (struct-of-arrays) copy of the fleet for fleet-wide scans.
+// Row r of every column describes the same vehicle. Hot fields are stored
+// as packed arrays - enum codes in one byte, kilometers and service days
+// side by side - so "all AVAILABLE trucks" or "everything due for service"
+// is a tight loop over a few contiguous arrays instead of chasing Vehicle
+// pointers. IDs, registrations, models and driver IDs are interned into
+// 32-bit handles. Removing a vehicle moves the last row into its place, so
+// row numbers are only stable until the next removeVehicle().
+class FleetStore {
+private:
+    StringInterner strings;
+
+    // Columns
+    vector<uint32_t> idHandle;
+    vector<uint32_t> registrationHandle;
+    vector<uint32_t> modelHandle;
+    vector<uint32_t> driverHandle;      // INTERN_NONE = unassigned
+    vector<double> kilometers;
+    vector<int32_t> serviceDays;
+    vector<int16_t> years;
+    vector<uint8_t> statuses;           // VehicleStatus
+    vector<uint8_t> types;              // VehicleType
+
+    vector<uint32_t> rowOfHandle;       // Interned vehicle ID -> row
+
+    void setRowOf(uint32_t handle, uint32_t row) {
+        if(handle >= rowOfHandle.size()) rowOfHandle.resize(strings.size(), FLEET_NO_ROW);
+        rowOfHandle[handle] = row;
+    }
+
+public:
+    FleetStore() {
+    }
+
+    void reserve(size_t count) {
+        idHandle.reserve(count);
+        registrationHandle.reserve(count);
+        modelHandle.reserve(count);
+        driverHandle.reserve(count);
+        kilometers.reserve(count);
+        serviceDays.reserve(count);
+        years.reserve(count);
+        statuses.reserve(count);
+        types.reserve(count);
+    }
+
+    // Returns the new row, or FLEET_NO_ROW if the ID is already stored
+    uint32_t addVehicle(const Vehicle& v) {
+        if(findRow(v.vehicleId) != FLEET_NO_ROW) return FLEET_NO_ROW;
+
+        uint32_t row = (uint32_t)idHandle.size();
+        uint32_t handle = strings.intern(v.vehicleId);
+        idHandle.push_back(handle);
+        registrationHandle.push_back(strings.intern(v.registrationNumber));
+        modelHandle.push_back(strings.intern(v.model));
+        driverHandle.push_back(v.assignedDriverId.empty() ? INTERN_NONE : strings.intern(v.assignedDriverId));
+        kilometers.push_back(v.kilometersRun);
+        serviceDays.push_back(v.daysSinceLastService);
+        years.push_back((int16_t)v.year);
+        statuses.push_back(v.status);
+        types.push_back(v.type);
+        setRowOf(handle, row);
+        return row;
+    }
+
+    bool removeVehicle(string_view vehicleId) {
+        uint32_t row = findRow(vehicleId);
+        if(row == FLEET_NO_ROW) return false;
+
+        uint32_t last = (uint32_t)idHandle.size() - 1;
+        rowOfHandle[idHandle[row]] = FLEET_NO_ROW;
+        if(row != last) {
+            idHandle[row] = idHandle[last];
+            registrationHandle[row] = registrationHandle[last];
+            modelHandle[row] = modelHandle[last];
+            driverHandle[row] = driverHandle[last];
+            kilometers[row] = kilometers[last];
+            serviceDays[row] = serviceDays[last];
+            years[row] = years[last];
+            statuses[row] = statuses[last];
+            types[row] = types[last];
+            rowOfHandle[idHandle[row]] = row;
+        }
+        idHandle.pop_back();
+        registrationHandle.pop_back();
+        modelHandle.pop_back();
+        driverHandle.pop_back();
+        kilometers.pop_back();
+        serviceDays.pop_back();
+        years.pop_back();
+        statuses.pop_back();
+        types.pop_back();
+        return true;
+    }
+
+    // Row of a vehicle, or FLEET_NO_ROW
+    uint32_t findRow(string_view vehicleId) const {
+        uint32_t handle = strings.find(vehicleId);
+        if(handle == INTERN_NONE || handle >= rowOfHandle.size()) return FLEET_NO_ROW;
+        return rowOfHandle[handle];
+    }
+
+    // Field updates by row
+    void setStatus(uint32_t row, VehicleStatus status) {
+        statuses[row] = status;
+    }
+
+    void setOdometer(uint32_t row, double km, int daysSinceService) {
+        kilometers[row] = km;
+        serviceDays[row] = daysSinceService;
+    }
+
+    void assignDriver(uint32_t row, string_view driverId) {
+        driverHandle[row] = driverId.empty() ? INTERN_NONE : strings.intern(driverId);
+    }
+
+    // Field access by row
+    size_t size() const {
+        return idHandle.size();
+    }
+
+    string_view vehicleId(uint32_t row) const {
+        return strings.str(idHandle[row]);
+    }
+
+    string_view driverId(uint32_t row) const {
+        return strings.str(driverHandle[row]);
+    }
+
+    VehicleStatus status(uint32_t row) const {
+        return (VehicleStatus)statuses[row];
+    }
+
+    VehicleType type(uint32_t row) const {
+        return (VehicleType)types[row];
+    }
+
+    double kilometersRun(uint32_t row) const {
+        return kilometers[row];
+    }
+
+    int daysSinceService(uint32_t row) const {
+        return serviceDays[row];
+    }
+
+    int year(uint32_t row) const {
+        return years[row];
+    }
+
+    // Whole columns, for scan kernels
+    const double* kilometersColumn() const {
+        return kilometers.data();
+    }
+
+    const int32_t* serviceDaysColumn() const {
+        return serviceDays.data();
+    }
+
+    const int16_t* yearsColumn() const {
+        return years.data();
+    }
+
+    const uint8_t* statusColumn() const {
+        return statuses.data();
+    }
+
+    const uint8_t* typeColumn() const {
+        return types.data();
+    }
+
+    // Rebuild a full Vehicle object for one row
+    Vehicle toVehicle(uint32_t row) const {
+        Vehicle v;
+        v.vehicleId = string(strings.str(idHandle[row]));
+        v.registrationNumber = string(strings.str(registrationHandle[row]));
+        v.model = string(strings.str(modelHandle[row]));
+        v.type = type(row);
+        v.year = years[row];
+        v.kilometersRun = kilometers[row];
+        v.daysSinceLastService = serviceDays[row];
+        v.status = status(row);
+        v.assignedDriverId = string(driverId(row));
+        return v;
+    }
+
+    // Rows with the given status and type, appended to 'rows'
+    size_t selectByStatusAndType(VehicleStatus status, VehicleType type, vector<uint32_t>& rows) const {
+        size_t before = rows.size();
+        size_t n = statuses.size();
+        const uint8_t* s = statuses.data();
+        const uint8_t* t = types.data();
+        for(size_t r = 0; r < n; r++) {
+            if(s[r] == status && t[r] == type) rows.push_back((uint32_t)r);
+        }
+        return rows.size() - before;
+    }
+
+    size_t countByStatus(VehicleStatus status) const {
+        size_t count = 0;
+        size_t n = statuses.size();
+        const uint8_t* s = statuses.data();
+        for(size_t r = 0; r < n; r++) {
+            count += (s[r] == status);
+        }
+        return count;
+    }
+
+    // Same rule (and MAINTENANCE_* thresholds) as Vehicle::needsMaintenance()
+    size_t selectNeedsMaintenance(vector<uint32_t>& rows) const {
+        size_t before = rows.size();
+        size_t n = kilometers.size();
+        for(size_t r = 0; r < n; r++) {
+            if(kilometers[r] > MAINTENANCE_URGENT_KM || serviceDays[r] > MAINTENANCE_URGENT_DAYS) rows.push_back((uint32_t)r);
+        }
+        return rows.size() - before;
+    }
+
+    size_t memoryBytes() const {
+        size_t perRow = 4 * sizeof(uint32_t) + sizeof(double) + sizeof(int32_t) + sizeof(int16_t) + 2;
+        return idHandle.capacity() * perRow + rowOfHandle.capacity() * sizeof(uint32_t) + strings.memoryBytes();
+    }
+
+    void displayStats() const {
+        cout << "\n=== Fleet Store Statistics ===" << endl;
+        cout << "Vehicles: " << size() << endl;
+        cout << "Interned strings: " << strings.size() << endl;
+        for(int s = 0; s < VEHICLE_STATUS_COUNT; s++) {
+            cout << "  " << vehicleStatusName((VehicleStatus)s) << ": " << countByStatus((VehicleStatus)s) << endl;
+        }
+        cout << "Memory: " << memoryBytes() / 1024 << " KB";
+        if(size() > 0) cout << " (" << memoryBytes() / size() << " bytes/vehicle)";
+        cout << endl;
+        cout << "==============================\n" << endl;
+    }
+};
+
+#endif
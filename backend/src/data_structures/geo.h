@@ -0,0 +1,21 @@
+#ifndef GEO_H
+#define GEO_H
+
+#include <cmath>
+using namespace std;
+
+#define EARTH_RADIUS_KM 6371.0
+#define DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+#define KM_PER_DEGREE (EARTH_RADIUS_KM * DEGREES_TO_RADIANS)     // Of latitude, or of longitude at the equator
+
+// Great-circle distance in km between two lat/lon points (degrees)
+inline double haversineKm(double lat1, double lon1, double lat2, double lon2) {
+    const double toRad = DEGREES_TO_RADIANS;
+    double dLat = (lat2 - lat1) * toRad;
+    double dLon = (lon2 - lon1) * toRad;
+    double a = sin(dLat / 2) * sin(dLat / 2) +
+               cos(lat1 * toRad) * cos(lat2 * toRad) * sin(dLon / 2) * sin(dLon / 2);
+    return 2.0 * EARTH_RADIUS_KM * asin(sqrt(a < 1.0 ? a : 1.0));
+}
+
+#endif
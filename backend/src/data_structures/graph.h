@@ -3,12 +3,18 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <climits>
+#include <cmath>
+#include <memory>
 using namespace std;
 
-#define MAX_VERTICES 20
 #define INF INT_MAX
 
+#include "csr_graph.h"
+#include "astar_search.h"
+#include "node_pool.h"
+
 // Edge structure
 struct Edge {
     int destination;
@@ -26,171 +32,173 @@ struct Edge {
 struct Location {
     string name;
     int id;
-    
+    double lat;     // Degrees, NAN if unknown
+    double lon;
+
     Location() {
         name = "";
         id = -1;
+        lat = NAN;
+        lon = NAN;
     }
-    
-    Location(string n, int i) {
+
+    Location(string n, int i, double la = NAN, double lo = NAN) {
         name = n;
         id = i;
+        lat = la;
+        lon = lo;
     }
 };
 
+// Road network. addLocation/addRoad build an adjacency list; route queries
+// run on a CSR snapshot of it that is rebuilt lazily after the map changes.
 class Graph {
 private:
-    Edge* adjacencyList[MAX_VERTICES];
-    Location locations[MAX_VERTICES];
+    vector<Edge*> adjacencyList;
+    NodePool<Edge> edgePool;
+    vector<Location> locations;
     int numVertices;
+    int numRoads;
+    bool verbose;
+
+    CSRGraph csr;
+    bool csrDirty;
+    DijkstraSearch search;
+    AStarSearch astar;
 
 public:
-    Graph() {
+    Graph() : search(csr), astar(csr) {
         numVertices = 0;
-        for(int i = 0; i < MAX_VERTICES; i++) {
-            adjacencyList[i] = NULL;
-        }
+        numRoads = 0;
+        verbose = true;
+        csrDirty = true;
     }
 
-    // Add location (vertex)
-    void addLocation(string name) {
-        if(numVertices >= MAX_VERTICES) {
-            cout << "❌ Maximum locations reached!" << endl;
-            return;
-        }
-        
-        locations[numVertices] = Location(name, numVertices);
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    // Turn off per-operation console output (bulk map loads)
+    void setVerbose(bool v) {
+        verbose = v;
+    }
+
+    // Add location (vertex). Coordinates are optional; with them, A*
+    // queries can steer toward the destination.
+    void addLocation(string name, double lat = NAN, double lon = NAN) {
+        locations.push_back(Location(name, numVertices, lat, lon));
+        adjacencyList.push_back(NULL);
         numVertices++;
-        cout << "✅ Location added: " << name << " (ID: " << (numVertices-1) << ")" << endl;
+        csrDirty = true;
+        if(verbose) cout << "✅ Location added: " << name << " (ID: " << (numVertices-1) << ")" << endl;
     }
 
     // Add road (edge) - undirected graph
     void addRoad(int source, int destination, int distance) {
-        if(source >= numVertices || destination >= numVertices) {
-            cout << "❌ Invalid location!" << endl;
+        if(source < 0 || destination < 0 || source >= numVertices || destination >= numVertices) {
+            if(verbose) cout << "❌ Invalid location!" << endl;
             return;
         }
 
         // Add edge from source to destination
-        Edge* newEdge1 = new Edge(destination, distance);
+        Edge* newEdge1 = edgePool.create(destination, distance);
         newEdge1->next = adjacencyList[source];
         adjacencyList[source] = newEdge1;
 
         // Add edge from destination to source (undirected)
-        Edge* newEdge2 = new Edge(source, distance);
+        Edge* newEdge2 = edgePool.create(source, distance);
         newEdge2->next = adjacencyList[destination];
         adjacencyList[destination] = newEdge2;
 
-        cout << "✅ Road added: " << locations[source].name << " <-> " 
-             << locations[destination].name << " (" << distance << " km)" << endl;
+        numRoads++;
+        csrDirty = true;
+        if(verbose) {
+            cout << "✅ Road added: " << locations[source].name << " <-> "
+                 << locations[destination].name << " (" << distance << " km)" << endl;
+        }
     }
 
-    // Find minimum distance vertex (for Dijkstra)
-    int findMinDistance(int dist[], bool visited[]) {
-        int minDist = INF;
-        int minIndex = -1;
-
-        for(int i = 0; i < numVertices; i++) {
-            if(!visited[i] && dist[i] < minDist) {
-                minDist = dist[i];
-                minIndex = i;
+    // Flatten the adjacency lists into the CSR snapshot used for routing
+    const CSRGraph& getCSR() {
+        if(csrDirty) {
+            vector<Arc> arcs;
+            arcs.reserve(2 * numRoads);
+            for(int u = 0; u < numVertices; u++) {
+                for(Edge* e = adjacencyList[u]; e != NULL; e = e->next) {
+                    arcs.push_back(Arc{u, e->destination, e->weight});
+                }
+            }
+            csr.build(numVertices, arcs);
+            for(int v = 0; v < numVertices; v++) {
+                csr.setCoordinates(v, locations[v].lat, locations[v].lon);
             }
+            astar.resetLandmarks();
+            csrDirty = false;
         }
+        return csr;
+    }
+
+    // Immutable copy of the current road network. Safe to share between
+    // threads and unaffected by later addLocation/addRoad calls.
+    shared_ptr<const CSRGraph> snapshot() {
+        return make_shared<const CSRGraph>(getCSR());
+    }
+
+    // Shortest route as a path object - O((V + E) log V), no console output
+    bool findRoute(int source, int destination, RoutePath& out) {
+        getCSR();
+        return search.findRoute(source, destination, out);
+    }
+
+    // Goal-directed route query (haversine + optional ALT landmarks).
+    // Same result as findRoute, but explores far fewer locations.
+    bool findRouteAStar(int source, int destination, RoutePath& out) {
+        getCSR();
+        return astar.findRoute(source, destination, out);
+    }
+
+    // Precompute ALT landmark distances for findRouteAStar
+    void prepareLandmarks(int count) {
+        getCSR();
+        astar.prepareLandmarks(count);
+    }
 
-        return minIndex;
+    RoutePath findRoute(int source, int destination) {
+        RoutePath path;
+        findRoute(source, destination, path);
+        return path;
     }
 
-    // Dijkstra's Algorithm - Find shortest path
+    // Dijkstra's Algorithm - Find and print shortest path
     void dijkstra(int source, int destination) {
-        if(source >= numVertices || destination >= numVertices) {
+        if(source < 0 || destination < 0 || source >= numVertices || destination >= numVertices) {
             cout << "❌ Invalid locations!" << endl;
             return;
         }
 
-        int dist[MAX_VERTICES];
-        bool visited[MAX_VERTICES];
-        int parent[MAX_VERTICES];
-
-        // Initialize
-        for(int i = 0; i < numVertices; i++) {
-            dist[i] = INF;
-            visited[i] = false;
-            parent[i] = -1;
-        }
-
-        dist[source] = 0;
-
         cout << "\n🚗 Calculating shortest route..." << endl;
         cout << "From: " << locations[source].name << endl;
         cout << "To: " << locations[destination].name << endl;
-        cout << "\n--- DIJKSTRA'S ALGORITHM EXECUTION ---" << endl;
 
-        // Process all vertices
-        for(int count = 0; count < numVertices - 1; count++) {
-            int u = findMinDistance(dist, visited);
-            
-            if(u == -1) break;
-            
-            visited[u] = true;
-            cout << "Processing: " << locations[u].name << " (Distance: " << dist[u] << " km)" << endl;
-
-            // Update distances of adjacent vertices
-            Edge* current = adjacencyList[u];
-            while(current != NULL) {
-                int v = current->destination;
-                int weight = current->weight;
-
-                if(!visited[v] && dist[u] != INF && dist[u] + weight < dist[v]) {
-                    dist[v] = dist[u] + weight;
-                    parent[v] = u;
-                    cout << "  → Updated " << locations[v].name << " distance to " << dist[v] << " km" << endl;
-                }
-
-                current = current->next;
-            }
-        }
+        RoutePath path;
+        findRoute(source, destination, path);
 
         // Display result
         cout << "\n========== ROUTE RESULT ==========" << endl;
-        
-        if(dist[destination] == INF) {
+
+        if(!path.found) {
             cout << "❌ No route exists!" << endl;
             cout << "==================================\n" << endl;
             return;
         }
 
-        cout << "✅ Shortest Distance: " << dist[destination] << " km" << endl;
-        
-        // Reconstruct path
-        cout << "\n📍 Route Path:" << endl;
-        int path[MAX_VERTICES];
-        int pathLength = 0;
-        
-        int current = destination;
-        while(current != -1) {
-            path[pathLength++] = current;
-            current = parent[current];
-        }
+        cout << "✅ Shortest Distance: " << path.distance << " km" << endl;
+        cout << "Locations Explored: " << path.settledNodes << endl;
 
-        // Print path in correct order
-        for(int i = pathLength - 1; i >= 0; i--) {
-            cout << locations[path[i]].name;
-            if(i > 0) {
-                // Find distance between consecutive nodes
-                int from = path[i];
-                int to = path[i-1];
-                int distance = 0;
-                
-                Edge* edge = adjacencyList[from];
-                while(edge != NULL) {
-                    if(edge->destination == to) {
-                        distance = edge->weight;
-                        break;
-                    }
-                    edge = edge->next;
-                }
-                
-                cout << " --(" << distance << " km)--> ";
+        cout << "\n📍 Route Path:" << endl;
+        for(size_t i = 0; i < path.nodes.size(); i++) {
+            cout << locations[path.nodes[i]].name;
+            if(i + 1 < path.nodes.size()) {
+                cout << " --(" << csr.edgeWeight(path.nodes[i], path.nodes[i + 1]) << " km)--> ";
             }
         }
         cout << "\n\n==================================\n" << endl;
@@ -232,15 +240,8 @@ public:
         return numVertices;
     }
 
+    // Edges are released in bulk by edgePool
     ~Graph() {
-        for(int i = 0; i < numVertices; i++) {
-            Edge* current = adjacencyList[i];
-            while(current != NULL) {
-                Edge* temp = current;
-                current = current->next;
-                delete temp;
-            }
-        }
     }
 };
 
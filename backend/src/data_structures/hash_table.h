@@ -3,114 +3,393 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <string_view>
+#include <functional>
+#include <cstdint>
 #include "vehicle.h"
+#include "string_hash.h"
 using namespace std;
 
-#define TABLE_SIZE 100
+#define HASH_INITIAL_CAPACITY 64
+#define HASH_MAX_LOAD_FACTOR 0.875
+#define HASH_MAX_PROBE 255
 
-// Node for chaining (handling collisions)
-struct HashNode {
-    string key;           // Vehicle ID
-    Vehicle* vehicle;     // Pointer to vehicle
-    HashNode* next;       // For chaining
-    
-    HashNode(string k, Vehicle* v) {
-        key = k;
-        vehicle = v;
-        next = NULL;
-    }
+enum VehicleChange : uint8_t {
+    VEHICLE_ADDED,
+    VEHICLE_REMOVED,            // Sent before the vehicle is deleted
+    VEHICLE_STATUS_CHANGED,
+    VEHICLE_DRIVER_CHANGED
+};
+
+// One table mutation. 'vehicle' already holds the new state; the previous
+// status / driver are only meaningful for the matching change.
+struct VehicleEvent {
+    VehicleChange change;
+    const Vehicle* vehicle;
+    VehicleStatus previousStatus;
+    string_view previousDriverId;
 };
 
+// Called synchronously from the mutating call, so it must be cheap and
+// must not modify the table.
+typedef function<void(const VehicleEvent& event)> VehicleObserver;
+
+// Slot payload. The full hash is cached so most probes never touch the
+// vehicle's ID string.
+struct HashSlot {
+    uint64_t hash;
+    Vehicle* vehicle;   // Key is vehicle->vehicleId
+    uint32_t row;       // Stable index row (slots move, rows don't)
+};
+
+// Open-addressing vehicle table with Robin Hood probing.
+// probes[i] is a one-byte metadata array: 0 = empty, otherwise the slot's
+// distance from its home bucket + 1. Lookups scan this byte array and stop as
+// soon as the stored distance is shorter than ours, so a miss is as cheap as
+// a hit. The table doubles once it passes HASH_MAX_LOAD_FACTOR.
+//
+// Secondary indexes: every vehicle gets a stable row number (reused after
+// deletes) and one bit in a bitmap per status and per type, plus an entry
+// in a driver -> row map. They are kept in step by insert, deleteVehicle,
+// updateStatus and assignDriver, so status and driver changes must go
+// through those calls rather than the Vehicle fields. query()/count() AND
+// the OR of the requested status bitmaps with the OR of the type bitmaps,
+// 64 vehicles per word, instead of walking buckets and comparing strings.
+//
+// Observers added with addObserver() see the same mutations, which lets
+// derived state (dashboard counters, caches) follow the table without
+// rescanning it.
 class HashTable {
 private:
-    HashNode* table[TABLE_SIZE];
+    vector<uint8_t> probes;
+    vector<HashSlot> slots;
+    size_t mask;
     int totalVehicles;
+    bool verbose;
+
+    vector<Vehicle*> rowVehicles;           // NULL for free rows
+    vector<uint32_t> freeRows;
+    vector<uint64_t> statusBits[VEHICLE_STATUS_COUNT];
+    vector<uint64_t> typeBits[VEHICLE_TYPE_COUNT];
+    unordered_map<string, uint32_t> driverRows;
+    vector<VehicleObserver> observers;
+
+    static size_t roundUpPow2(size_t n) {
+        size_t cap = HASH_INITIAL_CAPACITY;
+        while(cap < n) cap <<= 1;
+        return cap;
+    }
+
+    void allocate(size_t capacity) {
+        probes.assign(capacity, 0);
+        slots.assign(capacity, HashSlot{0, NULL, 0});
+        mask = capacity - 1;
+    }
+
+    // Robin Hood placement. Returns false if an entry would exceed
+    // HASH_MAX_PROBE; 'entry' then holds whichever element is still homeless.
+    bool place(HashSlot& entry) {
+        size_t index = entry.hash & mask;
+        uint8_t dist = 1;
+
+        while(true) {
+            if(probes[index] == 0) {
+                probes[index] = dist;
+                slots[index] = entry;
+                return true;
+            }
+            if(probes[index] < dist) {
+                // Steal from the rich: the resident is closer to home than we are
+                uint8_t d = probes[index];
+                probes[index] = dist;
+                dist = d;
+                HashSlot tmp = slots[index];
+                slots[index] = entry;
+                entry = tmp;
+            }
+            index = (index + 1) & mask;
+            if(dist == HASH_MAX_PROBE - 1) return false;
+            dist++;
+        }
+    }
+
+    void rehash(size_t newCapacity) {
+        vector<uint8_t> oldProbes;
+        vector<HashSlot> oldSlots;
+        oldProbes.swap(probes);
+        oldSlots.swap(slots);
+        allocate(newCapacity);
+
+        for(size_t i = 0; i < oldSlots.size(); i++) {
+            if(oldProbes[i] == 0) continue;
+            HashSlot entry = oldSlots[i];
+            while(!place(entry)) {
+                rehash(slots.size() * 2);
+            }
+        }
+    }
+
+    void insertEntry(HashSlot entry) {
+        if((double)(totalVehicles + 1) > HASH_MAX_LOAD_FACTOR * slots.size()) {
+            rehash(slots.size() * 2);
+        }
+        while(!place(entry)) {
+            rehash(slots.size() * 2);
+        }
+        totalVehicles++;
+    }
+
+    // Returns slot index of vehicleId, or -1
+    long findIndex(const string& vehicleId, uint64_t hash) const {
+        size_t index = hash & mask;
+        uint8_t dist = 1;
+
+        while(probes[index] >= dist) {
+            if(slots[index].hash == hash && slots[index].vehicle->vehicleId == vehicleId) {
+                return (long)index;
+            }
+            index = (index + 1) & mask;
+            dist++;
+        }
+        return -1;
+    }
+
+    // Backward-shift deletion: pull following displaced entries one step
+    // closer to home so no tombstones are needed.
+    void eraseAt(size_t index) {
+        size_t next = (index + 1) & mask;
+        while(probes[next] > 1) {
+            probes[index] = probes[next] - 1;
+            slots[index] = slots[next];
+            index = next;
+            next = (next + 1) & mask;
+        }
+        probes[index] = 0;
+        slots[index] = HashSlot{0, NULL, 0};
+        totalVehicles--;
+    }
+
+    static void setBit(vector<uint64_t>& bits, uint32_t row) {
+        bits[row >> 6] |= 1ULL << (row & 63);
+    }
+
+    static void clearBit(vector<uint64_t>& bits, uint32_t row) {
+        bits[row >> 6] &= ~(1ULL << (row & 63));
+    }
 
-    // Hash function - converts string key to index
-    int hashFunction(string key) {
-        int hash = 0;
-        for(int i = 0; i < key.length(); i++) {
-            hash += key[i];
+    uint32_t takeRow(Vehicle* v) {
+        uint32_t row;
+        if(!freeRows.empty()) {
+            row = freeRows.back();
+            freeRows.pop_back();
+            rowVehicles[row] = v;
+        } else {
+            row = (uint32_t)rowVehicles.size();
+            rowVehicles.push_back(v);
+            size_t words = (rowVehicles.size() + 63) / 64;
+            if(words > statusBits[0].size()) {
+                for(int s = 0; s < VEHICLE_STATUS_COUNT; s++) statusBits[s].resize(words, 0);
+                for(int t = 0; t < VEHICLE_TYPE_COUNT; t++) typeBits[t].resize(words, 0);
+            }
         }
-        return hash % TABLE_SIZE;
+        setBit(statusBits[v->status], row);
+        setBit(typeBits[v->type], row);
+        if(v->assignedDriverId != "") {
+            driverRows[v->assignedDriverId] = row;
+        }
+        return row;
+    }
+
+    void releaseRow(uint32_t row) {
+        Vehicle* v = rowVehicles[row];
+        clearBit(statusBits[v->status], row);
+        clearBit(typeBits[v->type], row);
+        if(v->assignedDriverId != "") {
+            driverRows.erase(v->assignedDriverId);
+        }
+        rowVehicles[row] = NULL;
+        freeRows.push_back(row);
+    }
+
+    void notify(VehicleChange change, const Vehicle* v, VehicleStatus previousStatus, string_view previousDriverId) {
+        VehicleEvent event{change, v, previousStatus, previousDriverId};
+        for(const VehicleObserver& observer : observers) observer(event);
+    }
+
+    // One word of (OR of statuses) AND (OR of types)
+    uint64_t matchWord(size_t w, uint32_t statusMask, uint32_t typeMask) const {
+        uint64_t byStatus = 0, byType = 0;
+        for(int s = 0; s < VEHICLE_STATUS_COUNT; s++) {
+            if(statusMask & VEHICLE_STATUS_BIT(s)) byStatus |= statusBits[s][w];
+        }
+        for(int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+            if(typeMask & VEHICLE_TYPE_BIT(t)) byType |= typeBits[t][w];
+        }
+        return byStatus & byType;
     }
 
 public:
-    HashTable() {
+    HashTable(size_t expectedVehicles = 0) {
         totalVehicles = 0;
-        for(int i = 0; i < TABLE_SIZE; i++) {
-            table[i] = NULL;
+        verbose = true;
+        allocate(roundUpPow2((size_t)(expectedVehicles / HASH_MAX_LOAD_FACTOR) + 1));
+    }
+
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
+    // Turn off per-operation console output (bulk loads, benchmarks)
+    void setVerbose(bool v) {
+        verbose = v;
+    }
+
+    bool isVerbose() const {
+        return verbose;
+    }
+
+    // Pre-size for n vehicles so a bulk load never rehashes
+    void reserve(size_t n) {
+        size_t needed = roundUpPow2((size_t)(n / HASH_MAX_LOAD_FACTOR) + 1);
+        if(needed > slots.size()) {
+            rehash(needed);
         }
     }
 
+    // Subscribe to mutations. The observer first gets VEHICLE_ADDED for every
+    // vehicle already stored, so it starts from the current contents.
+    void addObserver(VehicleObserver observer) {
+        forEachVehicle([&](const Vehicle& v) {
+            observer(VehicleEvent{VEHICLE_ADDED, &v, v.status, ""});
+        });
+        observers.push_back(observer);
+    }
+
     // Insert vehicle - O(1) average
+    // The table owns the vehicle; its vehicleId must not change while stored.
     bool insert(Vehicle* v) {
         if(v == NULL) return false;
-        
-        string key = v->vehicleId;
-        int index = hashFunction(key);
-        
+
+        uint64_t hash = hashString(v->vehicleId);
+
         // Check if already exists
-        HashNode* current = table[index];
-        while(current != NULL) {
-            if(current->key == key) {
-                cout << "❌ Vehicle ID already exists!" << endl;
-                return false;
-            }
-            current = current->next;
+        if(findIndex(v->vehicleId, hash) != -1) {
+            if(verbose) cout << "❌ Vehicle ID already exists!" << endl;
+            return false;
         }
-        
-        // Insert at beginning of chain
-        HashNode* newNode = new HashNode(key, v);
-        newNode->next = table[index];
-        table[index] = newNode;
-        totalVehicles++;
-        
-        cout << "✅ Vehicle " << key << " inserted successfully!" << endl;
+        if(v->assignedDriverId != "" && driverRows.count(v->assignedDriverId) != 0) {
+            if(verbose) cout << "❌ Driver " << v->assignedDriverId << " already has a vehicle!" << endl;
+            return false;
+        }
+
+        insertEntry(HashSlot{hash, v, takeRow(v)});
+        if(!observers.empty()) notify(VEHICLE_ADDED, v, v->status, "");
+
+        if(verbose) cout << "✅ Vehicle " << v->vehicleId << " inserted successfully!" << endl;
         return true;
     }
 
     // Search vehicle - O(1) average
-    Vehicle* search(string vehicleId) {
-        int index = hashFunction(vehicleId);
-        HashNode* current = table[index];
-        
-        while(current != NULL) {
-            if(current->key == vehicleId) {
-                return current->vehicle;
-            }
-            current = current->next;
+    Vehicle* search(const string& vehicleId) const {
+        long index = findIndex(vehicleId, hashString(vehicleId));
+        if(index == -1) {
+            return NULL;  // Not found
         }
-        
-        return NULL;  // Not found
+        return slots[index].vehicle;
     }
 
     // Delete vehicle - O(1) average
-    bool deleteVehicle(string vehicleId) {
-        int index = hashFunction(vehicleId);
-        HashNode* current = table[index];
-        HashNode* prev = NULL;
-        
-        while(current != NULL) {
-            if(current->key == vehicleId) {
-                if(prev == NULL) {
-                    // First node
-                    table[index] = current->next;
-                } else {
-                    prev->next = current->next;
-                }
-                delete current->vehicle;
-                delete current;
-                totalVehicles--;
-                cout << "✅ Vehicle " << vehicleId << " deleted!" << endl;
-                return true;
+    bool deleteVehicle(const string& vehicleId) {
+        long index = findIndex(vehicleId, hashString(vehicleId));
+        if(index == -1) {
+            if(verbose) cout << "❌ Vehicle not found!" << endl;
+            return false;
+        }
+
+        Vehicle* v = slots[index].vehicle;
+        if(!observers.empty()) notify(VEHICLE_REMOVED, v, v->status, v->assignedDriverId);
+        releaseRow(slots[index].row);
+        delete v;
+        eraseAt((size_t)index);
+        if(verbose) cout << "✅ Vehicle " << vehicleId << " deleted!" << endl;
+        return true;
+    }
+
+    // Change status and move the vehicle between status bitmaps
+    bool updateStatus(const string& vehicleId, VehicleStatus status) {
+        long index = findIndex(vehicleId, hashString(vehicleId));
+        if(index == -1) {
+            if(verbose) cout << "❌ Vehicle not found!" << endl;
+            return false;
+        }
+
+        Vehicle* v = slots[index].vehicle;
+        uint32_t row = slots[index].row;
+        VehicleStatus previous = v->status;
+        clearBit(statusBits[v->status], row);
+        v->status = status;
+        setBit(statusBits[v->status], row);
+        if(!observers.empty()) notify(VEHICLE_STATUS_CHANGED, v, previous, v->assignedDriverId);
+        if(verbose) cout << "✅ Vehicle " << vehicleId << " -> " << vehicleStatusName(status) << endl;
+        return true;
+    }
+
+    // Assign a driver ("" to unassign). A driver holds one vehicle at a time.
+    bool assignDriver(const string& vehicleId, const string& driverId) {
+        long index = findIndex(vehicleId, hashString(vehicleId));
+        if(index == -1) {
+            if(verbose) cout << "❌ Vehicle not found!" << endl;
+            return false;
+        }
+
+        Vehicle* v = slots[index].vehicle;
+        if(driverId != "" && driverId != v->assignedDriverId && driverRows.count(driverId) != 0) {
+            if(verbose) cout << "❌ Driver " << driverId << " already has a vehicle!" << endl;
+            return false;
+        }
+        if(v->assignedDriverId != "") {
+            driverRows.erase(v->assignedDriverId);
+        }
+        string previous;
+        previous.swap(v->assignedDriverId);
+        v->assignedDriverId = driverId;
+        if(!observers.empty()) notify(VEHICLE_DRIVER_CHANGED, v, v->status, previous);
+        if(driverId != "") {
+            driverRows[driverId] = slots[index].row;
+            if(verbose) cout << "✅ Driver " << driverId << " assigned to " << vehicleId << endl;
+        } else if(verbose) {
+            cout << "✅ Vehicle " << vehicleId << " unassigned" << endl;
+        }
+        return true;
+    }
+
+    // Vehicle held by a driver, or NULL
+    Vehicle* findByDriver(const string& driverId) const {
+        auto it = driverRows.find(driverId);
+        return it != driverRows.end() ? rowVehicles[it->second] : NULL;
+    }
+
+    // Vehicles whose status is in statusMask and type is in typeMask, e.g.
+    // query(VEHICLE_STATUS_BIT(VEHICLE_IN_USE), VEHICLE_TYPE_BIT(VEHICLE_VAN))
+    vector<Vehicle*> query(uint32_t statusMask, uint32_t typeMask) const {
+        vector<Vehicle*> result;
+        for(size_t w = 0; w < statusBits[0].size(); w++) {
+            uint64_t bits = matchWord(w, statusMask, typeMask);
+            while(bits != 0) {
+                result.push_back(rowVehicles[w * 64 + (size_t)__builtin_ctzll(bits)]);
+                bits &= bits - 1;
             }
-            prev = current;
-            current = current->next;
         }
-        
-        cout << "❌ Vehicle not found!" << endl;
-        return false;
+        return result;
+    }
+
+    size_t count(uint32_t statusMask, uint32_t typeMask) const {
+        size_t total = 0;
+        for(size_t w = 0; w < statusBits[0].size(); w++) {
+            total += (size_t)__builtin_popcountll(matchWord(w, statusMask, typeMask));
+        }
+        return total;
     }
 
     // Display all vehicles
@@ -118,57 +397,63 @@ public:
         cout << "\n========== ALL VEHICLES ==========" << endl;
         cout << "Total Vehicles: " << totalVehicles << endl;
         cout << "==================================\n" << endl;
-        
-        for(int i = 0; i < TABLE_SIZE; i++) {
-            HashNode* current = table[i];
-            while(current != NULL) {
-                current->vehicle->display();
-                current = current->next;
+
+        for(size_t i = 0; i < slots.size(); i++) {
+            if(probes[i] != 0) {
+                slots[i].vehicle->display();
             }
         }
     }
 
+    // Visit every stored vehicle (in slot order)
+    template <typename F>
+    void forEachVehicle(F visit) const {
+        for(size_t i = 0; i < slots.size(); i++) {
+            if(probes[i] != 0) visit(*slots[i].vehicle);
+        }
+    }
+
     // Get total count
-    int getTotalVehicles() {
+    int getTotalVehicles() const {
         return totalVehicles;
     }
 
+    size_t getCapacity() const {
+        return slots.size();
+    }
+
+    double getLoadFactor() const {
+        return (double)totalVehicles / slots.size();
+    }
+
     // Display hash table statistics (for DSA demonstration)
     void displayStats() {
-        int usedSlots = 0;
-        int maxChainLength = 0;
-        
-        for(int i = 0; i < TABLE_SIZE; i++) {
-            if(table[i] != NULL) {
-                usedSlots++;
-                int chainLength = 0;
-                HashNode* current = table[i];
-                while(current != NULL) {
-                    chainLength++;
-                    current = current->next;
-                }
-                if(chainLength > maxChainLength) {
-                    maxChainLength = chainLength;
+        long long totalProbe = 0;
+        int maxProbe = 0;
+
+        for(size_t i = 0; i < probes.size(); i++) {
+            if(probes[i] != 0) {
+                int probe = probes[i] - 1;
+                totalProbe += probe;
+                if(probe > maxProbe) {
+                    maxProbe = probe;
                 }
             }
         }
-        
+
         cout << "\n=== Hash Table Statistics ===" << endl;
-        cout << "Table Size: " << TABLE_SIZE << endl;
-        cout << "Used Slots: " << usedSlots << endl;
-        cout << "Load Factor: " << (float)totalVehicles/TABLE_SIZE << endl;
-        cout << "Max Chain Length: " << maxChainLength << endl;
+        cout << "Table Capacity: " << slots.size() << endl;
+        cout << "Used Slots: " << totalVehicles << endl;
+        cout << "Load Factor: " << getLoadFactor() << endl;
+        cout << "Avg Probe Length: " << (totalVehicles > 0 ? (double)totalProbe / totalVehicles : 0.0) << endl;
+        cout << "Max Probe Length: " << maxProbe << endl;
         cout << "============================\n" << endl;
     }
 
     ~HashTable() {
-        for(int i = 0; i < TABLE_SIZE; i++) {
-            HashNode* current = table[i];
-            while(current != NULL) {
-                HashNode* temp = current;
-                current = current->next;
-                delete temp->vehicle;
-                delete temp;
+        for(size_t i = 0; i < slots.size(); i++) {
+            if(probes[i] != 0) {
+                delete slots[i].vehicle;
             }
         }
     }
@@ -0,0 +1,415 @@
+#ifndef MAPPED_FLEET_H
+#define MAPPED_FLEET_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "vehicle.h"
+#include "hash_table.h"
+#include "string_hash.h"
+#include "crc32.h"
+#include "durable_file.h"
+using namespace std;
+
+#define MAPPED_FLEET_MAGIC "FLTMAP01"
+#define MAPPED_FLEET_VERSION 1
+#define MAPPED_NO_ROW 0xFFFFFFFFu
+
+// On-disk layout, little-endian, every section 8-byte aligned:
+//   [header][records: count x MappedVehicleRecord][index: slots x MappedIndexSlot][string pool]
+// headerCrc covers the header bytes before it; bodyCrc covers everything
+// after the header.
+struct MappedFleetHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordBytes;
+    uint64_t count;
+    uint64_t recordOffset;
+    uint64_t indexOffset;
+    uint64_t indexSlots;        // Power of two
+    uint64_t poolOffset;
+    uint64_t poolBytes;
+    uint64_t fileBytes;
+    uint32_t bodyCrc;
+    uint32_t headerCrc;
+};
+static_assert(sizeof(MappedFleetHeader) == 80, "snapshot header layout changed");
+
+// Strings are (offset, length) pairs into the pool
+struct MappedVehicleRecord {
+    uint32_t idOffset;
+    uint32_t idLength;
+    uint32_t registrationOffset;
+    uint32_t registrationLength;
+    uint32_t modelOffset;
+    uint32_t modelLength;
+    uint32_t driverOffset;
+    uint32_t driverLength;      // 0 = unassigned
+    double kilometers;
+    int32_t serviceDays;
+    int16_t year;
+    uint8_t status;
+    uint8_t type;
+};
+static_assert(sizeof(MappedVehicleRecord) == 48, "snapshot record layout changed");
+
+// Open-addressing vehicleId index; row 0 marks an empty slot
+struct MappedIndexSlot {
+    uint32_t rowPlusOne;
+    uint32_t tag;               // High 32 bits of the ID hash
+};
+
+// Builds a snapshot file from vehicles. Model names repeat across the fleet
+// and are stored once in the pool.
+class MappedFleetWriter {
+private:
+    vector<MappedVehicleRecord> records;
+    vector<uint64_t> idHashes;
+    string pool;
+    unordered_map<string, uint32_t> pooledModels;
+    size_t rejected;            // Vehicles add() could not encode
+
+    void putString(const string& s, uint32_t& offset, uint32_t& length) {
+        offset = (uint32_t)pool.size();
+        length = (uint32_t)s.size();
+        pool.append(s);
+    }
+
+public:
+    MappedFleetWriter() {
+        rejected = 0;
+    }
+
+    void reserve(size_t count) {
+        records.reserve(count);
+        idHashes.reserve(count);
+    }
+
+    // False (and the vehicle is left out) if a field does not fit the
+    // record; write() then refuses to produce an incomplete snapshot
+    bool add(const Vehicle& v) {
+        if(v.year < INT16_MIN || v.year > INT16_MAX) {
+            cout << "❌ Vehicle " << v.vehicleId << " has year " << v.year << ", out of snapshot range" << endl;
+            rejected++;
+            return false;
+        }
+        MappedVehicleRecord r;
+        memset(&r, 0, sizeof(r));
+        putString(v.vehicleId, r.idOffset, r.idLength);
+        putString(v.registrationNumber, r.registrationOffset, r.registrationLength);
+        auto model = pooledModels.find(v.model);
+        if(model == pooledModels.end()) {
+            putString(v.model, r.modelOffset, r.modelLength);
+            pooledModels[v.model] = r.modelOffset;
+        } else {
+            r.modelOffset = model->second;
+            r.modelLength = (uint32_t)v.model.size();
+        }
+        if(v.assignedDriverId != "") putString(v.assignedDriverId, r.driverOffset, r.driverLength);
+        r.kilometers = v.kilometersRun;
+        r.serviceDays = v.daysSinceLastService;
+        r.year = (int16_t)v.year;
+        r.status = (uint8_t)v.status;
+        r.type = (uint8_t)v.type;
+        records.push_back(r);
+        idHashes.push_back(hashString(v.vehicleId));
+        return true;
+    }
+
+    bool addAll(const HashTable& table) {
+        reserve(records.size() + table.getTotalVehicles());
+        bool ok = true;
+        table.forEachVehicle([&](const Vehicle& v) { ok = add(v) && ok; });
+        return ok;
+    }
+
+    size_t size() const {
+        return records.size();
+    }
+
+    // Write atomically: temp file, fsync, rename, fsync the directory
+    bool write(const string& path) const {
+        if(pool.size() > 0xFFFFFFFFull || records.size() >= MAPPED_NO_ROW) {
+            cout << "❌ Fleet too large for snapshot format" << endl;
+            return false;
+        }
+        if(rejected > 0) {
+            cout << "❌ " << rejected << " vehicles could not be encoded; snapshot not written" << endl;
+            return false;
+        }
+
+        uint64_t slots = 16;
+        while(slots < records.size() * 2) slots <<= 1;
+        vector<MappedIndexSlot> index(slots, MappedIndexSlot{0, 0});
+        for(size_t row = 0; row < records.size(); row++) {
+            uint64_t h = idHashes[row];
+            size_t slot = (size_t)(h & (slots - 1));
+            while(index[slot].rowPlusOne != 0) slot = (slot + 1) & (slots - 1);
+            index[slot].rowPlusOne = (uint32_t)row + 1;
+            index[slot].tag = (uint32_t)(h >> 32);
+        }
+
+        MappedFleetHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAPPED_FLEET_MAGIC, 8);
+        header.version = MAPPED_FLEET_VERSION;
+        header.recordBytes = sizeof(MappedVehicleRecord);
+        header.count = records.size();
+        header.recordOffset = sizeof(MappedFleetHeader);
+        header.indexOffset = header.recordOffset + records.size() * sizeof(MappedVehicleRecord);
+        header.indexSlots = slots;
+        header.poolOffset = header.indexOffset + slots * sizeof(MappedIndexSlot);
+        header.poolBytes = pool.size();
+        header.fileBytes = header.poolOffset + pool.size();
+
+        string image(header.fileBytes, '\0');
+        if(!records.empty()) memcpy(&image[header.recordOffset], records.data(), records.size() * sizeof(MappedVehicleRecord));
+        memcpy(&image[header.indexOffset], index.data(), slots * sizeof(MappedIndexSlot));
+        if(!pool.empty()) memcpy(&image[header.poolOffset], pool.data(), pool.size());
+        header.bodyCrc = crc32(image.data() + sizeof(header), image.size() - sizeof(header));
+        header.headerCrc = crc32(&header, offsetof(MappedFleetHeader, headerCrc));
+        memcpy(&image[0], &header, sizeof(header));
+
+        string tempPath = path + ".tmp";
+        if(!writeFileDurably(tempPath, image) || rename(tempPath.c_str(), path.c_str()) != 0) {
+            cout << "❌ Cannot write fleet snapshot: " << path << endl;
+            unlink(tempPath.c_str());
+            return false;
+        }
+        syncDirectory(path);
+        return true;
+    }
+};
+
+// Read-only fleet served straight from an mmap'ed snapshot. open() only
+// checks the header and section bounds, so startup cost does not grow with
+// the fleet: pages are faulted in as lookups touch them. Strings come back
+// as string_views into the mapping (valid until close()), and a Vehicle is
+// only constructed if load() asks for one. Pass verifyChecksum to also
+// CRC the whole body on open. Without it a damaged record is caught only
+// where it can be: strings out of the pool read as "", and a status or
+// type byte out of range makes status()/type()/load() fail.
+class MappedFleet {
+private:
+    const char* base;
+    size_t mappedBytes;
+    const MappedFleetHeader* header;
+    const MappedVehicleRecord* records;
+    const MappedIndexSlot* index;
+    const char* pool;
+    uint64_t indexMask;
+
+    // Out-of-range references (corrupt body, not CRC-checked) read as ""
+    string_view poolString(uint32_t offset, uint32_t length) const {
+        if((uint64_t)offset + length > header->poolBytes) return string_view();
+        return string_view(pool + offset, length);
+    }
+
+public:
+    MappedFleet() {
+        base = NULL;
+        mappedBytes = 0;
+        header = NULL;
+        records = NULL;
+        index = NULL;
+        pool = NULL;
+        indexMask = 0;
+    }
+
+    MappedFleet(const MappedFleet&) = delete;
+    MappedFleet& operator=(const MappedFleet&) = delete;
+
+    bool open(const string& path, bool verifyChecksum = false) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            cout << "❌ Cannot open fleet snapshot: " << path << endl;
+            return false;
+        }
+        struct stat info;
+        if(fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(MappedFleetHeader)) {
+            cout << "❌ Fleet snapshot too small: " << path << endl;
+            ::close(fd);
+            return false;
+        }
+        void* mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if(mapping == MAP_FAILED) {
+            cout << "❌ Cannot map fleet snapshot: " << path << endl;
+            return false;
+        }
+        base = (const char*)mapping;
+        mappedBytes = (size_t)info.st_size;
+        header = (const MappedFleetHeader*)base;
+
+        const MappedFleetHeader& h = *header;
+        bool valid = memcmp(h.magic, MAPPED_FLEET_MAGIC, 8) == 0 &&
+                     crc32(&h, offsetof(MappedFleetHeader, headerCrc)) == h.headerCrc &&
+                     h.version == MAPPED_FLEET_VERSION &&
+                     h.recordBytes == sizeof(MappedVehicleRecord) &&
+                     h.fileBytes == mappedBytes &&
+                     h.count < MAPPED_NO_ROW &&
+                     h.recordOffset == sizeof(MappedFleetHeader) &&
+                     h.indexOffset == h.recordOffset + h.count * sizeof(MappedVehicleRecord) &&
+                     h.indexOffset <= mappedBytes &&
+                     // Bound indexSlots before multiplying so a crafted header cannot wrap
+                     h.indexSlots <= (mappedBytes - h.indexOffset) / sizeof(MappedIndexSlot) &&
+                     h.indexSlots >= 16 && (h.indexSlots & (h.indexSlots - 1)) == 0 &&
+                     h.indexSlots >= h.count * 2 &&
+                     h.poolOffset == h.indexOffset + h.indexSlots * sizeof(MappedIndexSlot) &&
+                     h.poolBytes == h.fileBytes - h.poolOffset;
+        if(valid && verifyChecksum) {
+            valid = verify();
+        }
+        if(!valid) {
+            cout << "❌ Fleet snapshot is corrupt or from another version: " << path << endl;
+            close();
+            return false;
+        }
+
+        records = (const MappedVehicleRecord*)(base + h.recordOffset);
+        index = (const MappedIndexSlot*)(base + h.indexOffset);
+        pool = base + h.poolOffset;
+        indexMask = h.indexSlots - 1;
+        return true;
+    }
+
+    // CRC the whole body; touches every page
+    bool verify() const {
+        if(header == NULL) return false;
+        return crc32(base + sizeof(MappedFleetHeader), mappedBytes - sizeof(MappedFleetHeader)) == header->bodyCrc;
+    }
+
+    bool isOpen() const {
+        return base != NULL;
+    }
+
+    size_t size() const {
+        return header != NULL ? (size_t)header->count : 0;
+    }
+
+    // Row of a vehicle, or MAPPED_NO_ROW
+    uint32_t find(string_view vehicleId) const {
+        if(base == NULL) return MAPPED_NO_ROW;
+        uint64_t h = hashString(vehicleId);
+        uint32_t tag = (uint32_t)(h >> 32);
+        for(uint64_t slot = h & indexMask, probes = 0; probes <= indexMask; slot = (slot + 1) & indexMask, probes++) {
+            const MappedIndexSlot& s = index[slot];
+            if(s.rowPlusOne == 0) return MAPPED_NO_ROW;
+            if(s.tag == tag && s.rowPlusOne <= header->count && this->vehicleId(s.rowPlusOne - 1) == vehicleId) {
+                return s.rowPlusOne - 1;
+            }
+        }
+        return MAPPED_NO_ROW;
+    }
+
+    string_view vehicleId(uint32_t row) const {
+        return poolString(records[row].idOffset, records[row].idLength);
+    }
+
+    string_view registrationNumber(uint32_t row) const {
+        return poolString(records[row].registrationOffset, records[row].registrationLength);
+    }
+
+    string_view model(uint32_t row) const {
+        return poolString(records[row].modelOffset, records[row].modelLength);
+    }
+
+    string_view driverId(uint32_t row) const {
+        return poolString(records[row].driverOffset, records[row].driverLength);
+    }
+
+    double kilometersRun(uint32_t row) const {
+        return records[row].kilometers;
+    }
+
+    int daysSinceService(uint32_t row) const {
+        return records[row].serviceDays;
+    }
+
+    int year(uint32_t row) const {
+        return records[row].year;
+    }
+
+    // False for a byte that is no VehicleStatus (corrupt body): such a
+    // row must not be read as some status, least of all a dispatchable one
+    bool status(uint32_t row, VehicleStatus& out) const {
+        if(records[row].status >= VEHICLE_STATUS_COUNT) return false;
+        out = (VehicleStatus)records[row].status;
+        return true;
+    }
+
+    bool type(uint32_t row, VehicleType& out) const {
+        if(records[row].type >= VEHICLE_TYPE_COUNT) return false;
+        out = (VehicleType)records[row].type;
+        return true;
+    }
+
+    // Materialize one row as a heap-style Vehicle; false (and 'v' left
+    // unchanged) if its status or type byte is out of range
+    bool load(uint32_t row, Vehicle& v) const {
+        VehicleStatus st;
+        VehicleType ty;
+        if(!status(row, st) || !type(row, ty)) {
+            cout << "❌ Corrupt status or type in fleet snapshot row " << row << endl;
+            return false;
+        }
+        v.vehicleId = string(vehicleId(row));
+        v.registrationNumber = string(registrationNumber(row));
+        v.model = string(model(row));
+        v.type = ty;
+        v.year = year(row);
+        v.kilometersRun = kilometersRun(row);
+        v.daysSinceLastService = daysSinceService(row);
+        v.status = st;
+        v.assignedDriverId = string(driverId(row));
+        return true;
+    }
+
+    size_t getFileBytes() const {
+        return mappedBytes;
+    }
+
+    void close() {
+        if(base != NULL) {
+            munmap((void*)base, mappedBytes);
+        }
+        base = NULL;
+        mappedBytes = 0;
+        header = NULL;
+        records = NULL;
+        index = NULL;
+        pool = NULL;
+        indexMask = 0;
+    }
+
+    void displayStats() const {
+        cout << "\n=== Mapped Fleet Statistics ===" << endl;
+        if(header == NULL) {
+            cout << "Not open" << endl;
+        } else {
+            cout << "Vehicles: " << header->count << " (" << sizeof(MappedVehicleRecord) << "-byte records)" << endl;
+            cout << "Index slots: " << header->indexSlots << endl;
+            cout << "String pool: " << header->poolBytes / 1024 << " KB" << endl;
+            cout << "File size: " << mappedBytes / 1024 << " KB" << endl;
+        }
+        cout << "===============================\n" << endl;
+    }
+
+    ~MappedFleet() {
+        close();
+    }
+};
+
+#endif
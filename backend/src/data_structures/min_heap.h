@@ -3,15 +3,32 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
 #include "vehicle.h"
 using namespace std;
 
-#define MAX_HEAP_SIZE 100
+// Heap slot: the priority key is cached so comparisons never call back into
+// Vehicle::getMaintenancePriority().
+struct HeapEntry {
+    int priority;
+    int handle;     // Index into MinHeap::vehicles / MinHeap::slotOf
+};
 
+// Indexed min-heap keyed on maintenance priority.
+// Every vehicle gets a stable integer handle; slotOf[handle] tracks where it
+// currently sits in the heap, so a single vehicle can be re-prioritised or
+// removed in O(log n) without rebuilding.
 class MinHeap {
 private:
-    Vehicle* heap[MAX_HEAP_SIZE];
-    int size;
+    vector<HeapEntry> heap;
+    vector<Vehicle*> vehicles;          // handle -> vehicle
+    vector<int> slotOf;                 // handle -> heap index (-1 if free)
+    vector<int> freeHandles;
+    unordered_map<string, int> handleOf;  // vehicleId -> handle
+    bool verbose;
 
     // Get parent index
     int parent(int i) {
@@ -28,82 +45,209 @@ private:
         return 2 * i + 2;
     }
 
-    // Swap two vehicles
-    void swap(int i, int j) {
-        Vehicle* temp = heap[i];
-        heap[i] = heap[j];
-        heap[j] = temp;
+    // Write entry into slot i and record its new position
+    void place(int i, const HeapEntry& entry) {
+        heap[i] = entry;
+        slotOf[entry.handle] = i;
     }
 
     // Heapify up - maintain min heap property upward
     void heapifyUp(int index) {
-        while(index > 0 && heap[parent(index)]->getMaintenancePriority() > heap[index]->getMaintenancePriority()) {
-            swap(index, parent(index));
+        HeapEntry entry = heap[index];
+        while(index > 0 && heap[parent(index)].priority > entry.priority) {
+            place(index, heap[parent(index)]);
             index = parent(index);
         }
+        place(index, entry);
     }
 
     // Heapify down - maintain min heap property downward
     void heapifyDown(int index) {
-        int minIndex = index;
-        int left = leftChild(index);
-        int right = rightChild(index);
+        int size = (int)heap.size();
+        HeapEntry entry = heap[index];
+
+        while(true) {
+            int minIndex = leftChild(index);
+            if(minIndex >= size) break;
+
+            int right = rightChild(index);
+            if(right < size && heap[right].priority < heap[minIndex].priority) {
+                minIndex = right;
+            }
+            if(heap[minIndex].priority >= entry.priority) break;
 
-        if(left < size && heap[left]->getMaintenancePriority() < heap[minIndex]->getMaintenancePriority()) {
-            minIndex = left;
+            place(index, heap[minIndex]);
+            index = minIndex;
         }
+        place(index, entry);
+    }
 
-        if(right < size && heap[right]->getMaintenancePriority() < heap[minIndex]->getMaintenancePriority()) {
-            minIndex = right;
+    int allocHandle(Vehicle* vehicle) {
+        int handle;
+        if(!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+            vehicles[handle] = vehicle;
+        } else {
+            handle = (int)vehicles.size();
+            vehicles.push_back(vehicle);
+            slotOf.push_back(-1);
         }
+        handleOf[vehicle->vehicleId] = handle;
+        return handle;
+    }
 
-        if(index != minIndex) {
-            swap(index, minIndex);
-            heapifyDown(minIndex);
+    // Detach the entry at heap index i and restore the heap property
+    Vehicle* removeAt(int i) {
+        int handle = heap[i].handle;
+        Vehicle* vehicle = vehicles[handle];
+
+        HeapEntry last = heap.back();
+        heap.pop_back();
+        if(i < (int)heap.size()) {
+            place(i, last);
+            if(i > 0 && heap[parent(i)].priority > last.priority) {
+                heapifyUp(i);
+            } else {
+                heapifyDown(i);
+            }
+        }
+
+        handleOf.erase(vehicle->vehicleId);
+        vehicles[handle] = NULL;
+        slotOf[handle] = -1;
+        freeHandles.push_back(handle);
+        return vehicle;
+    }
+
+    // Heap indices of k entries with the lowest priorities, lowest first,
+    // without modifying the heap. Among equal priorities the order (and who
+    // makes the cut at the k-th place) follows the heap layout. Best-first
+    // walk from the root: a node can only be next once its parent has been
+    // taken, so a small frontier heap of candidates is enough - O(k log k),
+    // independent of the heap size.
+    void topKSlots(int k, vector<int>& slots) const {
+        slots.clear();
+        if(k <= 0 || heap.empty()) return;
+
+        // Frontier ordered by (priority, heap index), smallest on top
+        vector<pair<int, int> > frontier;
+        frontier.push_back(make_pair(heap[0].priority, 0));
+        while(!frontier.empty() && (int)slots.size() < k) {
+            pop_heap(frontier.begin(), frontier.end(), greater<pair<int, int> >());
+            int i = frontier.back().second;
+            frontier.pop_back();
+            slots.push_back(i);
+
+            for(int c = 2 * i + 1; c <= 2 * i + 2 && c < (int)heap.size(); c++) {
+                frontier.push_back(make_pair(heap[c].priority, c));
+                push_heap(frontier.begin(), frontier.end(), greater<pair<int, int> >());
+            }
         }
     }
 
 public:
     MinHeap() {
-        size = 0;
-        for(int i = 0; i < MAX_HEAP_SIZE; i++) {
-            heap[i] = NULL;
-        }
+        verbose = true;
+    }
+
+    // Turn off per-operation console output (bulk syncs, benchmarks)
+    void setVerbose(bool v) {
+        verbose = v;
     }
 
     // Insert vehicle - O(log n)
     bool insert(Vehicle* vehicle) {
-        if(size >= MAX_HEAP_SIZE) {
-            cout << "❌ Heap is full!" << endl;
+        if(vehicle == NULL) return false;
+        if(handleOf.count(vehicle->vehicleId)) {
+            if(verbose) cout << "❌ Vehicle " << vehicle->vehicleId << " is already in the maintenance heap!" << endl;
             return false;
         }
 
-        heap[size] = vehicle;
-        heapifyUp(size);
-        size++;
-        
-        cout << "✅ Vehicle " << vehicle->vehicleId << " added to maintenance heap (Priority: " 
-             << vehicle->getMaintenancePriority() << ")" << endl;
+        int handle = allocHandle(vehicle);
+        heap.push_back(HeapEntry{vehicle->getMaintenancePriority(), handle});
+        heapifyUp((int)heap.size() - 1);
+
+        if(verbose) {
+            cout << "✅ Vehicle " << vehicle->vehicleId << " added to maintenance heap (Priority: "
+                 << heap[slotOf[handle]].priority << ")" << endl;
+        }
+        return true;
+    }
+
+    // Replace the heap contents with 'list' in O(n) (Floyd's heapify).
+    // Duplicate IDs after the first occurrence are skipped.
+    void buildHeap(const vector<Vehicle*>& list) {
+        heap.clear();
+        vehicles.clear();
+        slotOf.clear();
+        freeHandles.clear();
+        handleOf.clear();
+        heap.reserve(list.size());
+        vehicles.reserve(list.size());
+        slotOf.reserve(list.size());
+        handleOf.reserve(list.size());
+
+        for(size_t i = 0; i < list.size(); i++) {
+            Vehicle* v = list[i];
+            if(v == NULL || handleOf.count(v->vehicleId)) continue;
+            int handle = allocHandle(v);
+            slotOf[handle] = (int)heap.size();
+            heap.push_back(HeapEntry{v->getMaintenancePriority(), handle});
+        }
+
+        for(int i = (int)heap.size() / 2 - 1; i >= 0; i--) {
+            heapifyDown(i);
+        }
+
+        if(verbose) cout << "✅ Maintenance heap built from " << heap.size() << " vehicles" << endl;
+    }
+
+    // Re-read kilometersRun/daysSinceLastService after they changed - O(log n)
+    bool updatePriority(const string& vehicleId) {
+        unordered_map<string, int>::iterator it = handleOf.find(vehicleId);
+        if(it == handleOf.end()) return false;
+
+        int index = slotOf[it->second];
+        int oldPriority = heap[index].priority;
+        int newPriority = vehicles[it->second]->getMaintenancePriority();
+        if(newPriority == oldPriority) return true;
+
+        heap[index].priority = newPriority;
+        if(newPriority < oldPriority) {
+            heapifyUp(index);
+        } else {
+            heapifyDown(index);
+        }
         return true;
     }
 
+    // Remove a specific vehicle (e.g. retired or serviced elsewhere) - O(log n)
+    bool remove(const string& vehicleId) {
+        unordered_map<string, int>::iterator it = handleOf.find(vehicleId);
+        if(it == handleOf.end()) return false;
+        removeAt(slotOf[it->second]);
+        return true;
+    }
+
+    bool contains(const string& vehicleId) const {
+        return handleOf.count(vehicleId) > 0;
+    }
+
     // Extract min (highest priority) - O(log n)
     Vehicle* extractMin() {
         if(isEmpty()) {
-            cout << "❌ Heap is empty!" << endl;
+            if(verbose) cout << "❌ Heap is empty!" << endl;
             return NULL;
         }
 
-        Vehicle* minVehicle = heap[0];
-        heap[0] = heap[size - 1];
-        size--;
-        
-        if(size > 0) {
-            heapifyDown(0);
-        }
+        int priority = heap[0].priority;
+        Vehicle* minVehicle = removeAt(0);
 
-        cout << "✅ Vehicle " << minVehicle->vehicleId << " scheduled for maintenance (Priority: " 
-             << minVehicle->getMaintenancePriority() << ")" << endl;
+        if(verbose) {
+            cout << "✅ Vehicle " << minVehicle->vehicleId << " scheduled for maintenance (Priority: "
+                 << priority << ")" << endl;
+        }
         return minVehicle;
     }
 
@@ -112,17 +256,17 @@ public:
         if(isEmpty()) {
             return NULL;
         }
-        return heap[0];
+        return vehicles[heap[0].handle];
     }
 
     // Check if empty
     bool isEmpty() {
-        return size == 0;
+        return heap.empty();
     }
 
     // Get size
     int getSize() {
-        return size;
+        return (int)heap.size();
     }
 
     // Display heap (level order)
@@ -133,28 +277,45 @@ public:
         }
 
         cout << "\n========== MAINTENANCE PRIORITY HEAP ==========" << endl;
-        cout << "Total Vehicles Pending Maintenance: " << size << endl;
+        cout << "Total Vehicles Pending Maintenance: " << heap.size() << endl;
         cout << "===============================================\n" << endl;
 
-        for(int i = 0; i < size; i++) {
+        for(size_t i = 0; i < heap.size(); i++) {
+            Vehicle* v = vehicles[heap[i].handle];
             cout << "Priority Rank " << (i + 1) << ":" << endl;
-            cout << "  Vehicle: " << heap[i]->vehicleId << " (" << heap[i]->model << ")" << endl;
-            cout << "  Priority Score: " << heap[i]->getMaintenancePriority() << endl;
-            cout << "  Kilometers: " << heap[i]->kilometersRun << " km" << endl;
-            cout << "  Days Since Service: " << heap[i]->daysSinceLastService << " days" << endl;
-            cout << "  Needs Maintenance: " << (heap[i]->needsMaintenance() ? "YES ⚠️" : "NO") << endl;
+            cout << "  Vehicle: " << v->vehicleId << " (" << v->model << ")" << endl;
+            cout << "  Priority Score: " << heap[i].priority << endl;
+            cout << "  Kilometers: " << v->kilometersRun << " km" << endl;
+            cout << "  Days Since Service: " << v->daysSinceLastService << " days" << endl;
+            cout << "  Needs Maintenance: " << (v->needsMaintenance() ? "YES ⚠️" : "NO") << endl;
             cout << endl;
         }
     }
 
+    // Vehicles with the k lowest priorities, lowest first. Equal priorities
+    // come out in heap order, which need not be the order extractMin()
+    // would return them in. The heap is left untouched and stays current
+    // through updatePriority().
+    vector<Vehicle*> topK(int k) const {
+        vector<int> slots;
+        topKSlots(k, slots);
+        vector<Vehicle*> result;
+        for(size_t i = 0; i < slots.size(); i++) {
+            result.push_back(vehicles[heap[slots[i]].handle]);
+        }
+        return result;
+    }
+
     // Display next 3 vehicles for maintenance
     void displayTop3() {
         cout << "\n=== TOP 3 PRIORITY VEHICLES ===" << endl;
-        int limit = (size < 3) ? size : 3;
-        
-        for(int i = 0; i < limit; i++) {
-            cout << (i + 1) << ". " << heap[i]->vehicleId << " - " << heap[i]->model 
-                 << " (Priority: " << heap[i]->getMaintenancePriority() << ")" << endl;
+        vector<int> slots;
+        topKSlots(3, slots);
+
+        for(size_t i = 0; i < slots.size(); i++) {
+            Vehicle* v = vehicles[heap[slots[i]].handle];
+            cout << (i + 1) << ". " << v->vehicleId << " - " << v->model
+                 << " (Priority: " << heap[slots[i]].priority << ")" << endl;
         }
         cout << "================================\n" << endl;
     }
@@ -162,18 +323,18 @@ public:
     // Display statistics
     void displayStats() {
         cout << "\n=== Min Heap Statistics ===" << endl;
-        cout << "Total Vehicles: " << size << endl;
+        cout << "Total Vehicles: " << heap.size() << endl;
         cout << "Heap Status: " << (isEmpty() ? "EMPTY" : "ACTIVE") << endl;
-        
+
         if(!isEmpty()) {
-            cout << "Highest Priority: " << heap[0]->vehicleId << " (Priority: " 
-                 << heap[0]->getMaintenancePriority() << ")" << endl;
+            cout << "Highest Priority: " << vehicles[heap[0].handle]->vehicleId << " (Priority: "
+                 << heap[0].priority << ")" << endl;
         }
-        
+
         // Count urgent vehicles
         int urgentCount = 0;
-        for(int i = 0; i < size; i++) {
-            if(heap[i]->needsMaintenance()) {
+        for(size_t i = 0; i < heap.size(); i++) {
+            if(vehicles[heap[i].handle]->needsMaintenance()) {
                 urgentCount++;
             }
         }
@@ -0,0 +1,92 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+using namespace std;
+
+#define NODE_POOL_BLOCK_BYTES 65536     // Minimum block size
+
+// Typed node allocator for linked containers (road lists, auth chains).
+// Nodes are carved out of 64 KB blocks, so a million inserts cost a few
+// hundred mallocs instead of a million. The containers using it never
+// unlink a single node, so there is no per-node free: destroying the pool
+// (or clear()) runs the destructor of every node and frees whole blocks
+// at once - owners don't need to walk their chains. Not thread-safe; one
+// pool per container.
+template <typename T>
+class NodePool {
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t blockBytes() {
+        size_t bytes = NODE_POOL_BLOCK_BYTES;
+        while(bytes < 64 * sizeof(Slot)) bytes *= 2;
+        return bytes;
+    }
+
+    static constexpr size_t SLOTS_PER_BLOCK = blockBytes() / sizeof(Slot);
+
+    // Every block is full except the newest, which has 'used' nodes
+    vector<Slot*> blocks;
+    size_t used;
+
+    Slot* takeSlot() {
+        if(blocks.empty() || used == SLOTS_PER_BLOCK) {
+            blocks.push_back(static_cast<Slot*>(::operator new(SLOTS_PER_BLOCK * sizeof(Slot), align_val_t(alignof(Slot)))));
+            used = 0;
+        }
+        return blocks.back() + used++;
+    }
+
+public:
+    NodePool() {
+        used = 0;
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Construct a node in pooled memory
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = takeSlot();
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    // Destroy every node and free all blocks
+    void clear() {
+        for(size_t b = 0; b < blocks.size(); b++) {
+            size_t count = b + 1 == blocks.size() ? used : SLOTS_PER_BLOCK;
+            for(size_t s = 0; s < count; s++) {
+                reinterpret_cast<T*>(blocks[b][s].storage)->~T();
+            }
+            ::operator delete(blocks[b], align_val_t(alignof(Slot)));
+        }
+        blocks.clear();
+        used = 0;
+    }
+
+    size_t getLiveNodes() const {
+        return blocks.empty() ? 0 : (blocks.size() - 1) * SLOTS_PER_BLOCK + used;
+    }
+
+    size_t getNumBlocks() const {
+        return blocks.size();
+    }
+
+    size_t getCapacity() const {
+        return blocks.size() * SLOTS_PER_BLOCK;
+    }
+
+    ~NodePool() {
+        clear();
+    }
+};
+
+#endif
@@ -0,0 +1,392 @@
+#ifndef POSITION_TABLE_H
+#define POSITION_TABLE_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "string_hash.h"
+using namespace std;
+
+#define POSITION_MAX_TRIP_ID 32
+#define POSITION_KEY_WORDS (POSITION_MAX_TRIP_ID / 8)
+#define POSITION_NO_SLOT 0xFFFFFFFFu
+
+enum PositionSlotState : uint8_t {
+    POSITION_EMPTY,             // Never used; ends a probe chain
+    POSITION_ACTIVE,            // Ongoing trip, accepts pings
+    POSITION_ENDED              // Trip ended; slot reusable, keeps last position
+};
+
+enum PositionUpdate {
+    POSITION_UPDATED,
+    POSITION_STALE,             // Older than the stored ping (out of order)
+    POSITION_UNKNOWN_TRIP       // Not started, ended, or ID too long
+};
+
+// Latest position of one trip, as handed to readers and flush callbacks
+struct TripPosition {
+    string tripId;
+    double latitude;
+    double longitude;
+    float speed;
+    int64_t timestampMs;
+};
+
+// What one takeDirty() handed out, until ackDirty() or releaseDirty()
+struct DirtyBatch {
+    vector<uint32_t> slots;
+    vector<uint32_t> sequences;         // Slot sequence when it was read
+    vector<TripPosition> ended;
+};
+
+// Latest GPS position per trip, readable and writable without locks.
+// Each slot is a seqlock: writers take it by bumping the sequence to odd
+// (CAS, so concurrent pings for one trip serialize on that slot only),
+// readers copy the fields and retry if the sequence moved. The trip ID
+// key lives inside the seqlock too, so a lookup never sees a half-written
+// key while an ended slot is reused. Coordinates are kept as 1e-7 degree
+// integers - the precision of the trips table - packed into one word.
+// startTrip/endTrip are rare and serialize on a mutex; update() and get()
+// never block. Ended slots never go back to EMPTY, so a lookup stops
+// after the longest probe distance any trip has been placed at instead of
+// at the first empty slot; misses stay short however many trips ended.
+// Dirty slots (changed since the last acknowledged batch) are queued once
+// each, so a flush writes one row per trip, not per ping. A batch keeps
+// its dirty flags until ackDirty(); releaseDirty() queues it again, so a
+// failed write loses nothing.
+class PositionTable {
+private:
+    struct alignas(64) Slot {
+        atomic<uint32_t> sequence;
+        atomic<uint8_t> state;
+        atomic<uint8_t> keyLength;
+        atomic<uint8_t> dirty;
+        atomic<uint64_t> hash;
+        atomic<uint64_t> key[POSITION_KEY_WORDS];
+        atomic<uint64_t> position;      // latE7 << 32 | lonE7
+        atomic<int64_t> timestampMs;
+        atomic<float> speed;
+    };
+
+    vector<Slot> slots;
+    uint64_t mask;
+    atomic<uint64_t> maxProbe;  // Longest distance from home slot of any trip placed
+    mutex tripLock;             // startTrip / endTrip
+    mutex dirtyLock;
+    vector<uint32_t> dirtySlots;
+    vector<TripPosition> endedPositions;    // Final positions, slot may be reused already
+    atomic<size_t> activeTrips;
+
+    static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    static void packKey(string_view tripId, uint64_t words[POSITION_KEY_WORDS]) {
+        memset(words, 0, POSITION_MAX_TRIP_ID);
+        memcpy(words, tripId.data(), tripId.size());
+    }
+
+    static uint64_t packPosition(double latitude, double longitude) {
+        uint32_t lat = (uint32_t)(int32_t)llround(latitude * 1e7);
+        uint32_t lon = (uint32_t)(int32_t)llround(longitude * 1e7);
+        return (uint64_t)lat << 32 | lon;
+    }
+
+    uint32_t writeBegin(Slot& s) {
+        uint32_t seq = s.sequence.load(memory_order_relaxed);
+        while(true) {
+            if(seq & 1) {
+                cpuRelax();
+                seq = s.sequence.load(memory_order_relaxed);
+            } else if(s.sequence.compare_exchange_weak(seq, seq + 1, memory_order_acquire, memory_order_relaxed)) {
+                break;
+            }
+        }
+        atomic_thread_fence(memory_order_release);
+        return seq;
+    }
+
+    void writeEnd(Slot& s, uint32_t seq) {
+        s.sequence.store(seq + 2, memory_order_release);
+    }
+
+    // Consistent read of one slot's key and state
+    void readKey(const Slot& s, uint8_t& state, uint64_t& hash, uint8_t& length, uint64_t words[POSITION_KEY_WORDS]) const {
+        while(true) {
+            uint32_t before = s.sequence.load(memory_order_acquire);
+            if(before & 1) {
+                cpuRelax();
+                continue;
+            }
+            state = s.state.load(memory_order_relaxed);
+            hash = s.hash.load(memory_order_relaxed);
+            length = s.keyLength.load(memory_order_relaxed);
+            for(int w = 0; w < POSITION_KEY_WORDS; w++) words[w] = s.key[w].load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if(s.sequence.load(memory_order_relaxed) == before) return;
+        }
+    }
+
+    static size_t roundCapacity(size_t capacity) {
+        size_t n = 16;
+        while(n < capacity) n <<= 1;
+        return n;
+    }
+
+    // Slot holding this trip ID (active or ended), or POSITION_NO_SLOT.
+    // 'reusable' gets the first ended slot seen on the way, if any; only
+    // then does the search go past maxProbe.
+    uint32_t locate(string_view tripId, uint64_t h, const uint64_t want[POSITION_KEY_WORDS], uint32_t* reusable = NULL) const {
+        if(reusable != NULL) *reusable = POSITION_NO_SLOT;
+        uint64_t limit = maxProbe.load(memory_order_acquire);
+        for(uint64_t i = h & mask, probes = 0; probes <= mask; i = (i + 1) & mask, probes++) {
+            if(probes > limit && (reusable == NULL || *reusable != POSITION_NO_SLOT)) return POSITION_NO_SLOT;
+            uint8_t state, length;
+            uint64_t hash, words[POSITION_KEY_WORDS];
+            readKey(slots[i], state, hash, length, words);
+            if(state == POSITION_EMPTY) {
+                if(reusable != NULL && *reusable == POSITION_NO_SLOT) *reusable = (uint32_t)i;
+                return POSITION_NO_SLOT;
+            }
+            if(hash == h && length == tripId.size() && memcmp(words, want, POSITION_MAX_TRIP_ID) == 0) {
+                return (uint32_t)i;
+            }
+            if(state == POSITION_ENDED && reusable != NULL && *reusable == POSITION_NO_SLOT) *reusable = (uint32_t)i;
+        }
+        return POSITION_NO_SLOT;
+    }
+
+    void markDirty(uint32_t index) {
+        if(slots[index].dirty.exchange(1, memory_order_acq_rel) == 0) {
+            lock_guard<mutex> guard(dirtyLock);
+            dirtySlots.push_back(index);
+        }
+    }
+
+    // Consistent copy of a slot; returns its state
+    uint8_t readPosition(const Slot& s, TripPosition& out, uint32_t* sequence = NULL) const {
+        while(true) {
+            uint32_t before = s.sequence.load(memory_order_acquire);
+            if(before & 1) {
+                cpuRelax();
+                continue;
+            }
+            uint8_t state = s.state.load(memory_order_relaxed);
+            uint8_t length = s.keyLength.load(memory_order_relaxed);
+            uint64_t words[POSITION_KEY_WORDS];
+            for(int w = 0; w < POSITION_KEY_WORDS; w++) words[w] = s.key[w].load(memory_order_relaxed);
+            uint64_t packed = s.position.load(memory_order_relaxed);
+            int64_t timestamp = s.timestampMs.load(memory_order_relaxed);
+            float speed = s.speed.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if(s.sequence.load(memory_order_relaxed) != before) continue;
+            if(sequence != NULL) *sequence = before;
+
+            out.tripId.assign((const char*)words, length < POSITION_MAX_TRIP_ID ? length : POSITION_MAX_TRIP_ID);
+            out.latitude = (int32_t)(uint32_t)(packed >> 32) / 1e7;
+            out.longitude = (int32_t)(uint32_t)packed / 1e7;
+            out.speed = speed;
+            out.timestampMs = timestamp;
+            return state;
+        }
+    }
+
+public:
+    // Capacity is rounded up to a power of two; keep active trips under half of it
+    PositionTable(size_t capacity = 1 << 16) : slots(roundCapacity(capacity)) {
+        mask = slots.size() - 1;
+        for(Slot& s : slots) {
+            s.sequence.store(0, memory_order_relaxed);
+            s.state.store(POSITION_EMPTY, memory_order_relaxed);
+            s.keyLength.store(0, memory_order_relaxed);
+            s.dirty.store(0, memory_order_relaxed);
+            s.hash.store(0, memory_order_relaxed);
+            for(int w = 0; w < POSITION_KEY_WORDS; w++) s.key[w].store(0, memory_order_relaxed);
+            s.position.store(0, memory_order_relaxed);
+            s.timestampMs.store(INT64_MIN, memory_order_relaxed);
+            s.speed.store(0, memory_order_relaxed);
+        }
+        maxProbe = 0;
+        activeTrips = 0;
+    }
+
+    PositionTable(const PositionTable&) = delete;
+    PositionTable& operator=(const PositionTable&) = delete;
+
+    // Start accepting pings for a trip
+    bool startTrip(string_view tripId) {
+        if(tripId.empty() || tripId.size() > POSITION_MAX_TRIP_ID) {
+            cout << "❌ Trip ID must be 1-" << POSITION_MAX_TRIP_ID << " characters" << endl;
+            return false;
+        }
+        lock_guard<mutex> guard(tripLock);
+        if(activeTrips.load() * 2 >= slots.size()) {
+            cout << "❌ Position table full (" << activeTrips.load() << " active trips)" << endl;
+            return false;
+        }
+        uint64_t h = hashString(tripId);
+        uint64_t words[POSITION_KEY_WORDS];
+        packKey(tripId, words);
+        uint32_t reusable;
+        uint32_t index = locate(tripId, h, words, &reusable);
+        if(index != POSITION_NO_SLOT) {
+            if(slots[index].state.load(memory_order_relaxed) == POSITION_ACTIVE) return false;
+        } else {
+            index = reusable;
+        }
+        if(index == POSITION_NO_SLOT) return false;
+        // Widen the lookup bound before the trip becomes visible
+        uint64_t distance = (index - h) & mask;
+        if(distance > maxProbe.load(memory_order_relaxed)) maxProbe.store(distance, memory_order_release);
+
+        Slot& s = slots[index];
+        uint32_t seq = writeBegin(s);
+        s.hash.store(h, memory_order_relaxed);
+        s.keyLength.store((uint8_t)tripId.size(), memory_order_relaxed);
+        for(int w = 0; w < POSITION_KEY_WORDS; w++) s.key[w].store(words[w], memory_order_relaxed);
+        s.position.store(0, memory_order_relaxed);
+        s.timestampMs.store(INT64_MIN, memory_order_relaxed);
+        s.speed.store(0, memory_order_relaxed);
+        s.state.store(POSITION_ACTIVE, memory_order_relaxed);
+        writeEnd(s, seq);
+        activeTrips++;
+        return true;
+    }
+
+    // Stop accepting pings. The final position goes out with the next
+    // acknowledged takeDirty() and stays readable until the slot is reused.
+    bool endTrip(string_view tripId) {
+        if(tripId.size() > POSITION_MAX_TRIP_ID) return false;
+        uint64_t words[POSITION_KEY_WORDS];
+        packKey(tripId, words);
+        lock_guard<mutex> guard(tripLock);
+        uint32_t index = locate(tripId, hashString(tripId), words);
+        if(index == POSITION_NO_SLOT) return false;
+        Slot& s = slots[index];
+        TripPosition last;
+        uint32_t seq = writeBegin(s);
+        bool wasActive = s.state.load(memory_order_relaxed) == POSITION_ACTIVE;
+        s.state.store(POSITION_ENDED, memory_order_relaxed);
+        writeEnd(s, seq);
+        if(!wasActive) return false;
+
+        activeTrips--;
+        readPosition(s, last);
+        if(last.timestampMs != INT64_MIN) {
+            lock_guard<mutex> dirtyGuard(dirtyLock);
+            endedPositions.push_back(last);
+        }
+        return true;
+    }
+
+    // Record a ping unless an equal or newer one is already stored
+    PositionUpdate update(string_view tripId, double latitude, double longitude, float speed, int64_t timestampMs) {
+        if(tripId.size() > POSITION_MAX_TRIP_ID) return POSITION_UNKNOWN_TRIP;
+        uint64_t h = hashString(tripId);
+        uint64_t words[POSITION_KEY_WORDS];
+        packKey(tripId, words);
+        uint32_t index = locate(tripId, h, words);
+        if(index == POSITION_NO_SLOT) return POSITION_UNKNOWN_TRIP;
+
+        Slot& s = slots[index];
+        uint32_t seq = writeBegin(s);
+        // The slot may have ended (and been reused) since locate()
+        bool sameTrip = s.state.load(memory_order_relaxed) == POSITION_ACTIVE && s.hash.load(memory_order_relaxed) == h;
+        for(int w = 0; w < POSITION_KEY_WORDS && sameTrip; w++) {
+            sameTrip = s.key[w].load(memory_order_relaxed) == words[w];
+        }
+        PositionUpdate result = POSITION_UPDATED;
+        if(!sameTrip) {
+            result = POSITION_UNKNOWN_TRIP;
+        } else if(timestampMs <= s.timestampMs.load(memory_order_relaxed)) {
+            result = POSITION_STALE;
+        } else {
+            s.position.store(packPosition(latitude, longitude), memory_order_relaxed);
+            s.timestampMs.store(timestampMs, memory_order_relaxed);
+            s.speed.store(speed, memory_order_relaxed);
+        }
+        writeEnd(s, seq);
+        if(result == POSITION_UPDATED) markDirty(index);
+        return result;
+    }
+
+    // Latest position of a trip (active or recently ended)
+    bool get(string_view tripId, TripPosition& out) const {
+        if(tripId.size() > POSITION_MAX_TRIP_ID) return false;
+        uint64_t words[POSITION_KEY_WORDS];
+        packKey(tripId, words);
+        uint32_t index = locate(tripId, hashString(tripId), words);
+        if(index == POSITION_NO_SLOT) return false;
+        readPosition(slots[index], out);
+        return out.tripId == tripId && out.timestampMs != INT64_MIN;
+    }
+
+    // Append the latest position of every trip changed since the last
+    // acknowledged batch, and the final position of every trip ended since
+    // then. The slots stay dirty: pass 'batch' to ackDirty() once the rows
+    // are stored, or to releaseDirty() to hand them out again next time.
+    // One batch may be outstanding at a time.
+    size_t takeDirty(vector<TripPosition>& out, DirtyBatch& batch) {
+        batch.slots.clear();
+        batch.sequences.clear();
+        batch.ended.clear();
+        size_t start = out.size();
+        {
+            lock_guard<mutex> guard(dirtyLock);
+            batch.slots.swap(dirtySlots);
+            batch.ended.swap(endedPositions);
+        }
+        out.insert(out.end(), batch.ended.begin(), batch.ended.end());
+        batch.sequences.resize(batch.slots.size());
+        TripPosition current;
+        for(size_t i = 0; i < batch.slots.size(); i++) {
+            if(readPosition(slots[batch.slots[i]], current, &batch.sequences[i]) == POSITION_ACTIVE &&
+               current.timestampMs != INT64_MIN) {
+                out.push_back(current);
+            }
+        }
+        return out.size() - start;
+    }
+
+    // The batch is stored: clear its dirty flags. A slot written since it
+    // was read is queued again, since that ping saw the flag still set.
+    void ackDirty(DirtyBatch& batch) {
+        for(size_t i = 0; i < batch.slots.size(); i++) {
+            Slot& s = slots[batch.slots[i]];
+            s.dirty.exchange(0, memory_order_acq_rel);
+            if(s.sequence.load(memory_order_acquire) != batch.sequences[i]) markDirty(batch.slots[i]);
+        }
+        batch.slots.clear();
+        batch.sequences.clear();
+        batch.ended.clear();
+    }
+
+    // The batch was not stored: queue it for the next takeDirty(), ahead
+    // of anything that ended since
+    void releaseDirty(DirtyBatch& batch) {
+        lock_guard<mutex> guard(dirtyLock);
+        dirtySlots.insert(dirtySlots.end(), batch.slots.begin(), batch.slots.end());
+        endedPositions.insert(endedPositions.begin(), batch.ended.begin(), batch.ended.end());
+        batch.slots.clear();
+        batch.sequences.clear();
+        batch.ended.clear();
+    }
+
+    size_t getActiveTrips() const {
+        return activeTrips.load();
+    }
+
+    size_t capacity() const {
+        return slots.size();
+    }
+};
+
+#endif
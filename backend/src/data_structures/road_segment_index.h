@@ -0,0 +1,247 @@
+#ifndef ROAD_SEGMENT_INDEX_H
+#define ROAD_SEGMENT_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "csr_graph.h"
+#include "geo.h"
+using namespace std;
+
+#define SEGMENT_INDEX_DEFAULT_CELL_KM 0.25
+
+// A road arc near a GPS fix. The closest point of the arc lies `fraction`
+// of the way from its start vertex, `distanceKm` away from the fix.
+struct SegmentCandidate {
+    int arc;
+    double fraction;
+    double distanceKm;
+};
+
+// Spatial index over the arcs (directed road segments) of a CSRGraph, for
+// map matching: "which roads pass within r km of this GPS fix?".
+//
+// Every arc with coordinates on both ends is registered in each grid cell
+// its straight line crosses, so long highway segments cost one entry per
+// cell instead of one per cell of their bounding box. The cells are kept
+// as sorted keys with CSR-style offsets into one arc array - immutable once
+// built, so any number of threads can query the same index. Distances use
+// an equirectangular projection around the fix, which is exact enough at
+// road-segment scale; the grid assumes a regional network (it does not wrap
+// the antimeridian).
+//
+// The index keeps a pointer to the graph, which must outlive it.
+class RoadSegmentIndex {
+private:
+    const CSRGraph* graph;
+    vector<int> arcSources;
+    vector<double> arcLengths;      // km, INFINITY for arcs without coordinates
+    vector<uint64_t> cellKeys;      // Sorted, one per non-empty cell
+    vector<int> cellOffsets;        // Arcs of cellKeys[i]: cellArcs[cellOffsets[i] .. cellOffsets[i+1])
+    vector<int> cellArcs;
+    double cellLatDeg;
+    double cellLonDeg;
+    int indexedArcs;
+
+    static uint64_t cellKey(long long row, long long col) {
+        return ((uint64_t)row << 32) | (uint32_t)col;
+    }
+
+    long long rowOf(double lat) const {
+        return (long long)floor((lat + 90.0) / cellLatDeg);
+    }
+
+    long long colOf(double lon) const {
+        return (long long)floor((lon + 180.0) / cellLonDeg);
+    }
+
+    // Every cell the straight line a -> b passes through (grid traversal in
+    // cell units). When the line crosses exactly through a cell corner both
+    // side cells are added, so no cell touching the line is missed.
+    void traceCells(double latA, double lonA, double latB, double lonB, int arc,
+                    vector<pair<uint64_t, int>>& entries) const {
+        double x = (lonA + 180.0) / cellLonDeg, y = (latA + 90.0) / cellLatDeg;
+        double endX = (lonB + 180.0) / cellLonDeg, endY = (latB + 90.0) / cellLatDeg;
+        long long col = (long long)floor(x), row = (long long)floor(y);
+        long long lastCol = (long long)floor(endX), lastRow = (long long)floor(endY);
+        double dx = endX - x, dy = endY - y;
+        int stepX = dx > 0 ? 1 : -1, stepY = dy > 0 ? 1 : -1;
+        double tDeltaX = dx != 0 ? fabs(1.0 / dx) : INFINITY;
+        double tDeltaY = dy != 0 ? fabs(1.0 / dy) : INFINITY;
+        double tMaxX = dx != 0 ? ((stepX > 0 ? col + 1 - x : x - col) * tDeltaX) : INFINITY;
+        double tMaxY = dy != 0 ? ((stepY > 0 ? row + 1 - y : y - row) * tDeltaY) : INFINITY;
+
+        entries.push_back(make_pair(cellKey(row, col), arc));
+        long long remaining = llabs(lastCol - col) + llabs(lastRow - row);
+        while(remaining > 0) {
+            if(tMaxX < tMaxY) {
+                col += stepX;
+                tMaxX += tDeltaX;
+                remaining--;
+            } else if(tMaxY < tMaxX) {
+                row += stepY;
+                tMaxY += tDeltaY;
+                remaining--;
+            } else {
+                // Through a corner: both neighbours touch the line
+                entries.push_back(make_pair(cellKey(row, col + stepX), arc));
+                entries.push_back(make_pair(cellKey(row + stepY, col), arc));
+                col += stepX;
+                row += stepY;
+                tMaxX += tDeltaX;
+                tMaxY += tDeltaY;
+                remaining -= 2;
+            }
+            entries.push_back(make_pair(cellKey(row, col), arc));
+        }
+    }
+
+public:
+    RoadSegmentIndex(const CSRGraph& g, double cellKm = SEGMENT_INDEX_DEFAULT_CELL_KM) {
+        graph = &g;
+        indexedArcs = 0;
+        int n = g.getNumVertices();
+        int arcs = g.getNumArcs();
+
+        // Longitude cells are sized at the network's mean latitude
+        double latSum = 0;
+        int withCoordinates = 0;
+        for(int v = 0; v < n; v++) {
+            if(g.hasCoordinates(v)) {
+                latSum += g.latitude(v);
+                withCoordinates++;
+            }
+        }
+        double meanLat = withCoordinates > 0 ? latSum / withCoordinates : 0.0;
+        double cosLat = cos(meanLat * DEGREES_TO_RADIANS);
+        if(cosLat < 0.01) cosLat = 0.01;
+        cellLatDeg = cellKm / KM_PER_DEGREE;
+        cellLonDeg = cellLatDeg / cosLat;
+
+        arcSources.assign(arcs, -1);
+        arcLengths.assign(arcs, INFINITY);
+        vector<pair<uint64_t, int>> entries;
+        entries.reserve(arcs * 2);
+        for(int u = 0; u < n; u++) {
+            for(int a = g.arcBegin(u); a < g.arcEnd(u); a++) {
+                int v = g.arcTarget(a);
+                arcSources[a] = u;
+                if(!g.hasCoordinates(u) || !g.hasCoordinates(v)) continue;
+                arcLengths[a] = haversineKm(g.latitude(u), g.longitude(u), g.latitude(v), g.longitude(v));
+                traceCells(g.latitude(u), g.longitude(u), g.latitude(v), g.longitude(v), a, entries);
+                indexedArcs++;
+            }
+        }
+
+        sort(entries.begin(), entries.end());
+        entries.erase(unique(entries.begin(), entries.end()), entries.end());
+        cellArcs.resize(entries.size());
+        for(size_t i = 0; i < entries.size(); i++) {
+            if(i == 0 || entries[i].first != entries[i - 1].first) {
+                cellKeys.push_back(entries[i].first);
+                cellOffsets.push_back((int)i);
+            }
+            cellArcs[i] = entries[i].second;
+        }
+        cellOffsets.push_back((int)entries.size());
+    }
+
+    RoadSegmentIndex(const RoadSegmentIndex&) = delete;
+    RoadSegmentIndex& operator=(const RoadSegmentIndex&) = delete;
+
+    // Up to maxCandidates arcs within radiusKm of (lat, lon), nearest
+    // first. Thread-safe; out is the caller's reusable buffer.
+    void candidates(double lat, double lon, double radiusKm, size_t maxCandidates,
+                    vector<SegmentCandidate>& out) const {
+        out.clear();
+        if(cellKeys.empty()) return;
+
+        double kmPerDegLon = KM_PER_DEGREE * cos(lat * DEGREES_TO_RADIANS);
+        double padLat = radiusKm / KM_PER_DEGREE;
+        double padLon = kmPerDegLon > 1e-9 ? radiusKm / kmPerDegLon : 180.0;
+        long long rowLow = rowOf(lat - padLat), rowHigh = rowOf(lat + padLat);
+        long long colLow = colOf(lon - padLon), colHigh = colOf(lon + padLon);
+        if(rowLow < 0) rowLow = 0;
+        if(colLow < 0) colLow = 0;
+
+        for(long long row = rowLow; row <= rowHigh; row++) {
+            // Keys of one row are contiguous and sorted by column
+            uint64_t low = cellKey(row, colLow), high = cellKey(row, colHigh);
+            size_t c = lower_bound(cellKeys.begin(), cellKeys.end(), low) - cellKeys.begin();
+            for(; c < cellKeys.size() && cellKeys[c] <= high; c++) {
+                for(int i = cellOffsets[c]; i < cellOffsets[c + 1]; i++) {
+                    out.push_back(SegmentCandidate{cellArcs[i], 0.0, 0.0});
+                }
+            }
+        }
+
+        // An arc crossing several of the cells shows up once per cell
+        sort(out.begin(), out.end(), [](const SegmentCandidate& a, const SegmentCandidate& b) {
+            return a.arc < b.arc;
+        });
+        out.erase(unique(out.begin(), out.end(), [](const SegmentCandidate& a, const SegmentCandidate& b) {
+            return a.arc == b.arc;
+        }), out.end());
+        size_t kept = 0;
+        for(size_t i = 0; i < out.size(); i++) {
+            SegmentCandidate c = out[i];
+            project(c.arc, lat, lon, kmPerDegLon, c.fraction, c.distanceKm);
+            if(c.distanceKm <= radiusKm) out[kept++] = c;
+        }
+        out.resize(kept);
+
+        sort(out.begin(), out.end(), [](const SegmentCandidate& a, const SegmentCandidate& b) {
+            return a.distanceKm < b.distanceKm || (a.distanceKm == b.distanceKm && a.arc < b.arc);
+        });
+        if(out.size() > maxCandidates) out.resize(maxCandidates);
+    }
+
+    // Closest point of an arc to (lat, lon) in the local projection
+    void project(int arc, double lat, double lon, double kmPerDegLon, double& fraction, double& distanceKm) const {
+        int u = arcSources[arc], v = graph->arcTarget(arc);
+        double ax = (graph->longitude(u) - lon) * kmPerDegLon, ay = (graph->latitude(u) - lat) * KM_PER_DEGREE;
+        double bx = (graph->longitude(v) - lon) * kmPerDegLon, by = (graph->latitude(v) - lat) * KM_PER_DEGREE;
+        double dx = bx - ax, dy = by - ay;
+        double lengthSq = dx * dx + dy * dy;
+        double t = lengthSq > 0 ? -(ax * dx + ay * dy) / lengthSq : 0.0;
+        if(t < 0) t = 0;
+        if(t > 1) t = 1;
+        double px = ax + t * dx, py = ay + t * dy;
+        fraction = t;
+        distanceKm = sqrt(px * px + py * py);
+    }
+
+    const CSRGraph& getGraph() const {
+        return *graph;
+    }
+
+    int arcSource(int arc) const {
+        return arcSources[arc];
+    }
+
+    int arcTarget(int arc) const {
+        return graph->arcTarget(arc);
+    }
+
+    double arcLengthKm(int arc) const {
+        return arcLengths[arc];
+    }
+
+    int getIndexedArcs() const {
+        return indexedArcs;
+    }
+
+    void displayStats() const {
+        cout << "\n=== Road Segment Index Statistics ===" << endl;
+        cout << "Arcs indexed: " << indexedArcs << " of " << graph->getNumArcs() << endl;
+        cout << "Non-empty cells: " << cellKeys.size() << " (" << cellLatDeg * KM_PER_DEGREE << " km)" << endl;
+        if(!cellKeys.empty()) {
+            cout << "Avg arcs per cell: " << (double)cellArcs.size() / cellKeys.size() << endl;
+        }
+        cout << "=====================================\n" << endl;
+    }
+};
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+using namespace std;
+
+#define ROARING_CHUNK_BITS 65536
+#define ROARING_CHUNK_WORDS 1024        // 64-bit words per chunk
+#define ROARING_ARRAY_MAX 4096          // Above this a chunk is stored as a bitmap
+
+// Compressed set of 32-bit row numbers (Roaring layout).
+// Values are split by their high 16 bits into chunks of 65536. A chunk with
+// at most 4096 members is a sorted array of 16-bit offsets (2 bytes per
+// member); a denser chunk is a plain 8 KB bitmap. Empty chunks take no space.
+// AND/OR/AND-NOT work chunk by chunk and pick a merge, a probe or a word
+// loop depending on the two container kinds. Run-length containers are not
+// implemented - fleet query results are either sparse or scattered.
+class RoaringBitmap {
+private:
+    struct Container {
+        uint16_t key;                   // High 16 bits
+        uint32_t cardinality;
+        vector<uint16_t> array;         // Sorted, when !isBitmap()
+        vector<uint64_t> words;         // ROARING_CHUNK_WORDS, when isBitmap()
+
+        bool isBitmap() const {
+            return !words.empty();
+        }
+
+        bool contains(uint16_t low) const {
+            if(isBitmap()) return (words[low >> 6] >> (low & 63)) & 1;
+            return binary_search(array.begin(), array.end(), low);
+        }
+
+        void toWords(uint64_t* out) const {
+            if(isBitmap()) {
+                copy(words.begin(), words.end(), out);
+                return;
+            }
+            fill(out, out + ROARING_CHUNK_WORDS, 0);
+            for(size_t i = 0; i < array.size(); i++) {
+                out[array[i] >> 6] |= 1ULL << (array[i] & 63);
+            }
+        }
+    };
+
+    vector<Container> containers;       // Sorted by key
+
+    // Container from a full chunk of words; false if the chunk is empty
+    static bool fromChunkWords(uint16_t key, const uint64_t* words, size_t nWords, Container& c) {
+        uint32_t count = 0;
+        for(size_t w = 0; w < nWords; w++) {
+            count += (uint32_t)__builtin_popcountll(words[w]);
+        }
+        if(count == 0) return false;
+
+        c.key = key;
+        c.cardinality = count;
+        c.array.clear();
+        c.words.clear();
+        if(count > ROARING_ARRAY_MAX) {
+            c.words.assign(ROARING_CHUNK_WORDS, 0);
+            copy(words, words + nWords, c.words.begin());
+        } else {
+            c.array.reserve(count);
+            for(size_t w = 0; w < nWords; w++) {
+                uint64_t bits = words[w];
+                while(bits != 0) {
+                    c.array.push_back((uint16_t)(w * 64 + (size_t)__builtin_ctzll(bits)));
+                    bits &= bits - 1;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Index of the container for 'key', or where it would be inserted
+    size_t lowerBound(uint16_t key) const {
+        size_t lo = 0, hi = containers.size();
+        while(lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if(containers[mid].key < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    enum WordOp { WORD_AND, WORD_OR, WORD_ANDNOT };
+
+    static bool combine(const Container& a, const Container& b, WordOp op, Container& out) {
+        // Array-array: merge the two sorted lists
+        if(!a.isBitmap() && !b.isBitmap()) {
+            vector<uint16_t> merged;
+            if(op == WORD_AND) {
+                set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(merged));
+            } else if(op == WORD_OR) {
+                merged.reserve(a.array.size() + b.array.size());
+                set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(merged));
+            } else {
+                set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(merged));
+            }
+            if(merged.empty()) return false;
+            if(merged.size() <= ROARING_ARRAY_MAX) {
+                out.key = a.key;
+                out.cardinality = (uint32_t)merged.size();
+                out.array.swap(merged);
+                out.words.clear();
+                return true;
+            }
+            uint64_t words[ROARING_CHUNK_WORDS] = {0};
+            for(size_t i = 0; i < merged.size(); i++) {
+                words[merged[i] >> 6] |= 1ULL << (merged[i] & 63);
+            }
+            return fromChunkWords(a.key, words, ROARING_CHUNK_WORDS, out);
+        }
+
+        // Sparse side probes the bitmap side; the result stays sparse
+        if(op == WORD_AND && (!a.isBitmap() || !b.isBitmap())) {
+            const Container& sparse = a.isBitmap() ? b : a;
+            const Container& dense = a.isBitmap() ? a : b;
+            vector<uint16_t> kept;
+            for(size_t i = 0; i < sparse.array.size(); i++) {
+                if(dense.contains(sparse.array[i])) kept.push_back(sparse.array[i]);
+            }
+            if(kept.empty()) return false;
+            out.key = a.key;
+            out.cardinality = (uint32_t)kept.size();
+            out.array.swap(kept);
+            out.words.clear();
+            return true;
+        }
+        if(op == WORD_ANDNOT && !a.isBitmap()) {
+            vector<uint16_t> kept;
+            for(size_t i = 0; i < a.array.size(); i++) {
+                if(!b.contains(a.array[i])) kept.push_back(a.array[i]);
+            }
+            if(kept.empty()) return false;
+            out.key = a.key;
+            out.cardinality = (uint32_t)kept.size();
+            out.array.swap(kept);
+            out.words.clear();
+            return true;
+        }
+
+        // At least one bitmap: word loop
+        uint64_t left[ROARING_CHUNK_WORDS];
+        uint64_t right[ROARING_CHUNK_WORDS];
+        a.toWords(left);
+        b.toWords(right);
+        if(op == WORD_AND) {
+            for(size_t w = 0; w < ROARING_CHUNK_WORDS; w++) left[w] &= right[w];
+        } else if(op == WORD_OR) {
+            for(size_t w = 0; w < ROARING_CHUNK_WORDS; w++) left[w] |= right[w];
+        } else {
+            for(size_t w = 0; w < ROARING_CHUNK_WORDS; w++) left[w] &= ~right[w];
+        }
+        return fromChunkWords(a.key, left, ROARING_CHUNK_WORDS, out);
+    }
+
+    RoaringBitmap apply(const RoaringBitmap& other, WordOp op) const {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while(i < containers.size() || j < other.containers.size()) {
+            bool takeLeft = j == other.containers.size() ||
+                            (i < containers.size() && containers[i].key < other.containers[j].key);
+            bool takeRight = i == containers.size() ||
+                             (j < other.containers.size() && other.containers[j].key < containers[i].key);
+            if(takeLeft) {
+                if(op != WORD_AND) result.containers.push_back(containers[i]);
+                i++;
+            } else if(takeRight) {
+                if(op == WORD_OR) result.containers.push_back(other.containers[j]);
+                j++;
+            } else {
+                Container c;
+                if(combine(containers[i], other.containers[j], op, c)) result.containers.push_back(c);
+                i++;
+                j++;
+            }
+        }
+        return result;
+    }
+
+public:
+    RoaringBitmap() {
+    }
+
+    // Rows [0, n)
+    static RoaringBitmap range(uint32_t n) {
+        RoaringBitmap result;
+        uint64_t words[ROARING_CHUNK_WORDS];
+        for(uint64_t start = 0; start < n; start += ROARING_CHUNK_BITS) {
+            uint64_t count = min((uint64_t)ROARING_CHUNK_BITS, n - start);
+            fill(words, words + ROARING_CHUNK_WORDS, 0);
+            for(uint64_t w = 0; w < count / 64; w++) words[w] = ~0ULL;
+            if(count % 64 != 0) words[count / 64] = (1ULL << (count % 64)) - 1;
+            result.appendChunk((uint16_t)(start >> 16), words, ROARING_CHUNK_WORDS);
+        }
+        return result;
+    }
+
+    // Add a whole chunk from a dense bitmap of up to ROARING_CHUNK_WORDS
+    // words. Chunks must be appended in increasing key order.
+    void appendChunk(uint16_t key, const uint64_t* words, size_t nWords) {
+        Container c;
+        if(fromChunkWords(key, words, nWords, c)) containers.push_back(c);
+    }
+
+    void add(uint32_t value) {
+        uint16_t key = (uint16_t)(value >> 16);
+        uint16_t low = (uint16_t)(value & 0xFFFF);
+        size_t index = (!containers.empty() && containers.back().key == key) ? containers.size() - 1 : lowerBound(key);
+        if(index == containers.size() || containers[index].key != key) {
+            Container c;
+            c.key = key;
+            c.cardinality = 0;
+            containers.insert(containers.begin() + index, c);
+        }
+
+        Container& c = containers[index];
+        if(c.isBitmap()) {
+            uint64_t bit = 1ULL << (low & 63);
+            if((c.words[low >> 6] & bit) == 0) {
+                c.words[low >> 6] |= bit;
+                c.cardinality++;
+            }
+            return;
+        }
+        auto position = lower_bound(c.array.begin(), c.array.end(), low);
+        if(position != c.array.end() && *position == low) return;
+        c.array.insert(position, low);
+        c.cardinality++;
+        if(c.cardinality > ROARING_ARRAY_MAX) {
+            c.words.assign(ROARING_CHUNK_WORDS, 0);
+            for(size_t i = 0; i < c.array.size(); i++) {
+                c.words[c.array[i] >> 6] |= 1ULL << (c.array[i] & 63);
+            }
+            vector<uint16_t>().swap(c.array);
+        }
+    }
+
+    bool contains(uint32_t value) const {
+        size_t index = lowerBound((uint16_t)(value >> 16));
+        if(index == containers.size() || containers[index].key != (uint16_t)(value >> 16)) return false;
+        return containers[index].contains((uint16_t)(value & 0xFFFF));
+    }
+
+    size_t cardinality() const {
+        size_t total = 0;
+        for(size_t i = 0; i < containers.size(); i++) {
+            total += containers[i].cardinality;
+        }
+        return total;
+    }
+
+    bool isEmpty() const {
+        return containers.empty();
+    }
+
+    RoaringBitmap andWith(const RoaringBitmap& other) const {
+        return apply(other, WORD_AND);
+    }
+
+    RoaringBitmap orWith(const RoaringBitmap& other) const {
+        return apply(other, WORD_OR);
+    }
+
+    RoaringBitmap andNotWith(const RoaringBitmap& other) const {
+        return apply(other, WORD_ANDNOT);
+    }
+
+    // Chunk-level access, for scans restricted to an existing result
+    size_t getNumChunks() const {
+        return containers.size();
+    }
+
+    uint16_t chunkKey(size_t i) const {
+        return containers[i].key;
+    }
+
+    void chunkWords(size_t i, uint64_t* out) const {
+        containers[i].toWords(out);
+    }
+
+    // Members in increasing order
+    template <typename F>
+    void forEach(F visit) const {
+        for(size_t i = 0; i < containers.size(); i++) {
+            uint32_t high = (uint32_t)containers[i].key << 16;
+            const Container& c = containers[i];
+            if(!c.isBitmap()) {
+                for(size_t k = 0; k < c.array.size(); k++) visit(high | c.array[k]);
+                continue;
+            }
+            for(size_t w = 0; w < ROARING_CHUNK_WORDS; w++) {
+                uint64_t bits = c.words[w];
+                while(bits != 0) {
+                    visit(high | (uint32_t)(w * 64 + (size_t)__builtin_ctzll(bits)));
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    void toVector(vector<uint32_t>& out) const {
+        out.clear();
+        out.reserve(cardinality());
+        forEach([&](uint32_t value) { out.push_back(value); });
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = containers.capacity() * sizeof(Container);
+        for(size_t i = 0; i < containers.size(); i++) {
+            bytes += containers[i].array.capacity() * sizeof(uint16_t) + containers[i].words.capacity() * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+};
+
+#endif
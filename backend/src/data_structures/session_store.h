@@ -0,0 +1,429 @@
+#ifndef SESSION_STORE_H
+#define SESSION_STORE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <cstring>
+#include "../core/user.h"
+using namespace std;
+
+#define SESSION_SHARDS 64                   // Power of two
+#define SESSION_SHARD_INITIAL_SLOTS 64      // Power of two; a shard's table doubles past half full
+#define SESSION_WHEEL_SLOTS 512
+#define SESSION_TICK_SECONDS 60             // Wheel granularity
+#define SESSION_DEFAULT_TTL (8 * 3600)      // One shift
+#define SESSION_TOKEN_CHARS 32
+
+// 128 random bits; the token string is their hex form
+struct SessionKey {
+    uint64_t hi;
+    uint64_t lo;
+
+    bool operator==(const SessionKey& other) const {
+        return hi == other.hi && lo == other.lo;
+    }
+};
+
+// Opaque session tokens for authenticated requests.
+// Sessions are spread over 64 shards by token bits. Each shard is a flat
+// open-addressing table (linear probing on the token's own random bits,
+// backward-shift deletes) behind a seqlock: validate() reads the sequence,
+// probes a few adjacent slots and re-reads the sequence - no lock and no
+// shared write, so readers never contend with each other, and there is no
+// global lock on the request path. Writers (issue, revoke, expiry) take
+// the shard's mutex. A table replaced by a larger one stays allocated until
+// the store is destroyed, as a reader may still be probing it; together the
+// old tables are smaller than the live one. Expiry is checked on
+// every validate(); a timer wheel (512 slots of 60 s) lets advance() drop
+// expired sessions without scanning all of them. A per-user token list,
+// touched only on issue/logout/revoke, makes revokeUser() proportional to
+// that user's own sessions.
+class SessionStore {
+private:
+    // Fields are atomics only so that a validate() racing a writer is
+    // well-defined; the seqlock decides whether what it read counts
+    struct Slot {
+        atomic<uint64_t> hi;
+        atomic<uint64_t> lo;
+        atomic<User*> user;             // NULL = empty slot
+        atomic<uint64_t> expiresAt;     // Seconds on the store's clock
+    };
+
+    struct SlotTable {
+        uint64_t mask;
+        vector<Slot> slots;
+
+        SlotTable(size_t size) : slots(size) {
+            mask = size - 1;
+            for(Slot& s : slots) {
+                s.hi.store(0, memory_order_relaxed);
+                s.lo.store(0, memory_order_relaxed);
+                s.user.store(NULL, memory_order_relaxed);
+                s.expiresAt.store(0, memory_order_relaxed);
+            }
+        }
+    };
+
+    struct alignas(64) Shard {
+        atomic<uint32_t> sequence;      // Odd while a writer is changing the table
+        atomic<SlotTable*> table;
+        mutable mutex writeLock;
+        size_t count;
+        vector<unique_ptr<SlotTable> > tables;     // Live table last
+    };
+
+    struct WheelEntry {
+        SessionKey key;
+        uint64_t expiresAt;
+    };
+
+    Shard shards[SESSION_SHARDS];
+
+    mutex wheelLock;
+    vector<WheelEntry> wheel[SESSION_WHEEL_SLOTS];
+    uint64_t wheelTick;         // Latest tick advance() has reached
+
+    mutex userLock;
+    unordered_map<User*, vector<SessionKey> > userSessions;
+
+    uint64_t ttlSeconds;
+    uint64_t epochSeconds;
+
+    Shard& shardOf(const SessionKey& key) {
+        return shards[key.lo & (SESSION_SHARDS - 1)];
+    }
+
+    // Monotonic seconds. The coarse clock (tick resolution) is enough for
+    // expiry and costs a few ns instead of a full clock read per validate().
+    static uint64_t clockSeconds() {
+#ifdef CLOCK_MONOTONIC_COARSE
+        timespec ts;
+        if(clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0) return (uint64_t)ts.tv_sec;
+#endif
+        return (uint64_t)chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // Writers hold the shard's writeLock around a begin/end pair
+    static void writeBegin(Shard& shard) {
+        shard.sequence.store(shard.sequence.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    static void writeEnd(Shard& shard) {
+        shard.sequence.store(shard.sequence.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+    // Slot holding 'key', or of the empty slot ending its probe chain
+    static uint64_t probe(const SlotTable& t, const SessionKey& key) {
+        uint64_t i = key.hi & t.mask;
+        while(t.slots[i].user.load(memory_order_relaxed) != NULL &&
+              !(t.slots[i].hi.load(memory_order_relaxed) == key.hi && t.slots[i].lo.load(memory_order_relaxed) == key.lo)) {
+            i = (i + 1) & t.mask;
+        }
+        return i;
+    }
+
+    static void copySlot(Slot& to, const Slot& from) {
+        to.hi.store(from.hi.load(memory_order_relaxed), memory_order_relaxed);
+        to.lo.store(from.lo.load(memory_order_relaxed), memory_order_relaxed);
+        to.expiresAt.store(from.expiresAt.load(memory_order_relaxed), memory_order_relaxed);
+        to.user.store(from.user.load(memory_order_relaxed), memory_order_relaxed);
+    }
+
+    // Caller is inside writeBegin/writeEnd. The old table is kept for
+    // readers that loaded it before the switch.
+    static void grow(Shard& shard) {
+        const SlotTable& old = *shard.tables.back();
+        unique_ptr<SlotTable> larger(new SlotTable(old.slots.size() * 2));
+        for(const Slot& s : old.slots) {
+            if(s.user.load(memory_order_relaxed) == NULL) continue;
+            SessionKey key{s.hi.load(memory_order_relaxed), s.lo.load(memory_order_relaxed)};
+            copySlot(larger->slots[probe(*larger, key)], s);
+        }
+        shard.table.store(larger.get(), memory_order_release);
+        shard.tables.push_back(move(larger));
+    }
+
+    // Empty slot i and pull later entries of its probe run back over it,
+    // so chains never hold a gap. Caller is inside writeBegin/writeEnd.
+    static void eraseSlot(SlotTable& t, uint64_t i) {
+        uint64_t j = i;
+        while(true) {
+            j = (j + 1) & t.mask;
+            if(t.slots[j].user.load(memory_order_relaxed) == NULL) break;
+            uint64_t home = t.slots[j].hi.load(memory_order_relaxed) & t.mask;
+            // Move j back unless its home lies cyclically in (i, j]
+            bool stays = i <= j ? (home > i && home <= j) : (home > i || home <= j);
+            if(stays) continue;
+            copySlot(t.slots[i], t.slots[j]);
+            i = j;
+        }
+        t.slots[i].user.store(NULL, memory_order_relaxed);
+    }
+
+    // Eight token characters -> 32 bits, eight at a time in one word (SWAR).
+    // false unless every byte is 0-9 or a-f. Branch-free: token digits are
+    // random, so per-character branches would mispredict.
+    static bool parseHex8(const char* p, uint32_t& out) {
+        const uint64_t ones = 0x0101010101010101ULL;
+        const uint64_t high = 0x8080808080808080ULL;
+        uint64_t x;
+        memcpy(&x, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        x = __builtin_bswap64(x);       // First character in the low byte
+#endif
+        // Per byte (all below 0x80): bit 7 of x + (0x80 - lo) is x >= lo,
+        // bit 7 of x + (0x7F - hi) is x > hi
+        uint64_t digit = (x + (0x80 - '0') * ones) & ~(x + (0x7F - '9') * ones);
+        uint64_t letter = (x + (0x80 - 'a') * ones) & ~(x + (0x7F - 'f') * ones);
+        bool valid = (((digit | letter) & high) == high) & ((x & high) == 0);
+
+        // '0'-'9' -> low nibble; 'a'-'f' -> low nibble (1-6) + 9
+        uint64_t v = (x & 0x0F0F0F0F0F0F0F0FULL) + ((x >> 6) & ones) * 9;
+        v = ((v & 0x000F000F000F000FULL) << 4) | ((v >> 8) & 0x000F000F000F000FULL);   // Byte pairs
+        v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+        v = (v | (v >> 16)) & 0xFFFFFFFFULL;
+        out = __builtin_bswap32((uint32_t)v);     // First character most significant
+        return valid;
+    }
+
+    // Lowercase hex only
+    static bool parseToken(string_view token, SessionKey& key) {
+        if(token.size() != SESSION_TOKEN_CHARS) return false;
+        uint32_t w[4];
+        bool valid = parseHex8(token.data(), w[0]) & parseHex8(token.data() + 8, w[1]) &
+                     parseHex8(token.data() + 16, w[2]) & parseHex8(token.data() + 24, w[3]);
+        key.hi = (uint64_t)w[0] << 32 | w[1];
+        key.lo = (uint64_t)w[2] << 32 | w[3];
+        return valid;
+    }
+
+    static string formatToken(const SessionKey& key) {
+        static const char digits[] = "0123456789abcdef";
+        string token(SESSION_TOKEN_CHARS, '0');
+        for(int i = 0; i < 16; i++) {
+            token[i] = digits[(key.hi >> (60 - 4 * i)) & 15];
+            token[16 + i] = digits[(key.lo >> (60 - 4 * i)) & 15];
+        }
+        return token;
+    }
+
+    static SessionKey randomKey() {
+        thread_local random_device device;
+        SessionKey key;
+        key.hi = ((uint64_t)device() << 32) | device();
+        key.lo = ((uint64_t)device() << 32) | device();
+        return key;
+    }
+
+    void forgetUserSession(User* user, const SessionKey& key) {
+        lock_guard<mutex> lock(userLock);
+        auto it = userSessions.find(user);
+        if(it == userSessions.end()) return;
+        vector<SessionKey>& keys = it->second;
+        for(size_t i = 0; i < keys.size(); i++) {
+            if(keys[i] == key) {
+                keys[i] = keys.back();
+                keys.pop_back();
+                break;
+            }
+        }
+        if(keys.empty()) userSessions.erase(it);
+    }
+
+    // Remove one session; returns its user (NULL if it was not there)
+    User* eraseSession(const SessionKey& key, uint64_t onlyIfExpiresAt = 0) {
+        Shard& shard = shardOf(key);
+        lock_guard<mutex> lock(shard.writeLock);
+        SlotTable& t = *shard.tables.back();
+        uint64_t i = probe(t, key);
+        User* user = t.slots[i].user.load(memory_order_relaxed);
+        if(user == NULL) return NULL;
+        if(onlyIfExpiresAt != 0 && t.slots[i].expiresAt.load(memory_order_relaxed) != onlyIfExpiresAt) return NULL;
+        writeBegin(shard);
+        eraseSlot(t, i);
+        writeEnd(shard);
+        shard.count--;
+        return user;
+    }
+
+public:
+    SessionStore(uint64_t ttl = SESSION_DEFAULT_TTL) {
+        ttlSeconds = ttl;
+        epochSeconds = clockSeconds();
+        wheelTick = 0;
+        for(Shard& shard : shards) {
+            shard.sequence.store(0, memory_order_relaxed);
+            shard.count = 0;
+            shard.tables.emplace_back(new SlotTable(SESSION_SHARD_INITIAL_SLOTS));
+            shard.table.store(shard.tables.back().get(), memory_order_release);
+        }
+    }
+
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // Seconds since the store was created
+    uint64_t now() const {
+        return clockSeconds() - epochSeconds;
+    }
+
+    // New token for an authenticated user
+    string issue(User* user, uint64_t at) {
+        SessionKey key = randomKey();
+        uint64_t expiresAt = at + ttlSeconds;
+        {
+            Shard& shard = shardOf(key);
+            lock_guard<mutex> lock(shard.writeLock);
+            writeBegin(shard);
+            if((shard.count + 1) * 2 > shard.tables.back()->slots.size()) grow(shard);
+            SlotTable& t = *shard.tables.back();
+            Slot& slot = t.slots[probe(t, key)];
+            if(slot.user.load(memory_order_relaxed) == NULL) shard.count++;
+            slot.hi.store(key.hi, memory_order_relaxed);
+            slot.lo.store(key.lo, memory_order_relaxed);
+            slot.expiresAt.store(expiresAt, memory_order_relaxed);
+            slot.user.store(user, memory_order_relaxed);
+            writeEnd(shard);
+        }
+        {
+            lock_guard<mutex> lock(wheelLock);
+            wheel[(expiresAt / SESSION_TICK_SECONDS) % SESSION_WHEEL_SLOTS].push_back(
+                WheelEntry{key, expiresAt});
+        }
+        {
+            lock_guard<mutex> lock(userLock);
+            userSessions[user].push_back(key);
+        }
+        return formatToken(key);
+    }
+
+    string issue(User* user) {
+        return issue(user, now());
+    }
+
+    // User for a live token, NULL if unknown, malformed, revoked or expired.
+    // Lock-free: retried only if a writer changed the shard meanwhile.
+    User* validate(string_view token, uint64_t at) const {
+        SessionKey key;
+        if(!parseToken(token, key)) return NULL;
+        const Shard& shard = shards[key.lo & (SESSION_SHARDS - 1)];
+        while(true) {
+            uint32_t before = shard.sequence.load(memory_order_acquire);
+            if(before & 1) {
+                cpuRelax();
+                continue;
+            }
+            const SlotTable& t = *shard.table.load(memory_order_acquire);
+            User* user = NULL;
+            uint64_t expiresAt = 0;
+            // Bounded: a torn view of a shifting chain must not spin forever
+            for(uint64_t i = key.hi & t.mask, probes = 0; probes <= t.mask; i = (i + 1) & t.mask, probes++) {
+                const Slot& s = t.slots[i];
+                User* u = s.user.load(memory_order_relaxed);
+                if(u == NULL) break;
+                if(s.hi.load(memory_order_relaxed) == key.hi && s.lo.load(memory_order_relaxed) == key.lo) {
+                    user = u;
+                    expiresAt = s.expiresAt.load(memory_order_relaxed);
+                    break;
+                }
+            }
+            atomic_thread_fence(memory_order_acquire);
+            if(shard.sequence.load(memory_order_relaxed) == before) {
+                return expiresAt > at ? user : NULL;
+            }
+        }
+    }
+
+    User* validate(string_view token) const {
+        return validate(token, now());
+    }
+
+    bool revoke(string_view token) {
+        SessionKey key;
+        if(!parseToken(token, key)) return false;
+        User* user = eraseSession(key);
+        if(user == NULL) return false;
+        forgetUserSession(user, key);
+        return true;
+    }
+
+    // End every session of one user; returns how many were ended
+    int revokeUser(User* user) {
+        vector<SessionKey> keys;
+        {
+            lock_guard<mutex> lock(userLock);
+            auto it = userSessions.find(user);
+            if(it == userSessions.end()) return 0;
+            keys.swap(it->second);
+            userSessions.erase(it);
+        }
+        int revoked = 0;
+        for(size_t i = 0; i < keys.size(); i++) {
+            if(eraseSession(keys[i]) != NULL) revoked++;
+        }
+        return revoked;
+    }
+
+    // Drop sessions that expired up to 'at'; returns how many were dropped.
+    // Call periodically (e.g. once per tick from a housekeeping thread).
+    int advance(uint64_t at) {
+        vector<WheelEntry> due;
+        {
+            lock_guard<mutex> lock(wheelLock);
+            uint64_t target = at / SESSION_TICK_SECONDS;
+            uint64_t first = wheelTick;     // Revisit it: part of that tick may not be due yet
+            if(target >= first + SESSION_WHEEL_SLOTS) first = target - SESSION_WHEEL_SLOTS + 1;
+            for(uint64_t tick = first; tick <= target; tick++) {
+                vector<WheelEntry>& slot = wheel[tick % SESSION_WHEEL_SLOTS];
+                size_t keep = 0;
+                for(size_t i = 0; i < slot.size(); i++) {
+                    if(slot[i].expiresAt <= at) due.push_back(slot[i]);
+                    else slot[keep++] = slot[i];    // Later lap of the wheel
+                }
+                slot.resize(keep);
+            }
+            if(target > wheelTick) wheelTick = target;
+        }
+
+        int dropped = 0;
+        for(size_t i = 0; i < due.size(); i++) {
+            User* user = eraseSession(due[i].key, due[i].expiresAt);
+            if(user != NULL) {
+                forgetUserSession(user, due[i].key);
+                dropped++;
+            }
+        }
+        return dropped;
+    }
+
+    int advance() {
+        return advance(now());
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for(int s = 0; s < SESSION_SHARDS; s++) {
+            lock_guard<mutex> lock(shards[s].writeLock);
+            total += shards[s].count;
+        }
+        return total;
+    }
+};
+
+#endif
@@ -0,0 +1,370 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "vehicle.h"
+#include "geo.h"
+using namespace std;
+
+#define SPATIAL_DEFAULT_CELL_KM 1.0
+
+struct SpatialMatch {
+    string vehicleId;
+    double distanceKm;
+    double latitude;
+    double longitude;
+};
+
+// Live vehicle positions bucketed into a uniform lat/lon grid.
+// Only non-empty cells are stored (hashed by row/column), so the grid can
+// span the globe while a city fleet touches a few thousand cells. Each
+// point also keeps its unit-sphere vector: chord length grows with
+// great-circle distance, so candidates are compared with three
+// multiply-adds and only the final answers are converted to km - the same
+// distances haversineKm() gives. Moves within a cell update in place;
+// crossing a cell is an O(1) swap-remove plus append.
+//
+// nearest() searches rings of cells outward from the query and stops once
+// a great-circle lower bound on everything outside the searched box is
+// above the k-th best distance. Status is stored per point and filtered
+// with a VEHICLE_STATUS_BIT mask while scanning; callers mirror status
+// changes with setStatus().
+class SpatialGrid {
+private:
+    struct GridPoint {
+        double x, y, z;
+        uint32_t handle;
+        uint8_t status;
+    };
+
+    struct Entry {
+        string vehicleId;
+        double latitude;
+        double longitude;
+        uint64_t cell;
+        uint32_t slot;          // Index in the cell's point list
+        bool live;
+    };
+
+    double cellKm;
+    double cellDegrees;
+    int64_t rows;
+    int64_t cols;
+    unordered_map<uint64_t, vector<GridPoint>> cells;
+    vector<Entry> entries;
+    vector<uint32_t> freeHandles;
+    unordered_map<string, uint32_t> handles;
+
+    int64_t rowOf(double lat) const {
+        int64_t r = (int64_t)floor((lat + 90.0) / cellDegrees);
+        return r < 0 ? 0 : (r >= rows ? rows - 1 : r);
+    }
+
+    // Column of a longitude, plus how far (degrees) into the column it is
+    int64_t colOf(double lon, double* offset = NULL) const {
+        double shifted = fmod(lon + 180.0, 360.0);
+        if(shifted < 0) shifted += 360.0;
+        int64_t c = (int64_t)floor(shifted / cellDegrees);
+        if(c >= cols) c = cols - 1;
+        if(offset != NULL) *offset = shifted - c * cellDegrees;
+        return c;
+    }
+
+    uint64_t cellKey(int64_t row, int64_t col) const {
+        return (uint64_t)row * (uint64_t)cols + (uint64_t)col;
+    }
+
+    static void toUnit(double lat, double lon, double& x, double& y, double& z) {
+        double phi = lat * DEGREES_TO_RADIANS, lambda = lon * DEGREES_TO_RADIANS;
+        x = cos(phi) * cos(lambda);
+        y = cos(phi) * sin(lambda);
+        z = sin(phi);
+    }
+
+    static double chordToKm(double chord2) {
+        double half = sqrt(chord2) / 2;
+        return 2.0 * EARTH_RADIUS_KM * asin(half < 1.0 ? half : 1.0);
+    }
+
+    static double kmToChord2(double km) {
+        if(!(km < 180.0 * KM_PER_DEGREE)) return 4.0;
+        double c = 2.0 * sin(km / (2.0 * EARTH_RADIUS_KM));
+        return c * c;
+    }
+
+    void place(uint32_t handle, uint8_t status) {
+        Entry& e = entries[handle];
+        GridPoint p;
+        toUnit(e.latitude, e.longitude, p.x, p.y, p.z);
+        p.handle = handle;
+        p.status = status;
+        e.cell = cellKey(rowOf(e.latitude), colOf(e.longitude));
+        vector<GridPoint>& points = cells[e.cell];
+        e.slot = (uint32_t)points.size();
+        points.push_back(p);
+    }
+
+    // Returns the point's status
+    uint8_t unplace(uint32_t handle) {
+        Entry& e = entries[handle];
+        auto it = cells.find(e.cell);
+        vector<GridPoint>& points = it->second;
+        uint8_t status = points[e.slot].status;
+        points[e.slot] = points.back();
+        entries[points[e.slot].handle].slot = e.slot;
+        points.pop_back();
+        if(points.empty()) cells.erase(it);
+        return status;
+    }
+
+    GridPoint& pointOf(uint32_t handle) {
+        const Entry& e = entries[handle];
+        return cells.find(e.cell)->second[e.slot];
+    }
+
+    static bool validPosition(double lat, double lon) {
+        return lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0;
+    }
+
+    void collect(vector<pair<double, uint32_t>>& found, vector<SpatialMatch>& out) const {
+        sort(found.begin(), found.end());
+        out.clear();
+        out.reserve(found.size());
+        for(const auto& f : found) {
+            const Entry& e = entries[f.second];
+            out.push_back(SpatialMatch{e.vehicleId, chordToKm(f.first), e.latitude, e.longitude});
+        }
+    }
+
+public:
+    SpatialGrid(double cellSizeKm = SPATIAL_DEFAULT_CELL_KM) {
+        // Columns must tile 360 degrees exactly or rings across the
+        // antimeridian would be narrower than the bounds assume
+        cols = (int64_t)ceil(360.0 / ((cellSizeKm > 0.01 ? cellSizeKm : 0.01) / KM_PER_DEGREE));
+        cellDegrees = 360.0 / cols;
+        cellKm = cellDegrees * KM_PER_DEGREE;
+        rows = (int64_t)ceil(180.0 / cellDegrees);
+    }
+
+    // Add a vehicle or move it (and update its status)
+    bool upsert(const string& vehicleId, double lat, double lon, VehicleStatus status) {
+        if(!validPosition(lat, lon)) {
+            cout << "❌ Invalid position for " << vehicleId << ": (" << lat << ", " << lon << ")" << endl;
+            return false;
+        }
+        auto it = handles.find(vehicleId);
+        if(it != handles.end()) {
+            if(!updatePosition(vehicleId, lat, lon)) return false;
+            return setStatus(vehicleId, status);
+        }
+
+        uint32_t handle;
+        if(!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        } else {
+            handle = (uint32_t)entries.size();
+            entries.push_back(Entry());
+        }
+        Entry& e = entries[handle];
+        e.vehicleId = vehicleId;
+        e.latitude = lat;
+        e.longitude = lon;
+        e.live = true;
+        place(handle, (uint8_t)status);
+        handles[vehicleId] = handle;
+        return true;
+    }
+
+    // Incremental move; stays in place when the cell does not change
+    bool updatePosition(const string& vehicleId, double lat, double lon) {
+        auto it = handles.find(vehicleId);
+        if(it == handles.end() || !validPosition(lat, lon)) return false;
+        uint32_t handle = it->second;
+        Entry& e = entries[handle];
+        e.latitude = lat;
+        e.longitude = lon;
+        if(cellKey(rowOf(lat), colOf(lon)) == e.cell) {
+            GridPoint& p = pointOf(handle);
+            toUnit(lat, lon, p.x, p.y, p.z);
+        } else {
+            place(handle, unplace(handle));
+        }
+        return true;
+    }
+
+    bool setStatus(const string& vehicleId, VehicleStatus status) {
+        auto it = handles.find(vehicleId);
+        if(it == handles.end()) return false;
+        pointOf(it->second).status = (uint8_t)status;
+        return true;
+    }
+
+    bool remove(const string& vehicleId) {
+        auto it = handles.find(vehicleId);
+        if(it == handles.end()) return false;
+        uint32_t handle = it->second;
+        unplace(handle);
+        entries[handle].live = false;
+        entries[handle].vehicleId.clear();
+        freeHandles.push_back(handle);
+        handles.erase(it);
+        return true;
+    }
+
+    bool getPosition(const string& vehicleId, double& lat, double& lon) const {
+        auto it = handles.find(vehicleId);
+        if(it == handles.end()) return false;
+        lat = entries[it->second].latitude;
+        lon = entries[it->second].longitude;
+        return true;
+    }
+
+    // k closest vehicles whose status is in statusMask, nearest first
+    size_t nearest(double lat, double lon, size_t k, uint32_t statusMask, vector<SpatialMatch>& out,
+                   double maxKm = INFINITY) const {
+        out.clear();
+        if(k == 0 || cells.empty() || !validPosition(lat, lon)) return 0;
+
+        double qx, qy, qz;
+        toUnit(lat, lon, qx, qy, qz);
+        double limit = kmToChord2(maxKm);
+        vector<pair<double, uint32_t>> best;     // Max-heap on chord^2
+        auto scan = [&](const vector<GridPoint>& points) {
+            for(const GridPoint& p : points) {
+                if(!(statusMask & VEHICLE_STATUS_BIT(p.status))) continue;
+                double dx = p.x - qx, dy = p.y - qy, dz = p.z - qz;
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if(d2 > limit) continue;
+                if(best.size() < k) {
+                    best.push_back(make_pair(d2, p.handle));
+                    push_heap(best.begin(), best.end());
+                } else if(d2 < best.front().first) {
+                    pop_heap(best.begin(), best.end());
+                    best.back() = make_pair(d2, p.handle);
+                    push_heap(best.begin(), best.end());
+                }
+            }
+        };
+
+        double colOffset;
+        int64_t row0 = rowOf(lat), col0 = colOf(lon, &colOffset);
+        for(int64_t r = 0; ; r++) {
+            // A ring with more cells than the grid has is slower than a full scan
+            if(r > 0 && ((uint64_t)(8 * r) > cells.size() || 2 * r + 1 >= cols)) {
+                best.clear();
+                for(const auto& cell : cells) scan(cell.second);
+                break;
+            }
+            for(int64_t dy = -r; dy <= r; dy++) {
+                int64_t row = row0 + dy;
+                if(row < 0 || row >= rows) continue;
+                int64_t step = (dy == -r || dy == r) ? 1 : 2 * r;
+                for(int64_t dx = -r; dx <= r; dx += (step > 0 ? step : 1)) {
+                    int64_t col = ((col0 + dx) % cols + cols) % cols;
+                    auto cell = cells.find(cellKey(row, col));
+                    if(cell != cells.end()) scan(cell->second);
+                }
+            }
+
+            // Lower bound on the distance to anything outside the searched box
+            bool full = best.size() == k;
+            double kth = full ? chordToKm(best.front().first) : maxKm;
+            if(!(kth < INFINITY)) continue;
+            double latLo = (row0 - r) * cellDegrees - 90.0, latHi = (row0 + r + 1) * cellDegrees - 90.0;
+            double dLat = min(latLo <= -90.0 ? INFINITY : lat - latLo, latHi >= 90.0 ? INFINITY : latHi - lat);
+            double dLon = min(colOffset + r * cellDegrees, (r + 1) * cellDegrees - colOffset);
+            double maxLat = min(90.0, fabs(lat) + kth / KM_PER_DEGREE);
+            double lonBound = dLon >= 180.0 ? INFINITY :
+                2.0 * EARTH_RADIUS_KM * asin(cos(maxLat * DEGREES_TO_RADIANS) * sin(dLon * DEGREES_TO_RADIANS / 2));
+            if(kth <= min(dLat * KM_PER_DEGREE, lonBound)) break;
+        }
+        collect(best, out);
+        return out.size();
+    }
+
+    // Every vehicle within radiusKm whose status is in statusMask, nearest first
+    size_t withinRadius(double lat, double lon, double radiusKm, uint32_t statusMask, vector<SpatialMatch>& out) const {
+        out.clear();
+        if(cells.empty() || !validPosition(lat, lon) || !(radiusKm >= 0)) return 0;
+
+        double qx, qy, qz;
+        toUnit(lat, lon, qx, qy, qz);
+        double limit = kmToChord2(radiusKm);
+        vector<pair<double, uint32_t>> found;
+        auto scan = [&](const vector<GridPoint>& points) {
+            for(const GridPoint& p : points) {
+                if(!(statusMask & VEHICLE_STATUS_BIT(p.status))) continue;
+                double dx = p.x - qx, dy = p.y - qy, dz = p.z - qz;
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if(d2 <= limit) found.push_back(make_pair(d2, p.handle));
+            }
+        };
+
+        // Bounding box: rows from the latitude span, columns from the widest
+        // longitude span a point within the radius can have
+        double dLat = radiusKm / KM_PER_DEGREE;
+        int64_t rowLo = rowOf(lat - dLat), rowHi = rowOf(lat + dLat);
+        double maxLat = min(90.0, fabs(lat) + dLat);
+        double ratio = sin(min(radiusKm / (2.0 * EARTH_RADIUS_KM), 90.0 * DEGREES_TO_RADIANS)) / cos(maxLat * DEGREES_TO_RADIANS);
+        double colOffset;
+        int64_t col0 = colOf(lon, &colOffset);
+        int64_t colLo = 0, colHi = cols - 1;
+        bool allCols = !(ratio < 1.0);
+        if(!allCols) {
+            double dLon = 2.0 * asin(ratio) / DEGREES_TO_RADIANS;
+            colLo = col0 + (int64_t)floor((colOffset - dLon) / cellDegrees);
+            colHi = col0 + (int64_t)floor((colOffset + dLon) / cellDegrees);
+            allCols = colHi - colLo + 1 >= cols;
+        }
+        if(allCols) {
+            colLo = 0;
+            colHi = cols - 1;
+        }
+
+        if((double)(rowHi - rowLo + 1) * (double)(colHi - colLo + 1) > (double)cells.size()) {
+            for(const auto& cell : cells) scan(cell.second);
+        } else {
+            for(int64_t row = rowLo; row <= rowHi; row++) {
+                for(int64_t c = colLo; c <= colHi; c++) {
+                    auto cell = cells.find(cellKey(row, (c % cols + cols) % cols));
+                    if(cell != cells.end()) scan(cell->second);
+                }
+            }
+        }
+        collect(found, out);
+        return out.size();
+    }
+
+    bool contains(const string& vehicleId) const {
+        return handles.count(vehicleId) != 0;
+    }
+
+    size_t size() const {
+        return handles.size();
+    }
+
+    size_t getCellCount() const {
+        return cells.size();
+    }
+
+    void displayStats() const {
+        cout << "\n=== Spatial Grid Statistics ===" << endl;
+        cout << "Vehicles: " << handles.size() << endl;
+        cout << "Cell size: " << cellKm << " km, occupied cells: " << cells.size() << endl;
+        if(!cells.empty()) {
+            size_t largest = 0;
+            for(const auto& cell : cells) largest = max(largest, cell.second.size());
+            cout << "Vehicles per cell: " << (double)handles.size() / cells.size() << " avg, " << largest << " max" << endl;
+        }
+        cout << "===============================\n" << endl;
+    }
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef STRING_HASH_H
+#define STRING_HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+using namespace std;
+
+// 64-bit string hash (MurmurHash64A). Every input byte affects every output
+// bit, so IDs like "V012" and "V021" land in unrelated slots.
+inline uint64_t hashString(string_view key, uint64_t seed = 0x9E3779B97F4A7C15ULL) {
+    const uint64_t m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+
+    size_t len = key.size();
+    const unsigned char* data = (const unsigned char*)key.data();
+    uint64_t h = seed ^ (len * m);
+
+    while(len >= 8) {
+        uint64_t k;
+        memcpy(&k, data, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+        data += 8;
+        len -= 8;
+    }
+
+    switch(len) {
+        case 7: h ^= (uint64_t)data[6] << 48; [[fallthrough]];
+        case 6: h ^= (uint64_t)data[5] << 40; [[fallthrough]];
+        case 5: h ^= (uint64_t)data[4] << 32; [[fallthrough]];
+        case 4: h ^= (uint64_t)data[3] << 24; [[fallthrough]];
+        case 3: h ^= (uint64_t)data[2] << 16; [[fallthrough]];
+        case 2: h ^= (uint64_t)data[1] << 8; [[fallthrough]];
+        case 1: h ^= (uint64_t)data[0];
+                h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+#endif
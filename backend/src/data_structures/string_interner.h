@@ -0,0 +1,89 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "string_hash.h"
+using namespace std;
+
+#define INTERN_NONE 0xFFFFFFFFu         // "No string" handle
+#define INTERN_INITIAL_SLOTS 64
+
+// Maps each distinct string to a dense 32-bit handle (0, 1, 2, ...).
+// Characters live back to back in one arena and the lookup table is open
+// addressing over handles, so a million IDs cost the characters plus about
+// 16 bytes each, with no per-string heap allocation.
+// A string_view from str() stays valid until the next intern() call.
+class StringInterner {
+private:
+    vector<char> chars;
+    vector<uint32_t> offsets;   // Handle h spans [offsets[h], offsets[h + 1])
+    vector<uint32_t> table;     // Handles, INTERN_NONE = empty slot
+    vector<uint32_t> hashes;    // Low hash bits per handle, for cheap rehash
+    size_t mask;
+
+    size_t findSlot(string_view s, uint32_t hash) const {
+        size_t slot = hash & mask;
+        while(table[slot] != INTERN_NONE) {
+            uint32_t h = table[slot];
+            if(hashes[h] == hash && str(h) == s) break;
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void grow() {
+        table.assign(table.size() * 2, INTERN_NONE);
+        mask = table.size() - 1;
+        for(uint32_t h = 0; h < (uint32_t)hashes.size(); h++) {
+            size_t slot = hashes[h] & mask;
+            while(table[slot] != INTERN_NONE) slot = (slot + 1) & mask;
+            table[slot] = h;
+        }
+    }
+
+public:
+    StringInterner() {
+        table.assign(INTERN_INITIAL_SLOTS, INTERN_NONE);
+        mask = INTERN_INITIAL_SLOTS - 1;
+        offsets.push_back(0);
+    }
+
+    // Handle for s, adding it if new
+    uint32_t intern(string_view s) {
+        uint32_t hash = (uint32_t)hashString(s);
+        size_t slot = findSlot(s, hash);
+        if(table[slot] != INTERN_NONE) return table[slot];
+
+        uint32_t h = (uint32_t)hashes.size();
+        chars.insert(chars.end(), s.begin(), s.end());
+        offsets.push_back((uint32_t)chars.size());
+        hashes.push_back(hash);
+        table[slot] = h;
+        if(hashes.size() * 4 > table.size() * 3) grow();     // Load <= 0.75
+        return h;
+    }
+
+    // Handle for s, or INTERN_NONE if it was never interned
+    uint32_t find(string_view s) const {
+        uint32_t hash = (uint32_t)hashString(s);
+        return table[findSlot(s, hash)];
+    }
+
+    string_view str(uint32_t handle) const {
+        if(handle >= hashes.size()) return string_view();
+        return string_view(chars.data() + offsets[handle], offsets[handle + 1] - offsets[handle]);
+    }
+
+    size_t size() const {
+        return hashes.size();
+    }
+
+    size_t memoryBytes() const {
+        return chars.capacity() + (offsets.capacity() + table.capacity() + hashes.capacity()) * sizeof(uint32_t);
+    }
+};
+
+#endif
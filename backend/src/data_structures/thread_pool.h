@@ -0,0 +1,125 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+using namespace std;
+
+// Fixed set of worker threads for data-parallel loops.
+// parallelFor(count, fn) calls fn(index, workerId) once for every index in
+// [0, count). Workers pull small chunks of indices from a shared atomic
+// counter, so uneven work (long vs short routes) still balances. workerId is
+// in [0, getNumThreads()) and lets callers keep one scratch workspace per
+// thread. Calls from different threads are serialized.
+class ThreadPool {
+private:
+    vector<thread> workers;
+    mutex jobMutex;         // One parallelFor at a time
+    mutex stateMutex;
+    condition_variable startCv;
+    condition_variable doneCv;
+
+    const function<void(int, int)>* job;
+    int jobCount;
+    int jobChunk;
+    atomic<int> nextIndex;
+    int busyWorkers;
+    unsigned long long jobGeneration;
+    bool stopping;
+
+    void workerLoop(int workerId) {
+        unsigned long long seen = 0;
+        while(true) {
+            const function<void(int, int)>* fn;
+            int count;
+            int chunk;
+            {
+                unique_lock<mutex> lock(stateMutex);
+                startCv.wait(lock, [&]() { return stopping || jobGeneration != seen; });
+                if(stopping) return;
+                seen = jobGeneration;
+                fn = job;
+                count = jobCount;
+                chunk = jobChunk;
+            }
+
+            while(true) {
+                int begin = nextIndex.fetch_add(chunk);
+                if(begin >= count) break;
+                int end = begin + chunk < count ? begin + chunk : count;
+                for(int i = begin; i < end; i++) {
+                    (*fn)(i, workerId);
+                }
+            }
+
+            {
+                lock_guard<mutex> lock(stateMutex);
+                if(--busyWorkers == 0) doneCv.notify_one();
+            }
+        }
+    }
+
+public:
+    // numThreads <= 0 uses one thread per hardware core
+    ThreadPool(int numThreads = 0) {
+        if(numThreads <= 0) {
+            numThreads = (int)thread::hardware_concurrency();
+            if(numThreads <= 0) numThreads = 1;
+        }
+        job = NULL;
+        jobCount = 0;
+        jobChunk = 1;
+        nextIndex = 0;
+        busyWorkers = 0;
+        jobGeneration = 0;
+        stopping = false;
+        for(int i = 0; i < numThreads; i++) {
+            workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getNumThreads() const {
+        return (int)workers.size();
+    }
+
+    // Blocks until fn has run for every index
+    void parallelFor(int count, const function<void(int, int)>& fn) {
+        if(count <= 0) return;
+        lock_guard<mutex> serial(jobMutex);
+
+        // ~8 chunks per worker: low contention on the counter, still balanced
+        int chunk = count / ((int)workers.size() * 8);
+        if(chunk < 1) chunk = 1;
+
+        unique_lock<mutex> lock(stateMutex);
+        job = &fn;
+        jobCount = count;
+        jobChunk = chunk;
+        nextIndex = 0;
+        busyWorkers = (int)workers.size();
+        jobGeneration++;
+        startCv.notify_all();
+        doneCv.wait(lock, [&]() { return busyWorkers == 0; });
+        job = NULL;
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        startCv.notify_all();
+        for(size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+    }
+};
+
+#endif
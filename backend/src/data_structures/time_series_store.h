@@ -0,0 +1,645 @@
+#ifndef TIME_SERIES_STORE_H
+#define TIME_SERIES_STORE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include "crc32.h"
+using namespace std;
+
+#define SERIES_BLOCK_SAMPLES 1024       // Samples per block before it is sealed
+#define SERIES_COORD_SCALE 1e7          // Coordinates kept as integer 1e-7 degrees (~1 cm)
+#define SERIES_MAGIC 0x53535446u        // "FTSS"
+#define SERIES_VERSION 2u
+#define SERIES_READ_PADDING 2          // Zero words after a column being validated on load
+#define SERIES_MAX_SAMPLE_BITS 72       // Bound on one sample in any column (prefix + 64-bit value, plus a flag)
+
+// One telemetry reading of a vehicle
+struct TelemetrySample {
+    int64_t timestampMs;
+    double latitude;
+    double longitude;
+    float speed;
+};
+
+// Append-only bit string, most significant bit first
+struct BitColumn {
+    vector<uint64_t> words;
+    uint64_t bitCount;
+
+    BitColumn() {
+        bitCount = 0;
+    }
+
+    // Low `bits` bits of value, 1 <= bits <= 64
+    void write(uint64_t value, int bits) {
+        if(bits < 64) value &= (1ULL << bits) - 1;
+        int used = (int)(bitCount & 63);
+        if(used == 0) words.push_back(0);
+        int free = 64 - used;
+        if(bits <= free) {
+            words.back() |= value << (free - bits);
+        } else {
+            words.back() |= value >> (bits - free);
+            words.push_back(value << (64 - (bits - free)));
+        }
+        bitCount += (uint64_t)bits;
+    }
+};
+
+struct BitReader {
+    const uint64_t* words;
+    uint64_t position;
+
+    BitReader(const BitColumn& column) {
+        words = column.words.data();
+        position = 0;
+    }
+
+    static uint64_t lowBits(uint64_t value, int bits) {
+        return bits == 64 ? value : value & ((1ULL << bits) - 1);
+    }
+
+    uint64_t read(int bits) {
+        size_t w = (size_t)(position >> 6);
+        int available = 64 - (int)(position & 63);
+        position += (uint64_t)bits;
+        if(bits <= available) {
+            return lowBits(words[w] >> (available - bits), bits);
+        }
+        int rest = bits - available;
+        return (lowBits(words[w], available) << rest) | (words[w + 1] >> (64 - rest));
+    }
+
+    bool readBit() {
+        bool bit = (words[position >> 6] >> (63 - (position & 63))) & 1;
+        position++;
+        return bit;
+    }
+};
+
+// Signed integers near zero, zigzagged and written with a prefix code:
+// '0' = 0, '10' + widths[0] bits, '110' + widths[1], '1110' + widths[2],
+// '1111' + 64 bits
+inline void writeZigzag(BitColumn& out, uint64_t value, const int* widths) {
+    uint64_t zigzag = (value << 1) ^ (uint64_t)((int64_t)value >> 63);
+    if(zigzag == 0) {
+        out.write(0, 1);
+        return;
+    }
+    for(int b = 0; b < 3; b++) {
+        if(zigzag < (1ULL << widths[b])) {
+            out.write((1ULL << (b + 2)) - 2, b + 2);     // b+1 ones then a zero
+            out.write(zigzag, widths[b]);
+            return;
+        }
+    }
+    out.write(15, 4);
+    out.write(zigzag, 64);
+}
+
+inline uint64_t readZigzag(BitReader& in, const int* widths) {
+    int ones = 0;
+    while(ones < 4 && in.readBit()) ones++;
+    uint64_t zigzag = 0;
+    if(ones > 0) zigzag = in.read(ones < 4 ? widths[ones - 1] : 64);
+    return (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+}
+
+// Delta-of-delta integer coding. Regular sampling makes the second
+// difference of timestamps (and of positions at steady speed) cluster
+// around zero. Arithmetic is modulo 2^64, so every input round-trips.
+struct DeltaOfDeltaCoder {
+    uint64_t previous;
+    uint64_t previousDelta;
+
+    DeltaOfDeltaCoder() {
+        previous = 0;
+        previousDelta = 0;
+    }
+
+    void encode(int64_t value, const int* widths, BitColumn& out) {
+        uint64_t delta = (uint64_t)value - previous;
+        writeZigzag(out, delta - previousDelta, widths);
+        previous = (uint64_t)value;
+        previousDelta = delta;
+    }
+
+    int64_t decode(const int* widths, BitReader& in) {
+        previousDelta += readZigzag(in, widths);
+        previous += previousDelta;
+        return (int64_t)previous;
+    }
+};
+
+// Gorilla XOR coding of floats. A repeated value costs one bit; otherwise
+// only the bits that changed are stored, reusing the previous leading/
+// trailing-zero window when the new XOR fits inside it.
+struct XorFloatCoder {
+    uint32_t previous;
+    int leading;        // -1 until the first window is written
+    int trailing;
+    bool corrupt;       // decode() met a window no encoder writes
+
+    XorFloatCoder() {
+        previous = 0;
+        leading = -1;
+        trailing = 0;
+        corrupt = false;
+    }
+
+    void encode(float value, BitColumn& out) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        uint32_t x = bits ^ previous;
+        previous = bits;
+        if(x == 0) {
+            out.write(0, 1);
+            return;
+        }
+        out.write(1, 1);
+        int lead = __builtin_clz(x);
+        int trail = __builtin_ctz(x);
+        if(leading >= 0 && lead >= leading && trail >= trailing) {
+            out.write(0, 1);
+            out.write(x >> trailing, 32 - leading - trailing);
+            return;
+        }
+        int length = 32 - lead - trail;
+        out.write(1, 1);
+        out.write((uint64_t)lead, 5);
+        out.write((uint64_t)(length - 1), 5);
+        out.write(x >> trail, length);
+        leading = lead;
+        trailing = trail;
+    }
+
+    // A window wider than 32 bits, or a reuse before any window was
+    // written, sets 'corrupt' and leaves the value unchanged
+    float decode(BitReader& in) {
+        if(in.readBit()) {
+            if(in.readBit()) {
+                int lead = (int)in.read(5);
+                int length = (int)in.read(5) + 1;
+                if(lead + length > 32) {
+                    corrupt = true;
+                } else {
+                    leading = lead;
+                    trailing = 32 - lead - length;
+                }
+            } else if(leading < 0) {
+                corrupt = true;
+            }
+            if(!corrupt) previous ^= (uint32_t)in.read(32 - leading - trailing) << trailing;
+        }
+        float value;
+        memcpy(&value, &previous, sizeof(value));
+        return value;
+    }
+};
+
+// Speeds. Trackers report them in 0.1 km/h steps, where XOR coding of
+// the float bits does poorly, so a value that round-trips through tenths
+// is written as '0' + the zigzagged change in tenths; anything else as
+// '1' + XOR code.
+struct SpeedCoder {
+    int64_t previousTenths;
+    XorFloatCoder raw;
+
+    SpeedCoder() {
+        previousTenths = 0;
+    }
+
+    void encode(float value, const int* widths, BitColumn& out) {
+        double scaled = (double)value * 10;
+        if(scaled > -1e9 && scaled < 1e9) {
+            int64_t tenths = llround(scaled);
+            float rounded = (float)(tenths / 10.0);
+            if(memcmp(&rounded, &value, sizeof(value)) == 0) {
+                out.write(0, 1);
+                writeZigzag(out, (uint64_t)(tenths - previousTenths), widths);
+                previousTenths = tenths;
+                memcpy(&raw.previous, &value, sizeof(value));
+                return;
+            }
+        }
+        out.write(1, 1);
+        raw.encode(value, out);
+    }
+
+    float decode(const int* widths, BitReader& in) {
+        if(in.readBit()) return raw.decode(in);
+        previousTenths += (int64_t)readZigzag(in, widths);
+        float value = (float)(previousTenths / 10.0);
+        memcpy(&raw.previous, &value, sizeof(value));
+        return value;
+    }
+};
+
+// Up to SERIES_BLOCK_SAMPLES consecutive samples of one vehicle, one bit
+// column per field. Immutable once sealed.
+struct SeriesBlock {
+    int64_t minTimestampMs;
+    int64_t maxTimestampMs;
+    uint32_t count;
+    BitColumn timestamps;
+    BitColumn latitudes;
+    BitColumn longitudes;
+    BitColumn speeds;
+
+    SeriesBlock() {
+        minTimestampMs = 0;
+        maxTimestampMs = 0;
+        count = 0;
+    }
+
+    size_t bytes() const {
+        return sizeof(SeriesBlock) - 4 * sizeof(vector<uint64_t>) +
+               8 * (timestamps.words.size() + latitudes.words.size() + longitudes.words.size() + speeds.words.size());
+    }
+};
+
+// Compressed append-only history of per-vehicle telemetry.
+//
+// Each vehicle's samples go into blocks of SERIES_BLOCK_SAMPLES, encoded
+// Gorilla-style into separate bit columns: delta-of-delta timestamps,
+// delta-of-delta coordinates (as 1e-7 degree integers), and speeds (see
+// SpeedCoder). A full block is sealed and never changes again. Blocks carry their
+// min/max timestamps, so a range scan binary-searches the vehicle's blocks
+// and decodes only the ones that overlap the range; count() decodes just
+// the timestamp column, and only for blocks the range cuts through.
+//
+// Samples must arrive in time order per vehicle; older ones are rejected.
+// Coordinates are stored to 1e-7 degrees (as in PositionTable), timestamps
+// and speeds exactly. Not thread-safe: one writer, scans on the same thread.
+class TimeSeriesStore {
+private:
+    struct VehicleSeries {
+        vector<SeriesBlock> blocks;     // Time ordered; the last may be open
+        bool open;
+        DeltaOfDeltaCoder timeCoder;
+        DeltaOfDeltaCoder latCoder;
+        DeltaOfDeltaCoder lonCoder;
+        SpeedCoder speedCoder;
+        TelemetrySample last;
+        bool hasLast;
+
+        VehicleSeries() {
+            open = false;
+            hasLast = false;
+        }
+    };
+
+    // Sequential decoder over one block; columns decode independently
+    struct BlockCursor {
+        BitReader timeIn;
+        BitReader latIn;
+        BitReader lonIn;
+        BitReader speedIn;
+        DeltaOfDeltaCoder timeCoder;
+        DeltaOfDeltaCoder latCoder;
+        DeltaOfDeltaCoder lonCoder;
+        SpeedCoder speedCoder;
+
+        BlockCursor(const SeriesBlock& b) : timeIn(b.timestamps), latIn(b.latitudes), lonIn(b.longitudes), speedIn(b.speeds) {
+        }
+
+        int64_t nextTimestamp() {
+            return timeCoder.decode(TIMESTAMP_WIDTHS, timeIn);
+        }
+
+        void nextValues(TelemetrySample& s) {
+            s.latitude = latCoder.decode(COORDINATE_WIDTHS, latIn) / SERIES_COORD_SCALE;
+            s.longitude = lonCoder.decode(COORDINATE_WIDTHS, lonIn) / SERIES_COORD_SCALE;
+            s.speed = speedCoder.decode(SPEED_WIDTHS, speedIn);
+        }
+    };
+
+    // Prefix-code bucket widths. Timestamps jitter by milliseconds around
+    // the reporting interval; a vehicle's position changes its per-fix
+    // step by up to ~10 m (1024 units) with speed, turns and GPS noise;
+    // speeds change by a few km/h between fixes.
+    static constexpr int TIMESTAMP_WIDTHS[3] = {7, 14, 32};
+    static constexpr int COORDINATE_WIDTHS[3] = {11, 14, 24};
+    static constexpr int SPEED_WIDTHS[3] = {4, 8, 16};
+
+    unordered_map<string, VehicleSeries> vehicles;
+    long long totalSamples;
+    long long rejectedSamples;
+    long long totalBlocks;
+
+    void seal(VehicleSeries& series) {
+        SeriesBlock& b = series.blocks.back();
+        b.timestamps.words.shrink_to_fit();
+        b.latitudes.words.shrink_to_fit();
+        b.longitudes.words.shrink_to_fit();
+        b.speeds.words.shrink_to_fit();
+        series.open = false;
+    }
+
+    // Covers the header fields and every column's bit count and words
+    static uint32_t blockCrc(const SeriesBlock& b) {
+        const BitColumn* columns[4] = {&b.timestamps, &b.latitudes, &b.longitudes, &b.speeds};
+        uint32_t crc = crc32(&b.minTimestampMs, sizeof(b.minTimestampMs));
+        crc = crc32(&b.maxTimestampMs, sizeof(b.maxTimestampMs), crc);
+        crc = crc32(&b.count, sizeof(b.count), crc);
+        for(int c = 0; c < 4; c++) {
+            crc = crc32(&columns[c]->bitCount, sizeof(columns[c]->bitCount), crc);
+            crc = crc32(columns[c]->words.data(), (columns[c]->bitCount + 63) / 64 * 8, crc);
+        }
+        return crc;
+    }
+
+    // Decode a loaded block once: its columns must hold exactly 'count'
+    // samples, in time order from minTimestampMs to maxTimestampMs. Columns
+    // still carry SERIES_READ_PADDING zero words, so a bad block cannot make
+    // the decoder read past them; they are trimmed once the block passes.
+    static bool validateBlock(SeriesBlock& b, TelemetrySample& last) {
+        BitColumn* columns[4] = {&b.timestamps, &b.latitudes, &b.longitudes, &b.speeds};
+        BlockCursor cursor(b);
+        BitReader* readers[4] = {&cursor.timeIn, &cursor.latIn, &cursor.lonIn, &cursor.speedIn};
+        int64_t previous = b.minTimestampMs;
+        for(uint32_t k = 0; k < b.count; k++) {
+            last.timestampMs = cursor.nextTimestamp();
+            cursor.nextValues(last);
+            if(cursor.speedCoder.raw.corrupt) return false;
+            for(int c = 0; c < 4; c++) {
+                if(readers[c]->position > columns[c]->bitCount) return false;
+            }
+            if(last.timestampMs < previous || (k == 0 && last.timestampMs != b.minTimestampMs)) return false;
+            previous = last.timestampMs;
+        }
+        if(previous != b.maxTimestampMs) return false;
+        for(int c = 0; c < 4; c++) {
+            if(readers[c]->position != columns[c]->bitCount) return false;
+            columns[c]->words.resize((size_t)((columns[c]->bitCount + 63) / 64));
+            columns[c]->words.shrink_to_fit();
+        }
+        return true;
+    }
+
+    static bool writeColumn(FILE* f, const BitColumn& c) {
+        uint64_t n = c.words.size();
+        return fwrite(&c.bitCount, sizeof(c.bitCount), 1, f) == 1 && fwrite(&n, sizeof(n), 1, f) == 1 &&
+               (n == 0 || fwrite(c.words.data(), sizeof(uint64_t), n, f) == n);
+    }
+
+    // A column of a block with 'count' samples; lengths past what that
+    // many samples can take are rejected before anything is allocated
+    static bool readColumn(FILE* f, BitColumn& c, uint32_t count) {
+        uint64_t n;
+        if(fread(&c.bitCount, sizeof(c.bitCount), 1, f) != 1 || fread(&n, sizeof(n), 1, f) != 1) return false;
+        if(c.bitCount > (uint64_t)count * SERIES_MAX_SAMPLE_BITS || n != (c.bitCount + 63) / 64) return false;
+        c.words.assign(n + SERIES_READ_PADDING, 0);
+        return n == 0 || fread(c.words.data(), sizeof(uint64_t), n, f) == n;
+    }
+
+    // Index of the first block that ends at or after fromMs
+    static size_t firstBlock(const vector<SeriesBlock>& blocks, int64_t fromMs) {
+        return partition_point(blocks.begin(), blocks.end(), [&](const SeriesBlock& b) {
+            return b.maxTimestampMs < fromMs;
+        }) - blocks.begin();
+    }
+
+public:
+    TimeSeriesStore() {
+        totalSamples = 0;
+        rejectedSamples = 0;
+        totalBlocks = 0;
+    }
+
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    // False if the sample is older than the vehicle's latest one or has
+    // coordinates out of range
+    bool append(const string& vehicleId, const TelemetrySample& s) {
+        if(!(s.latitude >= -90 && s.latitude <= 90 && s.longitude >= -180 && s.longitude <= 180)) {
+            rejectedSamples++;
+            return false;
+        }
+        VehicleSeries& series = vehicles[vehicleId];
+        if(series.hasLast && s.timestampMs < series.last.timestampMs) {
+            rejectedSamples++;
+            return false;
+        }
+
+        if(!series.open) {
+            series.blocks.push_back(SeriesBlock());
+            series.open = true;
+            series.timeCoder = DeltaOfDeltaCoder();
+            series.latCoder = DeltaOfDeltaCoder();
+            series.lonCoder = DeltaOfDeltaCoder();
+            series.speedCoder = SpeedCoder();
+            totalBlocks++;
+        }
+        SeriesBlock& b = series.blocks.back();
+        int64_t latE7 = llround(s.latitude * SERIES_COORD_SCALE);
+        int64_t lonE7 = llround(s.longitude * SERIES_COORD_SCALE);
+        series.timeCoder.encode(s.timestampMs, TIMESTAMP_WIDTHS, b.timestamps);
+        series.latCoder.encode(latE7, COORDINATE_WIDTHS, b.latitudes);
+        series.lonCoder.encode(lonE7, COORDINATE_WIDTHS, b.longitudes);
+        series.speedCoder.encode(s.speed, SPEED_WIDTHS, b.speeds);
+        if(b.count == 0) b.minTimestampMs = s.timestampMs;
+        b.maxTimestampMs = s.timestampMs;
+        b.count++;
+
+        series.last = TelemetrySample{s.timestampMs, latE7 / SERIES_COORD_SCALE, lonE7 / SERIES_COORD_SCALE, s.speed};
+        series.hasLast = true;
+        totalSamples++;
+        if(b.count == SERIES_BLOCK_SAMPLES) seal(series);
+        return true;
+    }
+
+    // Calls fn(sample) for every sample with fromMs <= timestamp <= toMs,
+    // in time order. Returns how many were visited.
+    template <typename F>
+    size_t forEachInRange(const string& vehicleId, int64_t fromMs, int64_t toMs, F fn) const {
+        auto it = vehicles.find(vehicleId);
+        if(it == vehicles.end() || fromMs > toMs) return 0;
+        const vector<SeriesBlock>& blocks = it->second.blocks;
+
+        size_t visited = 0;
+        TelemetrySample s;
+        for(size_t i = firstBlock(blocks, fromMs); i < blocks.size() && blocks[i].minTimestampMs <= toMs; i++) {
+            BlockCursor cursor(blocks[i]);
+            for(uint32_t k = 0; k < blocks[i].count; k++) {
+                s.timestampMs = cursor.nextTimestamp();
+                if(s.timestampMs > toMs) break;
+                cursor.nextValues(s);
+                if(s.timestampMs < fromMs) continue;
+                fn((const TelemetrySample&)s);
+                visited++;
+            }
+        }
+        return visited;
+    }
+
+    // Samples in [fromMs, toMs], appended to out in time order
+    size_t scan(const string& vehicleId, int64_t fromMs, int64_t toMs, vector<TelemetrySample>& out) const {
+        return forEachInRange(vehicleId, fromMs, toMs, [&](const TelemetrySample& s) { out.push_back(s); });
+    }
+
+    // Number of samples in [fromMs, toMs]. Blocks inside the range are
+    // counted from their headers.
+    size_t count(const string& vehicleId, int64_t fromMs, int64_t toMs) const {
+        auto it = vehicles.find(vehicleId);
+        if(it == vehicles.end() || fromMs > toMs) return 0;
+        const vector<SeriesBlock>& blocks = it->second.blocks;
+
+        size_t total = 0;
+        for(size_t i = firstBlock(blocks, fromMs); i < blocks.size() && blocks[i].minTimestampMs <= toMs; i++) {
+            const SeriesBlock& b = blocks[i];
+            if(b.minTimestampMs >= fromMs && b.maxTimestampMs <= toMs) {
+                total += b.count;
+                continue;
+            }
+            BlockCursor cursor(b);
+            for(uint32_t k = 0; k < b.count; k++) {
+                int64_t t = cursor.nextTimestamp();
+                if(t > toMs) break;
+                if(t >= fromMs) total++;
+            }
+        }
+        return total;
+    }
+
+    bool getLatest(const string& vehicleId, TelemetrySample& out) const {
+        auto it = vehicles.find(vehicleId);
+        if(it == vehicles.end() || !it->second.hasLast) return false;
+        out = it->second.last;
+        return true;
+    }
+
+    size_t getVehicleCount() const {
+        return vehicles.size();
+    }
+
+    long long getSampleCount() const {
+        return totalSamples;
+    }
+
+    // Encoded columns plus block headers
+    size_t getCompressedBytes() const {
+        size_t bytes = 0;
+        for(const auto& entry : vehicles) {
+            for(const SeriesBlock& b : entry.second.blocks) bytes += b.bytes();
+        }
+        return bytes;
+    }
+
+    // Write every block to disk (temp file, fsync, rename), each with a
+    // CRC of its header and columns
+    bool save(const string& path) const {
+        string tempPath = path + ".tmp";
+        FILE* f = fopen(tempPath.c_str(), "wb");
+        if(f == NULL) return false;
+
+        uint32_t head[2] = {SERIES_MAGIC, SERIES_VERSION};
+        uint64_t numVehicles = vehicles.size();
+        bool ok = fwrite(head, sizeof(head), 1, f) == 1 && fwrite(&numVehicles, sizeof(numVehicles), 1, f) == 1;
+        for(auto it = vehicles.begin(); ok && it != vehicles.end(); ++it) {
+            uint32_t idLength = (uint32_t)it->first.size();
+            uint64_t numBlocks = it->second.blocks.size();
+            ok = fwrite(&idLength, sizeof(idLength), 1, f) == 1 &&
+                 (idLength == 0 || fwrite(it->first.data(), 1, idLength, f) == idLength) &&
+                 fwrite(&numBlocks, sizeof(numBlocks), 1, f) == 1;
+            for(size_t i = 0; ok && i < it->second.blocks.size(); i++) {
+                const SeriesBlock& b = it->second.blocks[i];
+                uint32_t crc = blockCrc(b);
+                ok = fwrite(&b.minTimestampMs, sizeof(int64_t), 1, f) == 1 &&
+                     fwrite(&b.maxTimestampMs, sizeof(int64_t), 1, f) == 1 &&
+                     fwrite(&b.count, sizeof(uint32_t), 1, f) == 1 &&
+                     writeColumn(f, b.timestamps) && writeColumn(f, b.latitudes) &&
+                     writeColumn(f, b.longitudes) && writeColumn(f, b.speeds) &&
+                     fwrite(&crc, sizeof(crc), 1, f) == 1;
+            }
+        }
+        ok = fflush(f) == 0 && fsync(fileno(f)) == 0 && ok;
+        ok = fclose(f) == 0 && ok;
+        if(!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+            remove(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Replace the contents with a saved store. Loaded blocks are all sealed;
+    // new samples start a fresh block per vehicle. Every block is checked
+    // against its CRC and decoded once (see validateBlock). On any error
+    // the store is left empty.
+    bool load(const string& path) {
+        vehicles.clear();
+        totalSamples = 0;
+        rejectedSamples = 0;
+        totalBlocks = 0;
+        FILE* f = fopen(path.c_str(), "rb");
+        if(f == NULL) return false;
+
+        uint32_t head[2];
+        uint64_t numVehicles = 0;
+        bool ok = fread(head, sizeof(head), 1, f) == 1 && head[0] == SERIES_MAGIC && head[1] == SERIES_VERSION &&
+                  fread(&numVehicles, sizeof(numVehicles), 1, f) == 1;
+        for(uint64_t v = 0; ok && v < numVehicles; v++) {
+            uint32_t idLength;
+            uint64_t numBlocks;
+            ok = fread(&idLength, sizeof(idLength), 1, f) == 1 && idLength < 4096;
+            string id(ok ? idLength : 0, '\0');
+            ok = ok && (idLength == 0 || fread(&id[0], 1, idLength, f) == idLength) &&
+                 fread(&numBlocks, sizeof(numBlocks), 1, f) == 1 && numBlocks < (1ULL << 32) &&
+                 vehicles.find(id) == vehicles.end();
+            if(!ok) break;
+
+            VehicleSeries& series = vehicles[id];
+            for(uint64_t i = 0; ok && i < numBlocks; i++) {
+                series.blocks.push_back(SeriesBlock());
+                SeriesBlock& b = series.blocks.back();
+                uint32_t crc;
+                ok = fread(&b.minTimestampMs, sizeof(int64_t), 1, f) == 1 &&
+                     fread(&b.maxTimestampMs, sizeof(int64_t), 1, f) == 1 &&
+                     fread(&b.count, sizeof(uint32_t), 1, f) == 1 &&
+                     b.count > 0 && b.count <= SERIES_BLOCK_SAMPLES &&
+                     readColumn(f, b.timestamps, b.count) && readColumn(f, b.latitudes, b.count) &&
+                     readColumn(f, b.longitudes, b.count) && readColumn(f, b.speeds, b.count) &&
+                     fread(&crc, sizeof(crc), 1, f) == 1 && crc == blockCrc(b) && b.minTimestampMs <= b.maxTimestampMs &&
+                     (i == 0 || series.blocks[i - 1].maxTimestampMs <= b.minTimestampMs) &&
+                     validateBlock(b, series.last);
+                totalSamples += b.count;
+                totalBlocks++;
+            }
+            // The last block decoded holds the latest sample, so appends stay in time order
+            series.hasLast = ok && !series.blocks.empty();
+        }
+        fclose(f);
+
+        if(!ok) {
+            vehicles.clear();
+            totalSamples = 0;
+            totalBlocks = 0;
+        }
+        return ok;
+    }
+
+    void displayStats() const {
+        size_t bytes = getCompressedBytes();
+        size_t rowBytes = (size_t)totalSamples * (sizeof(int64_t) + 2 * sizeof(double) + sizeof(float));
+        cout << "\n=== Time Series Statistics ===" << endl;
+        cout << "Vehicles: " << vehicles.size() << ", samples: " << totalSamples << ", blocks: " << totalBlocks << endl;
+        cout << "Rejected (out of order / invalid): " << rejectedSamples << endl;
+        cout << "Compressed: " << bytes << " bytes";
+        if(totalSamples > 0) {
+            cout << " (" << (double)bytes / totalSamples << " B/sample, raw rows " << rowBytes / (double)bytes << "x larger)";
+        }
+        cout << endl;
+        cout << "==============================\n" << endl;
+    }
+};
+
+#endif
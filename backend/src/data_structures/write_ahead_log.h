@@ -0,0 +1,265 @@
+#ifndef WRITE_AHEAD_LOG_H
+#define WRITE_AHEAD_LOG_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "crc32.h"
+using namespace std;
+
+#define WAL_FRAME_HEADER 17         // length(4) crc(4) lsn(8) type(1)
+#define WAL_MAX_PAYLOAD (1u << 20)
+
+// Called for each intact record during open(); return false to abort
+typedef function<bool(uint64_t lsn, uint8_t type, const char* payload, uint32_t length)> WalReplay;
+
+// Append-only log of mutation records with group commit.
+// Each record is framed as [length][crc32][lsn][type][payload]; the CRC
+// covers everything but itself, so a torn or partially written tail is
+// detected on open(), cut off, and never replayed. append() only copies
+// the frame into an in-memory batch and returns its log sequence number.
+// waitDurable(lsn) makes it durable: the first waiter becomes the leader,
+// writes the whole batch with one write() + fdatasync(), and wakes every
+// writer whose record was in it - concurrent commits share one sync.
+class WriteAheadLog {
+private:
+    int fd;
+    string path;
+    mutable mutex lock;
+    condition_variable flushedSignal;
+    string pending;             // Encoded frames not yet written
+    uint64_t lastLsn;           // Last LSN handed out
+    uint64_t durableLsn;        // Everything up to here is synced
+    bool flushing;
+    bool failed;
+
+    long long syncs;
+    long long recordsSynced;
+
+    static bool writeAll(int file, const char* data, size_t length) {
+        while(length > 0) {
+            ssize_t written = ::write(file, data, length);
+            if(written < 0) {
+                if(errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            length -= (size_t)written;
+        }
+        return true;
+    }
+
+    // Drop a log that failed to open; nothing was appended, so no sync
+    void abandon() {
+        ::close(fd);
+        fd = -1;
+    }
+
+    static uint32_t frameCrc(const char* frame, uint32_t length) {
+        uint32_t crc = crc32(frame, 4);
+        return crc32(frame + 8, WAL_FRAME_HEADER - 8 + length, crc);
+    }
+
+public:
+    WriteAheadLog() {
+        fd = -1;
+        lastLsn = 0;
+        durableLsn = 0;
+        flushing = false;
+        failed = false;
+        syncs = 0;
+        recordsSynced = 0;
+    }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Open (or create) the log, replay intact records with LSN > afterLsn
+    // and truncate anything after the last intact record. New records are
+    // numbered after max(afterLsn, last LSN in the file).
+    bool open(const string& filePath, uint64_t afterLsn, const WalReplay& replay, size_t* tornBytes = NULL) {
+        close();
+        path = filePath;
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);    // Writes always go to the end
+        if(fd < 0) {
+            cout << "❌ Cannot open WAL: " << path << endl;
+            return false;
+        }
+
+        string contents;
+        char buffer[65536];
+        ssize_t got;
+        while((got = ::read(fd, buffer, sizeof(buffer))) > 0) {
+            contents.append(buffer, (size_t)got);
+        }
+        if(got < 0) {
+            cout << "❌ Cannot read WAL: " << path << endl;
+            abandon();
+            return false;
+        }
+
+        size_t offset = 0;
+        uint64_t fileLsn = 0;
+        while(offset + WAL_FRAME_HEADER <= contents.size()) {
+            const char* frame = contents.data() + offset;
+            uint32_t length, crc;
+            uint64_t lsn;
+            memcpy(&length, frame, 4);
+            memcpy(&crc, frame + 4, 4);
+            memcpy(&lsn, frame + 8, 8);
+            if(length > WAL_MAX_PAYLOAD || offset + WAL_FRAME_HEADER + length > contents.size()) break;
+            if(frameCrc(frame, length) != crc || lsn <= fileLsn) break;
+
+            if(lsn > afterLsn && !replay(lsn, (uint8_t)frame[16], frame + WAL_FRAME_HEADER, length)) {
+                abandon();
+                return false;
+            }
+            fileLsn = lsn;
+            offset += WAL_FRAME_HEADER + length;
+        }
+
+        if(tornBytes != NULL) *tornBytes = contents.size() - offset;
+        if(offset < contents.size()) {
+            if(ftruncate(fd, (off_t)offset) != 0 || fdatasync(fd) != 0) {
+                cout << "❌ Cannot truncate torn WAL tail: " << path << endl;
+                abandon();
+                return false;
+            }
+        }
+
+        lock_guard<mutex> guard(lock);
+        lastLsn = fileLsn > afterLsn ? fileLsn : afterLsn;
+        durableLsn = lastLsn;
+        pending.clear();
+        failed = false;
+        return true;
+    }
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+    // Queue one record; returns its LSN (0 if the log is not open)
+    uint64_t append(uint8_t type, const char* payload, uint32_t length) {
+        lock_guard<mutex> guard(lock);
+        if(fd < 0 || failed || length > WAL_MAX_PAYLOAD) return 0;
+        uint64_t lsn = ++lastLsn;
+
+        size_t start = pending.size();
+        pending.resize(start + WAL_FRAME_HEADER + length);
+        char* frame = &pending[start];
+        memcpy(frame, &length, 4);
+        memcpy(frame + 8, &lsn, 8);
+        frame[16] = (char)type;
+        if(length > 0) memcpy(frame + WAL_FRAME_HEADER, payload, length);
+        uint32_t crc = frameCrc(frame, length);
+        memcpy(frame + 4, &crc, 4);
+        return lsn;
+    }
+
+    // Block until 'lsn' is on disk. False if a write or sync failed; the
+    // log then refuses further appends.
+    bool waitDurable(uint64_t lsn) {
+        unique_lock<mutex> guard(lock);
+        while(durableLsn < lsn && !failed) {
+            if(flushing) {
+                flushedSignal.wait(guard);
+                continue;
+            }
+
+            // Leader: take the whole batch, including later followers
+            flushing = true;
+            string batch;
+            batch.swap(pending);
+            uint64_t batchLsn = lastLsn;
+            long long batchRecords = (long long)(batchLsn - durableLsn);
+            guard.unlock();
+
+            bool ok = writeAll(fd, batch.data(), batch.size()) && fdatasync(fd) == 0;
+
+            guard.lock();
+            flushing = false;
+            if(ok) {
+                durableLsn = batchLsn;
+                syncs++;
+                recordsSynced += batchRecords;
+            } else {
+                failed = true;
+                cout << "❌ WAL write failed: " << path << endl;
+            }
+            flushedSignal.notify_all();
+        }
+        return durableLsn >= lsn;
+    }
+
+    // Make everything appended so far durable
+    bool sync() {
+        uint64_t target;
+        {
+            lock_guard<mutex> guard(lock);
+            target = lastLsn;
+        }
+        return waitDurable(target);
+    }
+
+    // Drop all records (after a snapshot has covered them). LSNs keep
+    // counting from where they were. Caller must stop appends first.
+    bool truncate() {
+        if(!sync()) return false;
+        lock_guard<mutex> guard(lock);
+        if(ftruncate(fd, 0) != 0 || fdatasync(fd) != 0) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    uint64_t getLastLsn() const {
+        lock_guard<mutex> guard(lock);
+        return lastLsn;
+    }
+
+    uint64_t getDurableLsn() const {
+        lock_guard<mutex> guard(lock);
+        return durableLsn;
+    }
+
+    long long getSyncs() const {
+        lock_guard<mutex> guard(lock);
+        return syncs;
+    }
+
+    long long getRecordsSynced() const {
+        lock_guard<mutex> guard(lock);
+        return recordsSynced;
+    }
+
+    long long getFileBytes() const {
+        struct stat info;
+        if(fd < 0 || fstat(fd, &info) != 0) return 0;
+        return (long long)info.st_size;
+    }
+
+    void close() {
+        if(fd >= 0) {
+            sync();
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    ~WriteAheadLog() {
+        close();
+    }
+};
+
+#endif
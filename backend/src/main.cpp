@@ -6,6 +6,24 @@
 #include "data_structures/min_heap.h"
 #include "data_structures/graph.h"
 #include "data_structures/btree.h"
+#include "data_structures/contraction_hierarchy.h"
+#include "data_structures/fleet_store.h"
+#include "data_structures/auth_system.h"
+#include "data_structures/mapped_fleet.h"
+#include "data_structures/spatial_grid.h"
+#include "data_structures/road_segment_index.h"
+#include "data_structures/time_series_store.h"
+#include "services/distance_matrix.h"
+#include "services/route_service.h"
+#include "services/assignment_engine.h"
+#include "services/maintenance_scorer.h"
+#include "services/fleet_query.h"
+#include "services/fleet_journal.h"
+#include "services/telemetry_ingest.h"
+#include "services/map_matcher.h"
+#include "services/dashboard_aggregates.h"
+#include <cstdio>
+#include <random>
 using namespace std;
 
 int main() {
@@ -69,6 +87,19 @@ int main() {
     vehicleDB.deleteVehicle("V002");
     cout << "\nAfter deletion:" << endl;
     vehicleDB.displayStats();
+
+    // Secondary indexes - status/type bitmaps and driver map
+    cout << "\n--- TESTING SECONDARY INDEXES ---" << endl;
+    vehicleDB.updateStatus("V001", VEHICLE_IN_USE);
+    vehicleDB.assignDriver("V001", "D004");
+    vehicleDB.updateStatus("V004", VEHICLE_MAINTENANCE);
+    vector<Vehicle*> busyTrucks = vehicleDB.query(VEHICLE_STATUS_BIT(VEHICLE_IN_USE), VEHICLE_TYPE_BIT(VEHICLE_TRUCK));
+    cout << "IN_USE trucks: " << busyTrucks.size() << endl;
+    cout << "Trucks or cars off the road: "
+         << vehicleDB.count(VEHICLE_STATUS_BIT(VEHICLE_MAINTENANCE) | VEHICLE_STATUS_BIT(VEHICLE_RETIRED),
+                            VEHICLE_TYPE_BIT(VEHICLE_TRUCK) | VEHICLE_TYPE_BIT(VEHICLE_CAR)) << endl;
+    Vehicle* driverVehicle = vehicleDB.findByDriver("D004");
+    cout << "Vehicle of driver D004: " << (driverVehicle != NULL ? driverVehicle->vehicleId : string("none")) << endl;
     cout << "\n✅ Hash Table Module Complete!" << endl;
     cout << "✅ O(1) Insert, Search, Delete implemented!" << endl;
 
@@ -107,7 +138,7 @@ int main() {
     // Assignment 1
     Driver* assigned1 = driverQueue.dequeue();
     if(assigned1 != NULL) {
-        assigned1->status = "ON_DUTY";
+        assigned1->status = DRIVER_ON_DUTY;
         assigned1->assignedVehicleId = "V001";
         cout << "Assigned to Vehicle V001" << endl;
     }
@@ -115,7 +146,7 @@ int main() {
     // Assignment 2
     Driver* assigned2 = driverQueue.dequeue();
     if(assigned2 != NULL) {
-        assigned2->status = "ON_DUTY";
+        assigned2->status = DRIVER_ON_DUTY;
         assigned2->assignedVehicleId = "V003";
         cout << "Assigned to Vehicle V003" << endl;
     }
@@ -136,7 +167,7 @@ int main() {
     cout << "\n--- ONE MORE ASSIGNMENT ---" << endl;
     Driver* assigned3 = driverQueue.dequeue();
     if(assigned3 != NULL) {
-        assigned3->status = "ON_DUTY";
+        assigned3->status = DRIVER_ON_DUTY;
         assigned3->assignedVehicleId = "V004";
         cout << "Assigned to Vehicle V004" << endl;
     }
@@ -145,6 +176,23 @@ int main() {
     cout << "\n📋 Final Queue Status:" << endl;
     driverQueue.displayStats();
     driverQueue.displayQueue();
+    // Shift change: most experienced drivers go out first
+    cout << "\n--- TESTING PRIORITY MODE (By Experience) ---" << endl;
+    DriverQueue seniorityQueue(64, QUEUE_BY_EXPERIENCE);
+    seniorityQueue.setVerbose(false);
+    seniorityQueue.enqueue(d1);
+    seniorityQueue.enqueue(d2);
+    seniorityQueue.enqueue(d3);
+    seniorityQueue.enqueue(d4);
+    seniorityQueue.enqueue(d5);
+    seniorityQueue.displayStats();
+    cout << "Dispatch order:";
+    while(!seniorityQueue.isEmpty()) {
+        Driver* next = seniorityQueue.dequeue();
+        cout << " " << next->name << " (" << next->experience << "y)";
+    }
+    cout << endl;
+
     cout << "\n✅ Queue Module Complete!" << endl;
     cout << "✅ FIFO Driver Assignment implemented!" << endl;
 
@@ -197,27 +245,35 @@ int main() {
     // Show top 3 priority vehicles
     maintenanceHeap.displayTop3();
 
+    // Odometer sync - re-prioritise a single vehicle in O(log n)
+    cout << "\n--- TESTING PRIORITY UPDATE (Odometer Sync) ---" << endl;
+    vm4->kilometersRun = 31000;
+    vm4->daysSinceLastService = 210;
+    maintenanceHeap.updatePriority(vm4->vehicleId);
+    cout << "Vehicle " << vm4->vehicleId << " updated (Priority: " << vm4->getMaintenancePriority() << ")" << endl;
+    maintenanceHeap.displayTop3();
+
     // Extract highest priority vehicles
     cout << "\n--- SCHEDULING MAINTENANCE (Extracting Min) ---\n" << endl;
     
     cout << "🔧 Scheduling 1st vehicle..." << endl;
     Vehicle* scheduled1 = maintenanceHeap.extractMin();
     if(scheduled1 != NULL) {
-        scheduled1->status = "MAINTENANCE";
+        scheduled1->status = VEHICLE_MAINTENANCE;
         cout << "Vehicle " << scheduled1->vehicleId << " sent to workshop\n" << endl;
     }
 
     cout << "🔧 Scheduling 2nd vehicle..." << endl;
     Vehicle* scheduled2 = maintenanceHeap.extractMin();
     if(scheduled2 != NULL) {
-        scheduled2->status = "MAINTENANCE";
+        scheduled2->status = VEHICLE_MAINTENANCE;
         cout << "Vehicle " << scheduled2->vehicleId << " sent to workshop\n" << endl;
     }
 
     cout << "🔧 Scheduling 3rd vehicle..." << endl;
     Vehicle* scheduled3 = maintenanceHeap.extractMin();
     if(scheduled3 != NULL) {
-        scheduled3->status = "MAINTENANCE";
+        scheduled3->status = VEHICLE_MAINTENANCE;
         cout << "Vehicle " << scheduled3->vehicleId << " sent to workshop\n" << endl;
     }
 
@@ -295,6 +351,184 @@ int main() {
     cout << "========================================" << endl;
     cityMap.dijkstra(2, 4);
 
+    // Contraction Hierarchy on a larger synthetic grid city, checked
+    // query-by-query against plain Dijkstra
+    cout << "\n--- TESTING CONTRACTION HIERARCHY (vs Dijkstra) ---" << endl;
+    const int gridSize = 40;
+    Graph gridCity;
+    gridCity.setVerbose(false);
+    mt19937 rng(2024);
+    // Junctions ~1 km apart around Lahore (31.5N, 74.3E)
+    for(int i = 0; i < gridSize * gridSize; i++) {
+        gridCity.addLocation("Junction " + to_string(i),
+                             31.5 + (i / gridSize) * 0.009, 74.3 + (i % gridSize) * 0.0105);
+    }
+    for(int r = 0; r < gridSize; r++) {
+        for(int c = 0; c < gridSize; c++) {
+            int u = r * gridSize + c;
+            if(c + 1 < gridSize && rng() % 10 != 0) gridCity.addRoad(u, u + 1, 1 + rng() % 9);
+            if(r + 1 < gridSize && rng() % 10 != 0) gridCity.addRoad(u, u + gridSize, 1 + rng() % 9);
+        }
+    }
+
+    ContractionHierarchy hierarchy;
+    hierarchy.build(gridCity.getCSR());
+    hierarchy.save("city_map.ch");
+    ContractionHierarchy loadedHierarchy;
+    if(loadedHierarchy.load("city_map.ch")) {
+        cout << "✅ Hierarchy saved and reloaded from city_map.ch" << endl;
+    }
+    loadedHierarchy.displayStats();
+
+    int mismatches = 0;
+    long long dijkstraSettled = 0;
+    long long hierarchySettled = 0;
+    const int numQueries = 200;
+    RoutePath plainRoute;
+    RoutePath chRoute;
+    for(int q = 0; q < numQueries; q++) {
+        int from = rng() % (gridSize * gridSize);
+        int to = rng() % (gridSize * gridSize);
+        gridCity.findRoute(from, to, plainRoute);
+        loadedHierarchy.findRoute(from, to, chRoute);
+        if(plainRoute.found != chRoute.found || plainRoute.distance != chRoute.distance) {
+            mismatches++;
+        }
+        dijkstraSettled += plainRoute.settledNodes;
+        hierarchySettled += chRoute.settledNodes;
+    }
+    cout << "Random queries: " << numQueries << ", mismatches: " << mismatches << endl;
+    cout << "Avg locations explored - Dijkstra: " << dijkstraSettled / numQueries
+         << ", Hierarchy: " << hierarchySettled / numQueries << endl;
+    if(mismatches == 0) {
+        cout << "✅ Contraction Hierarchy matches Dijkstra on every query!" << endl;
+    }
+
+    // A* on the same queries: haversine bound first, then with ALT landmarks
+    cout << "\n--- TESTING A* (Geographic Heuristic) ---" << endl;
+    mt19937 queryRng(7);
+    long long astarSettled = 0;
+    long long altSettled = 0;
+    long long baselineSettled = 0;
+    int astarMismatches = 0;
+    RoutePath astarRoute;
+    for(int pass = 0; pass < 2; pass++) {
+        if(pass == 1) gridCity.prepareLandmarks(8);
+        queryRng.seed(7);
+        for(int q = 0; q < numQueries; q++) {
+            int from = queryRng() % (gridSize * gridSize);
+            int to = queryRng() % (gridSize * gridSize);
+            gridCity.findRoute(from, to, plainRoute);
+            gridCity.findRouteAStar(from, to, astarRoute);
+            if(plainRoute.distance != astarRoute.distance) astarMismatches++;
+            if(pass == 0) {
+                baselineSettled += plainRoute.settledNodes;
+                astarSettled += astarRoute.settledNodes;
+            } else {
+                altSettled += astarRoute.settledNodes;
+            }
+        }
+    }
+    cout << "Avg locations explored - Dijkstra: " << baselineSettled / numQueries
+         << ", A* (haversine): " << astarSettled / numQueries
+         << ", A* + 8 landmarks: " << altSettled / numQueries << endl;
+    if(astarMismatches == 0) {
+        cout << "✅ A* distances match Dijkstra on every query!" << endl;
+    }
+
+    // Dispatch: distance from every available vehicle to every pickup
+    cout << "\n--- TESTING DISTANCE MATRIX (Dispatch) ---" << endl;
+    ThreadPool workerPool;
+    DistanceMatrixEngine matrixEngine(workerPool);
+    vector<int> vehicleJunctions = {0, 620, 1210, 1599};
+    vector<int> pickupJunctions = {45, 800, 1333};
+    DistanceMatrix dispatchMatrix;
+    DistanceMatrix hierarchyMatrix;
+    matrixEngine.compute(gridCity.getCSR(), vehicleJunctions, pickupJunctions, dispatchMatrix);
+    matrixEngine.computeWithHierarchy(loadedHierarchy, vehicleJunctions, pickupJunctions, hierarchyMatrix);
+
+    cout << "Worker threads: " << workerPool.getNumThreads() << endl;
+    for(int i = 0; i < dispatchMatrix.rows; i++) {
+        cout << "Vehicle at J" << vehicleJunctions[i] << ":";
+        for(int j = 0; j < dispatchMatrix.cols; j++) {
+            cout << "  P" << pickupJunctions[j] << "=" << dispatchMatrix.at(i, j) << " km";
+        }
+        cout << endl;
+    }
+    if(dispatchMatrix.values == hierarchyMatrix.values) {
+        cout << "✅ Bucket many-to-many over the hierarchy matches per-source Dijkstra!" << endl;
+    }
+
+    // End-of-day replanning: many routes at once on a read-only snapshot
+    cout << "\n--- TESTING BATCH ROUTE SERVICE ---" << endl;
+    RouteQueryService routeService(workerPool);
+    routeService.publish(gridCity.snapshot());
+    vector<RouteQuery> replanQueries;
+    for(int q = 0; q < 1000; q++) {
+        replanQueries.push_back(RouteQuery{(int)(rng() % (gridSize * gridSize)), (int)(rng() % (gridSize * gridSize))});
+    }
+    vector<RoutePath> replanned;
+    int routesFound = routeService.routeBatch(replanQueries, replanned);
+    int batchMismatches = 0;
+    for(size_t q = 0; q < replanQueries.size(); q += 50) {
+        gridCity.findRoute(replanQueries[q].source, replanQueries[q].destination, plainRoute);
+        if(plainRoute.distance != replanned[q].distance) batchMismatches++;
+    }
+    cout << "Trips replanned: " << replanQueries.size() << ", routes found: " << routesFound << endl;
+    if(batchMismatches == 0) {
+        cout << "✅ Batch results match single-query Dijkstra!" << endl;
+    }
+
+    // Shift start: match waiting drivers to parked vehicles, minimizing empty miles
+    cout << "\n--- TESTING OPTIMAL DRIVER ASSIGNMENT ---" << endl;
+    int numShiftDrivers = 120;
+    int numShiftVehicles = 100;
+    vector<Driver> shiftDrivers(numShiftDrivers);
+    HashTable shiftDepot(numShiftVehicles);
+    shiftDepot.setVerbose(false);
+    vector<Driver*> waitingDrivers;
+    vector<string> parkedVehicles;
+    vector<int> driverJunctions;
+    vector<int> depotJunctions;
+    for(int i = 0; i < numShiftDrivers; i++) {
+        shiftDrivers[i].driverId = "SD" + to_string(i);
+        waitingDrivers.push_back(&shiftDrivers[i]);
+        driverJunctions.push_back((int)(rng() % (gridSize * gridSize)));
+    }
+    for(int i = 0; i < numShiftVehicles; i++) {
+        parkedVehicles.push_back("SV" + to_string(i));
+        shiftDepot.insert(new Vehicle(parkedVehicles.back(), "SHIFT-" + to_string(i), "Pool", "Van", 2022));
+        depotJunctions.push_back((int)(rng() % (gridSize * gridSize)));
+    }
+    DistanceMatrix emptyMiles;
+    matrixEngine.computeWithHierarchy(loadedHierarchy, driverJunctions, depotJunctions, emptyMiles);
+
+    // Greedy baseline: each driver in queue order takes the closest free vehicle
+    long long greedyMiles = 0;
+    vector<bool> vehicleTaken(numShiftVehicles, false);
+    for(int i = 0; i < numShiftDrivers; i++) {
+        int best = -1;
+        for(int j = 0; j < numShiftVehicles; j++) {
+            if(!vehicleTaken[j] && (best == -1 || emptyMiles.at(i, j) < emptyMiles.at(i, best))) best = j;
+        }
+        if(best == -1) break;
+        vehicleTaken[best] = true;
+        greedyMiles += emptyMiles.at(i, best);
+    }
+
+    AssignmentEngine assignmentEngine;
+    AssignmentResult shiftPlan;
+    int matched = assignmentEngine.assignDrivers(waitingDrivers, shiftDepot, parkedVehicles, emptyMiles, shiftPlan);
+    cout << "Drivers: " << numShiftDrivers << ", vehicles: " << numShiftVehicles
+         << ", assigned: " << matched << endl;
+    cout << "Empty km - greedy: " << greedyMiles << ", optimal: " << shiftPlan.totalCost << endl;
+    cout << "Driver " << shiftDrivers[0].driverId << " -> "
+         << (shiftDrivers[0].assignedVehicleId != "" ? shiftDrivers[0].assignedVehicleId : "(waiting)") << endl;
+    cout << "Depot vehicles now IN_USE: " << shiftDepot.count(VEHICLE_STATUS_BIT(VEHICLE_IN_USE), VEHICLE_ANY_TYPE) << endl;
+    if(shiftPlan.totalCost <= greedyMiles) {
+        cout << "✅ Optimal assignment never drives more empty km than greedy!" << endl;
+    }
+
     cout << "\n✅ Graph + Dijkstra Module Complete!" << endl;
     cout << "✅ O(E log V) Shortest Path Algorithm implemented!" << endl;
 
@@ -305,79 +539,461 @@ int main() {
     cout << "\n\n--- MODULE 5: B-TREE VEHICLE INDEX ---" << endl;
     cout << "Testing Sorted Storage & Range Queries\n" << endl;
 
-    BTree vehicleIndex;
+    {
+        // Small fanout so the demo data actually splits into several levels
+        BTree vehicleIndex("vehicle_index.db", 4, true);
+
+        // Insert vehicles in random order - B-Tree keeps them sorted
+        cout << "🚗 Adding vehicles to B-Tree index (random order)...\n" << endl;
+
+        Vehicle vb1("V205", "RJ-14-XY-7890", "Eicher Truck", "Truck", 2019);
+        vb1.kilometersRun = 15000;
+        vehicleIndex.insert(&vb1);
+
+        Vehicle vb2("V203", "GJ-01-AB-1234", "Tata Winger", "Van", 2020);
+        vb2.kilometersRun = 9000;
+        vehicleIndex.insert(&vb2);
+
+        Vehicle vb3("V208", "MH-14-CD-5678", "Mahindra Scorpio", "SUV", 2021);
+        vb3.kilometersRun = 7500;
+        vehicleIndex.insert(&vb3);
+
+        Vehicle vb4("V201", "DL-08-EF-9012", "Maruti Omni", "Van", 2018);
+        vb4.kilometersRun = 20000;
+        vehicleIndex.insert(&vb4);
+
+        Vehicle vb5("V207", "KA-05-GH-3456", "Ashok Leyland", "Truck", 2019);
+        vb5.kilometersRun = 18000;
+        vehicleIndex.insert(&vb5);
+
+        Vehicle vb6("V202", "TN-09-IJ-7890", "Force Traveller", "Van", 2020);
+        vb6.kilometersRun = 12000;
+        vehicleIndex.insert(&vb6);
+
+        cout << endl;
+
+        // Display sorted vehicles
+        vehicleIndex.displayAll();
+
+        // Display statistics
+        vehicleIndex.displayStats();
+
+        // Test Search - O(log n) root-to-leaf descent
+        cout << "\n--- TESTING B+TREE SEARCH (O(log n)) ---" << endl;
+        cout << "Searching for V205..." << endl;
+        Vehicle foundVehicle;
+        if(vehicleIndex.search("V205", foundVehicle)) {
+            cout << "✅ Found: " << foundVehicle.model << " (" << foundVehicle.vehicleId << ")" << endl;
+            cout << "   Registration: " << foundVehicle.registrationNumber << endl;
+        } else {
+            cout << "❌ Vehicle not found!" << endl;
+        }
+
+        cout << "\nSearching for V201..." << endl;
+        Vehicle foundVehicle2;
+        if(vehicleIndex.search("V201", foundVehicle2)) {
+            cout << "✅ Found: " << foundVehicle2.model << " (" << foundVehicle2.vehicleId << ")" << endl;
+        } else {
+            cout << "❌ Vehicle not found!" << endl;
+        }
+
+        cout << "\nSearching for V999 (doesn't exist)..." << endl;
+        Vehicle notFoundBTree;
+        if(!vehicleIndex.search("V999", notFoundBTree)) {
+            cout << "❌ Vehicle not found (as expected)\n" << endl;
+        }
+
+        // Test Range Query - descend once, then walk leaf sibling links
+        vehicleIndex.displayRange("V203", "V207");
+
+        cout << "\n--- TESTING DUPLICATE PREVENTION ---" << endl;
+        Vehicle duplicate("V205", "KA-03-CC-3333", "Duplicate Car", "Car", 2023);
+        vehicleIndex.insert(&duplicate);
+    }
+
+    // Reopen the index file - nothing is reloaded from the database
+    cout << "\n--- TESTING PERSISTENCE (Simulated Restart) ---" << endl;
+    BTree reopenedIndex("vehicle_index.db");
+    cout << "Vehicles recovered from disk: " << reopenedIndex.getTotalVehicles() << endl;
+    reopenedIndex.displayRange("V201", "V203");
 
-    // Insert vehicles in random order - B-Tree keeps them sorted
-    cout << "🚗 Adding vehicles to B-Tree index (random order)...\n" << endl;
-    
-    Vehicle* vb1 = new Vehicle("V205", "RJ-14-XY-7890", "Eicher Truck", "Truck", 2019);
-    vb1->kilometersRun = 15000;
-    vehicleIndex.insert(vb1);
+    cout << "\n✅ B-Tree Module Complete!" << endl;
+    cout << "✅ O(log n) Disk-backed B+Tree Indexing & O(log n + k) Range Queries implemented!" << endl;
 
-    Vehicle* vb2 = new Vehicle("V203", "GJ-01-AB-1234", "Tata Winger", "Van", 2020);
-    vb2->kilometersRun = 9000;
-    vehicleIndex.insert(vb2);
+    // ============================================
+    // MODULE 6: COLUMNAR FLEET STORE
+    // ============================================
 
-    Vehicle* vb3 = new Vehicle("V208", "MH-14-CD-5678", "Mahindra Scorpio", "SUV", 2021);
-    vb3->kilometersRun = 7500;
-    vehicleIndex.insert(vb3);
+    cout << "\n\n--- MODULE 6: COLUMNAR FLEET STORE ---" << endl;
+    cout << "Testing Fleet-wide Scans over Struct-of-Arrays\n" << endl;
+
+    FleetStore fleetStore;
+    int fleetSize = 100000;
+    const char* fleetModels[] = {"Tata Ace", "Ashok Leyland", "Tata Winger", "Maruti Swift", "Mahindra Scorpio"};
+    fleetStore.reserve(fleetSize);
+    for(int i = 0; i < fleetSize; i++) {
+        Vehicle fv("F" + to_string(100000 + i), "REG-" + to_string(i), fleetModels[i % 5], "", 2015 + i % 10);
+        fv.type = (VehicleType)(i % 4);
+        fv.status = (VehicleStatus)(rng() % VEHICLE_STATUS_COUNT);
+        fv.kilometersRun = rng() % 20000;
+        fv.daysSinceLastService = rng() % 120;
+        if(fv.status == VEHICLE_IN_USE) fv.assignedDriverId = "D" + to_string(rng() % 5000);
+        fleetStore.addVehicle(fv);
+    }
+    fleetStore.displayStats();
+
+    vector<uint32_t> availableTrucks;
+    fleetStore.selectByStatusAndType(VEHICLE_AVAILABLE, VEHICLE_TRUCK, availableTrucks);
+    vector<uint32_t> dueForService;
+    fleetStore.selectNeedsMaintenance(dueForService);
+    cout << "Available trucks: " << availableTrucks.size() << endl;
+    cout << "Due for service: " << dueForService.size() << endl;
+
+    // Dashboard refresh: score the whole fleet in one vectorized pass
+    MaintenanceScorer maintenanceScorer;
+    vector<int32_t> fleetPriority;
+    vector<uint64_t> urgentBits;
+    size_t urgentCount = maintenanceScorer.scoreFleet(fleetStore, fleetPriority, urgentBits);
+    cout << "Maintenance scoring path: " << maintenanceScorer.getPathName() << endl;
+    cout << "Urgent vehicles (bitmask): " << urgentCount << endl;
+    if(urgentCount == dueForService.size()) {
+        cout << "✅ Vectorized urgency mask matches the per-row filter!" << endl;
+    }
 
-    Vehicle* vb4 = new Vehicle("V201", "DL-08-EF-9012", "Maruti Omni", "Van", 2018);
-    vb4->kilometersRun = 20000;
-    vehicleIndex.insert(vb4);
+    // Dashboard top list without sorting the whole fleet
+    vector<uint32_t> topRows;
+    MaintenanceScorer::topK(fleetPriority, 20, topRows);
+    cout << "Top 5 of the dashboard's top 20:";
+    for(size_t i = 0; i < 5 && i < topRows.size(); i++) {
+        cout << " " << fleetStore.vehicleId(topRows[i]) << "(" << fleetPriority[topRows[i]] << ")";
+    }
+    cout << endl;
 
-    Vehicle* vb5 = new Vehicle("V207", "KA-05-GH-3456", "Ashok Leyland", "Truck", 2019);
-    vb5->kilometersRun = 18000;
-    vehicleIndex.insert(vb5);
+    // Ad-hoc ops filter compiled to column scans and roaring bitmaps
+    FleetQueryEngine queryEngine(fleetStore);
+    FleetQuery opsQuery;
+    if(opsQuery.compile("year < 2019 AND type = Truck AND km > 15000 AND NOT MAINTENANCE")) {
+        vector<string_view> matchingIds;
+        queryEngine.vehicleIds(opsQuery, matchingIds);
+        cout << "Query: " << opsQuery.describe() << endl;
+        cout << "Matches: " << matchingIds.size();
+        if(!matchingIds.empty()) cout << " (first: " << matchingIds[0] << ")";
+        cout << endl;
+    }
+    FleetQuery badQuery;
+    if(!badQuery.compile("type = Plane")) {
+        cout << "✅ Bad query rejected: " << badQuery.getError() << endl;
+    }
 
-    Vehicle* vb6 = new Vehicle("V202", "TN-09-IJ-7890", "Force Traveller", "Van", 2020);
-    vb6->kilometersRun = 12000;
-    vehicleIndex.insert(vb6);
+    uint32_t sampleRow = fleetStore.findRow("F100042");
+    if(sampleRow != FLEET_NO_ROW) {
+        fleetStore.setStatus(sampleRow, VEHICLE_MAINTENANCE);
+        fleetStore.toVehicle(sampleRow).display();
+    }
+    fleetStore.removeVehicle("F100042");
+    cout << "After removing F100042: " << fleetStore.size() << " vehicles, lookup "
+         << (fleetStore.findRow("F100042") == FLEET_NO_ROW ? "not found ✅" : "still found ❌") << endl;
 
-    cout << endl;
+    cout << "\n✅ Fleet Store Module Complete!" << endl;
 
-    // Display sorted vehicles
-    vehicleIndex.displayAll();
+    // ============================================
+    // MODULE 7: AUTHENTICATION
+    // ============================================
 
-    // Display statistics
-    vehicleIndex.displayStats();
+    cout << "\n\n--- MODULE 7: USER AUTHENTICATION ---" << endl;
+    cout << "Testing Salted scrypt Password Hashing\n" << endl;
 
-    // Test Search - O(log n) binary search
-    cout << "\n--- TESTING BINARY SEARCH (O(log n)) ---" << endl;
-    cout << "Searching for V205..." << endl;
-    Vehicle* foundVehicle = vehicleIndex.search("V205");
-    if(foundVehicle != NULL) {
-        cout << "✅ Found: " << foundVehicle->model << " (" << foundVehicle->vehicleId << ")" << endl;
-        cout << "   Registration: " << foundVehicle->registrationNumber << endl;
-    } else {
-        cout << "❌ Vehicle not found!" << endl;
+    AuthSystem authSystem;
+    authSystem.registerUser("ravi@fleet.com", "r4vi-dispatch", "Ravi Menon");
+    authSystem.registerUser("neha@fleet.com", "neha-2024!", "Neha Joshi");
+    if(!authSystem.registerUser("ravi@fleet.com", "again", "Ravi Again")) {
+        cout << "✅ Duplicate email rejected" << endl;
     }
+    authSystem.updateUserStatus("ravi@fleet.com", "ACTIVE");
+
+    User* loggedIn = authSystem.login("ravi@fleet.com", "r4vi-dispatch");
+    cout << "Login with correct password: " << (loggedIn != NULL ? "✅ " + loggedIn->name : string("❌ failed")) << endl;
+    cout << "Login with wrong password: " << (authSystem.login("ravi@fleet.com", "guess") == NULL ? "✅ rejected" : "❌ accepted") << endl;
+    cout << "Login with unknown email: " << (authSystem.login("ghost@fleet.com", "r4vi-dispatch") == NULL ? "✅ rejected" : "❌ accepted") << endl;
+    authSystem.displayPendingUsers();
+
+    cout << "\nSession tokens:" << endl;
+    string token = authSystem.startSession("ravi@fleet.com", "r4vi-dispatch");
+    string secondToken = authSystem.startSession("ravi@fleet.com", "r4vi-dispatch");
+    cout << "Issued token: " << token << endl;
+    User* sessionUser = authSystem.validateSession(token);
+    cout << "Validate token: " << (sessionUser != NULL ? "✅ " + sessionUser->email : string("❌ rejected")) << endl;
+    cout << "Validate forged token: " << (authSystem.validateSession("0123456789abcdef0123456789abcdef") == NULL ? "✅ rejected" : "❌ accepted") << endl;
+    cout << "Active sessions: " << authSystem.getSessionCount() << endl;
+    authSystem.updateUserStatus("ravi@fleet.com", "INACTIVE");
+    cout << "Validate after deactivation: " << (authSystem.validateSession(secondToken) == NULL ? "✅ rejected" : "❌ accepted") << endl;
+    cout << "New session after deactivation: " << (authSystem.startSession("ravi@fleet.com", "r4vi-dispatch") == "" ? "✅ refused" : "❌ issued") << endl;
+
+    cout << "✅ Authentication Module Complete!" << endl;
 
-    cout << "\nSearching for V201..." << endl;
-    Vehicle* foundVehicle2 = vehicleIndex.search("V201");
-    if(foundVehicle2 != NULL) {
-        cout << "✅ Found: " << foundVehicle2->model << " (" << foundVehicle2->vehicleId << ")" << endl;
-    } else {
-        cout << "❌ Vehicle not found!" << endl;
+    // ============================================
+    // MODULE 8: DURABILITY (WAL + SNAPSHOTS)
+    // ============================================
+
+    cout << "\n\n--- MODULE 8: CRASH-SAFE VEHICLE JOURNAL ---" << endl;
+    cout << "Testing Write-Ahead Log, Snapshots & Recovery\n" << endl;
+
+    {
+        remove("fleet_journal.wal");
+        remove("fleet_journal.snap");
+
+        HashTable journaledTable;
+        FleetJournal journal(journaledTable, "fleet_journal");
+        journal.recover();
+        // The caller keeps the vehicle if it was rejected or never logged
+        auto journalInsert = [&journal](Vehicle* v) {
+            JournalResult result = journal.insert(v);
+            if(result == JOURNAL_REJECTED || result == JOURNAL_LOG_FAILED) {
+                cout << "❌ Journal insert of " << v->vehicleId << " failed" << endl;
+                delete v;
+            }
+        };
+        journalInsert(new Vehicle("J101", "MH-12-AB-1111", "Tata Ace", "Van", 2021));
+        journalInsert(new Vehicle("J102", "KA-05-CD-2222", "Ashok Leyland", "Truck", 2018));
+        journalInsert(new Vehicle("J103", "DL-03-EF-3333", "Maruti Ertiga", "Car", 2022));
+        journalInsert(new Vehicle("J103", "DL-03-EF-9999", "Duplicate", "Car", 2022));
+        journal.updateOdometer("J101", 18250, 40);
+        journal.checkpoint();
+
+        // These only live in the WAL until the next checkpoint
+        journal.updateStatus("J102", VEHICLE_MAINTENANCE);
+        journal.assignDriver("J103", "D7");
+        journal.deleteVehicle("J101");
+        journalInsert(new Vehicle("J104", "TN-09-GH-4444", "Force Traveller", "Bus", 2020));
+        journal.displayStats();
     }
 
-    cout << "\nSearching for V999 (doesn't exist)..." << endl;
-    Vehicle* notFoundBTree = vehicleIndex.search("V999");
-    if(notFoundBTree == NULL) {
-        cout << "❌ Vehicle not found (as expected)\n" << endl;
+    // Simulate a crash that tore the last record half-way through
+    struct stat walInfo;
+    if(stat("fleet_journal.wal", &walInfo) == 0) {
+        truncate("fleet_journal.wal", walInfo.st_size - 7);
     }
 
-    // Test Range Query
-    vehicleIndex.displayRange("V203", "V207");
+    cout << "💥 Process restarted with a torn WAL tail\n" << endl;
+    HashTable recoveredTable;
+    FleetJournal recoveredJournal(recoveredTable, "fleet_journal");
+    recoveredJournal.recover();
+    cout << "Recovered vehicles: " << recoveredTable.getTotalVehicles()
+         << " (torn bytes discarded: " << recoveredJournal.getTornBytes() << ")" << endl;
+    Vehicle* recoveredTruck = recoveredTable.search("J102");
+    cout << "J102 status after recovery: " << (recoveredTruck != NULL ? vehicleStatusName(recoveredTruck->status) : "missing") << endl;
+    cout << "J101 deleted before crash: " << (recoveredTable.search("J101") == NULL ? "✅ still deleted" : "❌ resurrected") << endl;
+    cout << "J104 (torn insert): " << (recoveredTable.search("J104") == NULL ? "dropped with the torn record" : "recovered") << endl;
+    remove("fleet_journal.wal");
+    remove("fleet_journal.snap");
+
+    // Read-only copy that a restarted process can query without parsing
+    MappedFleetWriter mappedWriter;
+    mappedWriter.addAll(recoveredTable);
+    mappedWriter.write("fleet_snapshot.fleet");
+    MappedFleet mappedFleet;
+    if(mappedFleet.open("fleet_snapshot.fleet", true)) {
+        uint32_t row = mappedFleet.find("J103");
+        if(row != MAPPED_NO_ROW) {
+            cout << "Mapped lookup J103: " << mappedFleet.model(row) << ", driver " << mappedFleet.driverId(row) << endl;
+        }
+        mappedFleet.displayStats();
+        mappedFleet.close();
+    }
+    remove("fleet_snapshot.fleet");
 
-    cout << "\n✅ B-Tree Module Complete!" << endl;
-    cout << "✅ O(log n) Binary Search & Sorted Storage implemented!" << endl;
-    cout << "\n--- TESTING DUPLICATE PREVENTION ---" << endl;
-    Vehicle* duplicate = new Vehicle("VB99", "KA-03-CC-3333", "Duplicate Car", "Car", 2023);
-    vehicleIndex.insert(duplicate);
+    cout << "✅ Durability Module Complete!" << endl;
 
-    cout << "\n✅ B-Tree Module Complete!" << endl;
-    cout << "✅ O(log n) Sorted Indexing & Range Queries implemented!" << endl;
+    // ============================================
+    // MODULE 9: LIVE TRIP TELEMETRY
+    // ============================================
+
+    cout << "\n\n--- MODULE 9: GPS TELEMETRY INGESTION ---" << endl;
+    cout << "Testing Lock-Free Position Table & Coalesced Flushes\n" << endl;
+
+    TelemetryIngest telemetry(1024, 5000);
+    telemetry.setSink([](const vector<TripPosition>& batch) {
+        cout << "💾 Flush: 1 UPDATE for " << batch.size() << " trips" << endl;
+        for(const TripPosition& p : batch) {
+            cout << "   " << p.tripId << " -> (" << p.latitude << ", " << p.longitude << ")" << endl;
+        }
+        return true;
+    });
+    telemetry.startTrip("TRIP-501");
+    telemetry.startTrip("TRIP-502");
+
+    // One batched frame: several pings per trip, one arriving out of order
+    telemetry.ingestFrame("TRIP-501,12.9716000,77.5946000,32.5,1000\n"
+                          "TRIP-502,19.0760000,72.8777000,18.0,1000\n"
+                          "TRIP-501,12.9721000,77.5952000,35.0,2000\n"
+                          "TRIP-501,12.9718000,77.5949000,34.0,1500\n"
+                          "TRIP-502,19.0764000,72.8781000,21.5,2000\n"
+                          "TRIP-999,28.6139000,77.2090000,10.0,2000\n");
+    TripPosition livePosition;
+    if(telemetry.getPosition("TRIP-501", livePosition)) {
+        cout << "Live TRIP-501: (" << livePosition.latitude << ", " << livePosition.longitude << ") at "
+             << livePosition.speed << " km/h" << endl;
+    }
+    telemetry.flushIfDue(5000);
+    telemetry.endTrip("TRIP-502");
+    telemetry.displayStats();
+
+    cout << "✅ Telemetry Module Complete!" << endl;
+
+    // ============================================
+    // MODULE 10: NEAREST-VEHICLE DISPATCH
+    // ============================================
+
+    cout << "\n\n--- MODULE 10: SPATIAL DISPATCH INDEX ---" << endl;
+    cout << "Testing k-Nearest & Radius Queries Over Live Positions\n" << endl;
+
+    SpatialGrid dispatchGrid(1.0);
+    dispatchGrid.upsert("D-V1", 12.9716, 77.5946, VEHICLE_AVAILABLE);    // MG Road
+    dispatchGrid.upsert("D-V2", 12.9352, 77.6245, VEHICLE_AVAILABLE);    // Koramangala
+    dispatchGrid.upsert("D-V3", 12.9784, 77.6408, VEHICLE_IN_USE);       // Indiranagar
+    dispatchGrid.upsert("D-V4", 13.0358, 77.5970, VEHICLE_AVAILABLE);    // Hebbal
+    dispatchGrid.upsert("D-V5", 12.9141, 77.6101, VEHICLE_MAINTENANCE);  // BTM Layout
+
+    vector<SpatialMatch> nearby;
+    double pickupLat = 12.9698, pickupLon = 77.6205;
+    dispatchGrid.nearest(pickupLat, pickupLon, 2, VEHICLE_STATUS_BIT(VEHICLE_AVAILABLE), nearby);
+    cout << "2 nearest AVAILABLE to pickup:" << endl;
+    for(const SpatialMatch& m : nearby) {
+        cout << "   " << m.vehicleId << " - " << m.distanceKm << " km" << endl;
+    }
+
+    dispatchGrid.updatePosition("D-V4", 12.9760, 77.6150);    // Drove into town
+    dispatchGrid.setStatus("D-V3", VEHICLE_AVAILABLE);        // Finished its trip
+    dispatchGrid.withinRadius(pickupLat, pickupLon, 5.0, VEHICLE_STATUS_BIT(VEHICLE_AVAILABLE), nearby);
+    cout << "AVAILABLE within 5 km after updates:" << endl;
+    for(const SpatialMatch& m : nearby) {
+        cout << "   " << m.vehicleId << " - " << m.distanceKm << " km" << endl;
+    }
+    dispatchGrid.displayStats();
+
+    cout << "✅ Spatial Dispatch Module Complete!" << endl;
+
+    // ============================================
+    // MODULE 11: MAP MATCHING
+    // ============================================
+
+    cout << "\n\n--- MODULE 11: GPS MAP MATCHING ---" << endl;
+    cout << "Snapping Noisy Trip Traces Onto the Grid City Roads\n" << endl;
+
+    const CSRGraph& cityRoads = gridCity.getCSR();
+    RoadSegmentIndex segmentIndex(cityRoads);
+    vector<RouteQuery> tripRoutes = {{0, 1599}, {45, 1210}, {800, 333}};
+    vector<vector<GpsPoint>> dayTraces;
+    vector<double> routeKm;
+    normal_distribution<double> gpsNoise(0.0, 0.01 / KM_PER_DEGREE);    // ~10 m
+    for(const RouteQuery& q : tripRoutes) {
+        // A fix every ~150 m along the planned route
+        gridCity.findRoute(q.source, q.destination, plainRoute);
+        vector<GpsPoint> trace;
+        double km = 0;
+        int64_t clock = 1700000000000LL;
+        for(size_t i = 0; i + 1 < plainRoute.nodes.size(); i++) {
+            int u = plainRoute.nodes[i], v = plainRoute.nodes[i + 1];
+            double legKm = haversineKm(cityRoads.latitude(u), cityRoads.longitude(u), cityRoads.latitude(v), cityRoads.longitude(v));
+            int steps = (int)(legKm / 0.15);
+            for(int s = 0; s < steps; s++) {
+                double f = (double)s / steps;
+                trace.push_back(GpsPoint{cityRoads.latitude(u) + f * (cityRoads.latitude(v) - cityRoads.latitude(u)) + gpsNoise(rng),
+                                         cityRoads.longitude(u) + f * (cityRoads.longitude(v) - cityRoads.longitude(u)) + gpsNoise(rng),
+                                         clock});
+                clock += 15000;
+            }
+            km += legKm;
+        }
+        int last = plainRoute.nodes.back();
+        trace.push_back(GpsPoint{cityRoads.latitude(last), cityRoads.longitude(last), clock});
+        dayTraces.push_back(trace);
+        routeKm.push_back(km);
+    }
+
+    MapMatcher mapMatcher(segmentIndex, workerPool);
+    vector<MatchedTrip> matchedTrips;
+    mapMatcher.matchAll(dayTraces, matchedTrips);
+    for(size_t t = 0; t < matchedTrips.size(); t++) {
+        const MatchedTrip& m = matchedTrips[t];
+        cout << "Trip J" << tripRoutes[t].source << " -> J" << tripRoutes[t].destination << ": " << m.points
+             << " fixes -> " << m.edges.size() << " roads, " << m.distanceKm << " km driven (route: " << routeKm[t] << " km)" << endl;
+    }
+    mapMatcher.displayStats();
+
+    cout << "✅ Map Matching Module Complete!" << endl;
+
+    // ============================================
+    // MODULE 12: TELEMETRY HISTORY
+    // ============================================
+
+    cout << "\n\n--- MODULE 12: COMPRESSED TELEMETRY HISTORY ---" << endl;
+    cout << "Testing Per-Vehicle Range Scans Over Gorilla-Coded Blocks\n" << endl;
+
+    TimeSeriesStore history;
+    const int64_t historyStart = 1700000000000LL;
+    const int64_t dayMs = 86400000LL;
+    for(int day = 0; day < 3; day++) {
+        for(const char* id : {"V001", "V003"}) {
+            // 08:00-18:00, a fix every 30 s while driving slowly north-east
+            double lat = 12.9716, lon = 77.5946;
+            for(int64_t t = 8 * 3600000LL; t < 18 * 3600000LL; t += 30000) {
+                lat += 0.00002;
+                lon += 0.00003;
+                history.append(id, TelemetrySample{historyStart + day * dayMs + t, lat, lon, (float)(30 + (t / 30000) % 20)});
+            }
+        }
+    }
+    history.append("V001", TelemetrySample{historyStart, 12.97, 77.59, 0});    // Older than the latest fix
+
+    vector<TelemetrySample> dayTwo;
+    history.scan("V001", historyStart + dayMs, historyStart + 2 * dayMs - 1, dayTwo);
+    cout << "V001 fixes on day 2: " << dayTwo.size() << " (count: "
+         << history.count("V001", historyStart + dayMs, historyStart + 2 * dayMs - 1) << ")" << endl;
+    if(!dayTwo.empty()) {
+        cout << "   first: " << dayTwo.front().latitude << ", " << dayTwo.front().longitude << " at "
+             << dayTwo.front().speed << " km/h" << endl;
+        cout << "   last:  " << dayTwo.back().latitude << ", " << dayTwo.back().longitude << " at "
+             << dayTwo.back().speed << " km/h" << endl;
+    }
+    history.displayStats();
+
+    cout << "✅ Telemetry History Module Complete!" << endl;
+
+    // ============================================
+    // MODULE 13: DASHBOARD AGGREGATES
+    // ============================================
+
+    cout << "\n\n--- MODULE 13: INCREMENTAL DASHBOARD COUNTERS ---" << endl;
+    cout << "Testing Counters Kept in Step With Vehicle, User and Trip Changes\n" << endl;
+
+    DashboardAggregates dashboard;
+    dashboard.attach(vehicleDB);
+    dashboard.attach(authSystem);
+    DashboardSnapshot before = dashboard.snapshot();
+    cout << "Attached: " << before.vehicles << " vehicles, " << before.users << " users" << endl;
+
+    // Drivers are EMPLOYEE accounts; a vehicle is assigned by their userId
+    authSystem.registerUser("arjun@fleet.com", "arjun-van-7", "Arjun Rao");
+    authSystem.updateUserStatus("arjun@fleet.com", "ACTIVE");
+    authSystem.updateUserStatus("neha@fleet.com", "ACTIVE");
+    vehicleDB.updateStatus("V003", VEHICLE_IN_USE);
+    vehicleDB.assignDriver("V003", authSystem.getUserByEmail("arjun@fleet.com")->userId);
+    for(const MatchedTrip& m : matchedTrips) {
+        dashboard.tripStarted();
+        dashboard.tripCompleted(m.distanceKm);
+    }
+    dashboard.tripStarted();     // Still on the road
+
+    DashboardSnapshot after = dashboard.snapshot();
+    cout << "IN_USE vehicles: " << before.vehiclesByStatus[VEHICLE_IN_USE] << " -> " << after.vehiclesByStatus[VEHICLE_IN_USE] << endl;
+    cout << "Active drivers: " << before.driversActive << " -> " << after.driversActive << " (assigned: "
+         << after.driversAssigned << ", available: " << after.driversAvailable << ")" << endl;
+    cout << "Snapshot " << before.version << " -> " << after.version << " after "
+         << after.version - before.version << " changes" << endl;
+    dashboard.displayStats();
+
+    cout << "✅ Dashboard Aggregates Module Complete!" << endl;
 
     // ============================================
     // FINAL SUMMARY
@@ -390,6 +1006,7 @@ int main() {
     cout << "✅ MODULE 1: Hash Table" << endl;
     cout << "   → O(1) Vehicle Management" << endl;
     cout << "   → Insert, Search, Delete operations" << endl;
+    cout << "   → Status/type bitmaps and driver index" << endl;
     cout << endl;
     cout << "✅ MODULE 2: Queue (FIFO)" << endl;
     cout << "   → Fair Driver Assignment" << endl;
@@ -405,7 +1022,42 @@ int main() {
     cout << endl;
     cout << "✅ MODULE 5: B-Tree" << endl;
     cout << "   → O(log n) Sorted Indexing" << endl;
-    cout << "   → Balanced tree for disk-based storage" << endl;
+    cout << "   → Page-cached B+Tree persisted to disk" << endl;
+    cout << endl;
+    cout << "✅ MODULE 6: Fleet Store" << endl;
+    cout << "   → Struct-of-arrays columns with enum codes" << endl;
+    cout << "   → Interned 32-bit IDs for fleet-wide scans" << endl;
+    cout << "   → Predicate queries over roaring bitmaps" << endl;
+    cout << endl;
+    cout << "✅ MODULE 7: Authentication" << endl;
+    cout << "   → Salted scrypt hashes, constant-time verify" << endl;
+    cout << "   → Growable hash table with shared locking" << endl;
+    cout << "   → Sharded session tokens with timer-wheel expiry" << endl;
+    cout << endl;
+    cout << "✅ MODULE 8: Durability" << endl;
+    cout << "   → Checksummed write-ahead log with group commit" << endl;
+    cout << "   → Atomic snapshots, torn-tail recovery" << endl;
+    cout << "   → mmap'ed zero-copy snapshot for instant startup" << endl;
+    cout << endl;
+    cout << "✅ MODULE 9: GPS Telemetry" << endl;
+    cout << "   → Seqlock per-trip latest-position table" << endl;
+    cout << "   → Coalesced batch flushes, out-of-order pings dropped" << endl;
+    cout << endl;
+    cout << "✅ MODULE 10: Spatial Dispatch" << endl;
+    cout << "   → Uniform grid with incremental moves" << endl;
+    cout << "   → k-nearest and radius queries with status filters" << endl;
+    cout << endl;
+    cout << "✅ MODULE 11: Map Matching" << endl;
+    cout << "   → Grid index over road segments" << endl;
+    cout << "   → HMM/Viterbi traces to edges and driven km, in parallel" << endl;
+    cout << endl;
+    cout << "✅ MODULE 12: Telemetry History" << endl;
+    cout << "   → Delta-of-delta and XOR coded column blocks" << endl;
+    cout << "   → Min/max time index for per-vehicle range scans" << endl;
+    cout << endl;
+    cout << "✅ MODULE 13: Dashboard Aggregates" << endl;
+    cout << "   → Counters fed by table and account observers" << endl;
+    cout << "   → O(1) snapshot copy per dashboard read" << endl;
     cout << endl;
     cout << "========================================" << endl;
     cout << "  Ready for Teacher Demonstration! 🚀" << endl;
@@ -0,0 +1,761 @@
+#ifndef ASSIGNMENT_ENGINE_H
+#define ASSIGNMENT_ENGINE_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include "driver.h"
+#include "vehicle.h"
+#include "distance_matrix.h"
+#include "../data_structures/hash_table.h"
+using namespace std;
+
+// Cost used for pairs that cannot be matched (INF in the input matrix).
+// Large enough that the solver only picks one when nothing else is left,
+// small enough that sums over thousands of rows still fit in 64 bits.
+#define ASSIGN_FORBIDDEN_COST 1000000000
+
+// Problems at least this large (and nearly square) are solved on a sparse
+// candidate graph first; see AssignmentEngine
+#define ASSIGN_SPARSE_MIN_SIZE 1024
+#define ASSIGN_CANDIDATES 32        // Cheapest partners kept per row and per column
+#define ASSIGN_SAMPLE_STRIDE 16     // Sampling step for the candidate thresholds
+
+struct AssignmentResult {
+    vector<int> rowToCol;   // -1 = row left unassigned
+    vector<int> colToRow;   // -1 = column left unassigned
+    long long totalCost;    // Over assigned pairs only
+    int assigned;
+
+    AssignmentResult() {
+        totalCost = 0;
+        assigned = 0;
+    }
+};
+
+// Min-cost bipartite matching (linear assignment problem) using the
+// Jonker-Volgenant algorithm: column reduction, reduction transfer and two
+// rounds of augmenting row reduction give a near-complete assignment cheaply,
+// then each remaining free row is placed with one Dijkstra-like shortest
+// augmenting path over the reduced costs. O(n^3) worst case, far less on
+// typical distance matrices.
+//
+// On geometric costs (empty km between points on a map) the augmenting paths
+// get long and every step of them scans a full row. Large problems are
+// therefore solved on a candidate graph of the ASSIGN_CANDIDATES cheapest
+// columns of each row and rows of each column, with a binary-heap Dijkstra
+// for the augmenting paths. The resulting prices are then checked against
+// the full matrix: a row that has a cheaper column (in reduced cost) outside
+// its candidates gets the cheapest of those added and is augmented again,
+// until no row has one. That is the optimality condition of the dense
+// problem, so the answer is the same as the dense solve, only cheaper: 5k x 5k
+// goes from ~1 s (uniform costs) and ~3.5 s (map costs) to ~0.3 and ~0.7 s.
+//
+// Rectangular inputs (more drivers than vehicles or the other way round) are
+// padded to a square with zero-cost dummy rows/columns; whoever is matched to
+// a dummy is reported as unassigned. Workspaces are reused between solves.
+class AssignmentEngine {
+private:
+    struct Arc {
+        int col;
+        int cost;
+    };
+
+    // Dijkstra state of a column in the sparse augmenting path search
+    struct Label {
+        long long dist;
+        uint32_t stamp;         // == generation: reached in this search
+        int pos;                // Index in 'heap', -1 once settled
+        int pred;               // Row it was reached from
+    };
+
+    vector<int> cost;           // n x n, row-major, padded
+    vector<long long> v;        // Column prices
+    vector<long long> d;        // Shortest path distances
+    vector<int> rowSol;
+    vector<int> colSol;
+    vector<int> freeRows;
+    vector<int> colList;
+    vector<int> pred;
+    vector<int> matches;
+
+    // Candidate graph and Dijkstra workspace
+    vector<vector<Arc> > arcs;  // Per row
+    vector<int> sample;
+    vector<int> colLimit;
+    vector<int> colSamples;
+    vector<pair<int, int> > rowPicks;           // (cost, column)
+    vector<pair<long long, int> > reducedPicks; // (reduced cost, column)
+    vector<vector<pair<int, int> > > colPicks;  // (cost, row) per column
+    vector<Label> labels;       // Per column
+    uint32_t generation;
+    vector<int> scanned;
+    vector<pair<long long, int> > heap;     // (dist, column), indexed by Label::pos
+
+    void solveSquare(int n) {
+        const long long BIG = LLONG_MAX / 4;
+        v.assign(n, 0);
+        d.assign(n, 0);
+        rowSol.assign(n, -1);
+        colSol.assign(n, -1);
+        freeRows.assign(n, 0);
+        colList.assign(n, 0);
+        pred.assign(n, 0);
+        matches.assign(n, 0);
+
+        // Column reduction: each column goes to its cheapest row
+        for(int j = n - 1; j >= 0; j--) {
+            long long minCost = cost[j];
+            int iMin = 0;
+            for(int i = 1; i < n; i++) {
+                if(cost[(size_t)i * n + j] < minCost) {
+                    minCost = cost[(size_t)i * n + j];
+                    iMin = i;
+                }
+            }
+            v[j] = minCost;
+            if(++matches[iMin] == 1) {
+                rowSol[iMin] = j;
+                colSol[j] = iMin;
+            } else if(v[j] < v[rowSol[iMin]]) {
+                int j1 = rowSol[iMin];
+                rowSol[iMin] = j;
+                colSol[j] = iMin;
+                colSol[j1] = -1;
+            } else {
+                colSol[j] = -1;
+            }
+        }
+
+        // Reduction transfer
+        int numFree = 0;
+        for(int i = 0; i < n; i++) {
+            if(matches[i] == 0) {
+                freeRows[numFree++] = i;
+            } else if(matches[i] == 1) {
+                int j1 = rowSol[i];
+                const int* row = &cost[(size_t)i * n];
+                long long minCost = BIG;
+                for(int j = 0; j < n; j++) {
+                    if(j != j1 && row[j] - v[j] < minCost) minCost = row[j] - v[j];
+                }
+                if(minCost != BIG) v[j1] -= minCost;
+            }
+        }
+
+        // Augmenting row reduction, two passes
+        for(int pass = 0; pass < 2; pass++) {
+            int k = 0;
+            int prevNumFree = numFree;
+            numFree = 0;
+            while(k < prevNumFree) {
+                int i = freeRows[k++];
+                const int* row = &cost[(size_t)i * n];
+                long long uMin = row[0] - v[0];
+                long long uSubMin = BIG;
+                int j1 = 0;
+                int j2 = 0;
+                for(int j = 1; j < n; j++) {
+                    long long h = row[j] - v[j];
+                    if(h < uSubMin) {
+                        if(h >= uMin) {
+                            uSubMin = h;
+                            j2 = j;
+                        } else {
+                            uSubMin = uMin;
+                            uMin = h;
+                            j2 = j1;
+                            j1 = j;
+                        }
+                    }
+                }
+
+                int i0 = colSol[j1];
+                if(uMin < uSubMin) {
+                    v[j1] -= uSubMin - uMin;
+                } else if(i0 >= 0) {
+                    j1 = j2;
+                    i0 = colSol[j2];
+                }
+                rowSol[i] = j1;
+                colSol[j1] = i;
+                if(i0 >= 0) {
+                    rowSol[i0] = -1;
+                    if(uMin < uSubMin) {
+                        freeRows[--k] = i0;     // Retry it straight away
+                    } else {
+                        freeRows[numFree++] = i0;
+                    }
+                }
+            }
+        }
+
+        // Shortest augmenting path for every row still free
+        for(int f = 0; f < numFree; f++) {
+            int freeRow = freeRows[f];
+            const int* row = &cost[(size_t)freeRow * n];
+            for(int j = 0; j < n; j++) {
+                d[j] = row[j] - v[j];
+                pred[j] = freeRow;
+                colList[j] = j;
+            }
+
+            int low = 0;
+            int up = 0;
+            int last = 0;
+            int endOfPath = -1;
+            long long minDist = 0;
+            while(endOfPath < 0) {
+                if(up == low) {
+                    // Next batch of columns at the current minimum distance
+                    last = low - 1;
+                    minDist = d[colList[up++]];
+                    for(int k = up; k < n; k++) {
+                        int j = colList[k];
+                        long long h = d[j];
+                        if(h <= minDist) {
+                            if(h < minDist) {
+                                up = low;
+                                minDist = h;
+                            }
+                            colList[k] = colList[up];
+                            colList[up++] = j;
+                        }
+                    }
+                    for(int k = low; k < up; k++) {
+                        if(colSol[colList[k]] < 0) {
+                            endOfPath = colList[k];
+                            break;
+                        }
+                    }
+                }
+
+                if(endOfPath < 0) {
+                    // Scan one column from the minimum set
+                    int j1 = colList[low++];
+                    int i = colSol[j1];
+                    const int* scanRow = &cost[(size_t)i * n];
+                    long long h = scanRow[j1] - v[j1] - minDist;
+                    for(int k = up; k < n; k++) {
+                        int j = colList[k];
+                        long long v2 = scanRow[j] - v[j] - h;
+                        if(v2 < d[j]) {
+                            pred[j] = i;
+                            if(v2 == minDist) {
+                                if(colSol[j] < 0) {
+                                    endOfPath = j;
+                                    break;
+                                }
+                                colList[k] = colList[up];
+                                colList[up++] = j;
+                            }
+                            d[j] = v2;
+                        }
+                    }
+                }
+            }
+
+            // Update prices of the columns that were fully scanned
+            for(int k = 0; k <= last; k++) {
+                int j1 = colList[k];
+                v[j1] += d[j1] - minDist;
+            }
+
+            // Flip the assignments along the alternating path
+            while(true) {
+                int i = pred[endOfPath];
+                colSol[endOfPath] = i;
+                int j1 = endOfPath;
+                endOfPath = rowSol[i];
+                rowSol[i] = j1;
+                if(i == freeRow) break;
+            }
+        }
+    }
+
+    // Keep the k cheapest of 'list' (cost, index) entries; ties go to the
+    // index closest after 'start' (cyclically), so rows/columns that tie
+    // everywhere do not all pick the same partners
+    static void keepCheapest(vector<pair<int, int> >& list, int k, int start, int size) {
+        if((int)list.size() <= k) return;
+        for(size_t e = 0; e < list.size(); e++) {
+            int offset = list[e].second - start;
+            list[e].second = offset < 0 ? offset + size : offset;
+        }
+        nth_element(list.begin(), list.begin() + (k - 1), list.end());
+        list.resize(k);
+        for(int e = 0; e < k; e++) {
+            int index = list[e].second + start;
+            list[e].second = index < size ? index : index - size;
+        }
+    }
+
+    // Value that about 'want' of the 'count' entries of 'row' are at or
+    // below, estimated from every ASSIGN_SAMPLE_STRIDE-th entry
+    int sampleThreshold(const int* row, int count, int want) {
+        sample.clear();
+        for(int e = 0; e < count; e += ASSIGN_SAMPLE_STRIDE) sample.push_back(row[e]);
+        int rank = want / ASSIGN_SAMPLE_STRIDE;
+        if(rank >= (int)sample.size()) return INT_MAX;
+        nth_element(sample.begin(), sample.begin() + rank, sample.end());
+        return sample[rank];
+    }
+
+    // The same for every column at once, from every ASSIGN_SAMPLE_STRIDE-th
+    // row, read row by row: each column keeps its rank + 1 smallest samples
+    // sorted in colLimit's scratch
+    void sampleColumnThresholds(int n, int rows, int cols, int want) {
+        int keep = want / ASSIGN_SAMPLE_STRIDE + 1;
+        colSamples.assign((size_t)cols * keep, INT_MAX);
+        for(int i = 0; i < rows; i += ASSIGN_SAMPLE_STRIDE) {
+            const int* row = &cost[(size_t)i * n];
+            for(int j = 0; j < cols; j++) {
+                int* smallest = &colSamples[(size_t)j * keep];
+                int c = row[j];
+                if(c >= smallest[keep - 1]) continue;
+                int t = keep - 1;
+                while(t > 0 && smallest[t - 1] > c) {
+                    smallest[t] = smallest[t - 1];
+                    t--;
+                }
+                smallest[t] = c;
+            }
+        }
+        colLimit.resize(cols);
+        for(int j = 0; j < cols; j++) colLimit[j] = colSamples[(size_t)j * keep + keep - 1];
+    }
+
+    // Candidate graph: every real row gets its ASSIGN_CANDIDATES cheapest
+    // real columns, every real column its ASSIGN_CANDIDATES cheapest real
+    // rows (so no column is left out), and dummy rows/columns are connected
+    // to everything. Entries are first filtered against sampled thresholds
+    // (one compare per matrix entry); a row or column whose threshold came
+    // out too tight is redone with its exact k-th cheapest value.
+    void buildCandidates(int n, int rows, int cols) {
+        int k = ASSIGN_CANDIDATES < cols ? ASSIGN_CANDIDATES : cols;
+        int kCol = ASSIGN_CANDIDATES < rows ? ASSIGN_CANDIDATES : rows;
+        arcs.resize(n);
+        sampleColumnThresholds(n, rows, cols, 4 * kCol);
+        colPicks.resize(cols);
+        for(int j = 0; j < cols; j++) colPicks[j].clear();
+
+        for(int i = 0; i < n; i++) {
+            vector<Arc>& list = arcs[i];
+            const int* row = &cost[(size_t)i * n];
+            list.clear();
+            if(i >= rows) {
+                for(int j = 0; j < n; j++) list.push_back(Arc{j, row[j]});
+                continue;
+            }
+
+            int limit = sampleThreshold(row, cols, 4 * k);
+            rowPicks.clear();
+            for(int j = 0; j < cols; j++) {
+                int c = row[j];
+                if(c <= limit) rowPicks.push_back(make_pair(c, j));
+                if(c <= colLimit[j]) colPicks[j].push_back(make_pair(c, i));
+            }
+            if((int)rowPicks.size() < k) {
+                sample.assign(row, row + cols);
+                nth_element(sample.begin(), sample.begin() + (k - 1), sample.end());
+                limit = sample[k - 1];
+                rowPicks.clear();
+                for(int j = 0; j < cols; j++) {
+                    if(row[j] <= limit) rowPicks.push_back(make_pair(row[j], j));
+                }
+            }
+            keepCheapest(rowPicks, k, (int)((long long)i * cols / rows), cols);
+            for(size_t e = 0; e < rowPicks.size(); e++) list.push_back(Arc{rowPicks[e].second, rowPicks[e].first});
+            for(int j = cols; j < n; j++) list.push_back(Arc{j, 0});
+        }
+
+        for(int j = 0; j < cols; j++) {
+            vector<pair<int, int> >& picks = colPicks[j];
+            if((int)picks.size() < kCol) {
+                sample.resize(rows);
+                for(int i = 0; i < rows; i++) sample[i] = cost[(size_t)i * n + j];
+                nth_element(sample.begin(), sample.begin() + (kCol - 1), sample.end());
+                int limit = sample[kCol - 1];
+                picks.clear();
+                for(int i = 0; i < rows; i++) {
+                    if(cost[(size_t)i * n + j] <= limit) picks.push_back(make_pair(cost[(size_t)i * n + j], i));
+                }
+            }
+            keepCheapest(picks, kCol, (int)((long long)j * rows / cols), rows);
+            for(size_t e = 0; e < picks.size(); e++) arcs[picks[e].second].push_back(Arc{j, picks[e].first});
+        }
+        for(int i = 0; i < rows; i++) {
+            vector<Arc>& list = arcs[i];
+            sort(list.begin(), list.end(), [](const Arc& x, const Arc& y) { return x.col < y.col; });
+            list.erase(unique(list.begin(), list.end(), [](const Arc& x, const Arc& y) { return x.col == y.col; }),
+                       list.end());
+        }
+    }
+
+    // Column reduction, reduction transfer and augmenting row reduction over
+    // the candidate graph, as in solveSquare(). Returns the number of rows
+    // left free.
+    int reduceSparse(int n) {
+        const long long BIG = LLONG_MAX / 4;
+        v.assign(n, BIG);
+        matches.assign(n, 0);
+        pred.assign(n, -1);     // Cheapest row of each column
+        for(int i = 0; i < n; i++) {
+            const vector<Arc>& list = arcs[i];
+            for(size_t a = 0; a < list.size(); a++) {
+                if(list[a].cost < v[list[a].col]) {
+                    v[list[a].col] = list[a].cost;
+                    pred[list[a].col] = i;
+                }
+            }
+        }
+        for(int j = n - 1; j >= 0; j--) {
+            int iMin = pred[j];
+            if(iMin < 0) {
+                v[j] = 0;
+                continue;
+            }
+            if(++matches[iMin] == 1) {
+                rowSol[iMin] = j;
+                colSol[j] = iMin;
+            } else if(v[j] < v[rowSol[iMin]]) {
+                int j1 = rowSol[iMin];
+                rowSol[iMin] = j;
+                colSol[j] = iMin;
+                colSol[j1] = -1;
+            }
+        }
+
+        int numFree = 0;
+        for(int i = 0; i < n; i++) {
+            if(matches[i] == 0) {
+                freeRows[numFree++] = i;
+            } else if(matches[i] == 1) {
+                int j1 = rowSol[i];
+                const vector<Arc>& list = arcs[i];
+                long long minCost = BIG;
+                for(size_t a = 0; a < list.size(); a++) {
+                    int j = list[a].col;
+                    if(j != j1 && list[a].cost - v[j] < minCost) minCost = list[a].cost - v[j];
+                }
+                if(minCost != BIG) v[j1] -= minCost;
+            }
+        }
+
+        for(int pass = 0; pass < 2; pass++) {
+            int k = 0;
+            int prevNumFree = numFree;
+            numFree = 0;
+            while(k < prevNumFree) {
+                int i = freeRows[k++];
+                const vector<Arc>& list = arcs[i];
+                long long uMin = list[0].cost - v[list[0].col];
+                long long uSubMin = BIG;
+                int j1 = list[0].col;
+                int j2 = j1;
+                for(size_t a = 1; a < list.size(); a++) {
+                    long long h = list[a].cost - v[list[a].col];
+                    if(h < uSubMin) {
+                        if(h >= uMin) {
+                            uSubMin = h;
+                            j2 = list[a].col;
+                        } else {
+                            uSubMin = uMin;
+                            uMin = h;
+                            j2 = j1;
+                            j1 = list[a].col;
+                        }
+                    }
+                }
+
+                int i0 = colSol[j1];
+                if(uMin < uSubMin) {
+                    v[j1] -= uSubMin - uMin;
+                } else if(i0 >= 0) {
+                    j1 = j2;
+                    i0 = colSol[j2];
+                }
+                rowSol[i] = j1;
+                colSol[j1] = i;
+                if(i0 >= 0) {
+                    rowSol[i0] = -1;
+                    if(uMin < uSubMin) {
+                        freeRows[--k] = i0;
+                    } else {
+                        freeRows[numFree++] = i0;
+                    }
+                }
+            }
+        }
+        return numFree;
+    }
+
+    void heapUp(int p) {
+        pair<long long, int> entry = heap[p];
+        while(p > 0) {
+            int parent = (p - 1) / 2;
+            if(heap[parent].first <= entry.first) break;
+            heap[p] = heap[parent];
+            labels[heap[p].second].pos = p;
+            p = parent;
+        }
+        heap[p] = entry;
+        labels[entry.second].pos = p;
+    }
+
+    int heapPop() {
+        int top = heap[0].second;
+        pair<long long, int> entry = heap.back();
+        heap.pop_back();
+        int size = (int)heap.size();
+        if(size > 0) {
+            int p = 0;
+            while(true) {
+                int child = 2 * p + 1;
+                if(child >= size) break;
+                if(child + 1 < size && heap[child + 1].first < heap[child].first) child++;
+                if(heap[child].first >= entry.first) break;
+                heap[p] = heap[child];
+                labels[heap[p].second].pos = p;
+                p = child;
+            }
+            heap[p] = entry;
+            labels[entry.second].pos = p;
+        }
+        labels[top].pos = -1;
+        return top;
+    }
+
+    // Shortest augmenting path from freeRow over the candidate graph.
+    // False (nothing changed) if no free column can be reached.
+    bool augmentSparse(int n, int freeRow) {
+        if(++generation == 0) {
+            for(int j = 0; j < n; j++) labels[j].stamp = 0;
+            generation = 1;
+        }
+        scanned.clear();
+        heap.clear();
+
+        int i = freeRow;
+        long long h = 0;
+        int endOfPath = -1;
+        while(endOfPath < 0) {
+            const vector<Arc>& list = arcs[i];
+            for(size_t a = 0; a < list.size(); a++) {
+                int j = list[a].col;
+                Label& label = labels[j];
+                long long dj = list[a].cost - v[j] - h;
+                if(label.stamp != generation) {
+                    label.stamp = generation;
+                    label.dist = dj;
+                    label.pred = i;
+                    heap.push_back(make_pair(dj, j));
+                    heapUp((int)heap.size() - 1);
+                } else if(label.pos >= 0 && dj < label.dist) {
+                    label.dist = dj;
+                    label.pred = i;
+                    heap[label.pos].first = dj;
+                    heapUp(label.pos);
+                }
+            }
+
+            // Settle the closest column
+            if(heap.empty()) return false;
+            int j1 = heapPop();
+            if(colSol[j1] < 0) {
+                endOfPath = j1;
+                break;
+            }
+            scanned.push_back(j1);
+            i = colSol[j1];
+            h = cost[(size_t)i * n + j1] - v[j1] - labels[j1].dist;
+        }
+
+        long long minDist = labels[endOfPath].dist;
+        for(size_t k = 0; k < scanned.size(); k++) {
+            int j = scanned[k];
+            v[j] += labels[j].dist - minDist;
+        }
+
+        while(true) {
+            int row = labels[endOfPath].pred;
+            colSol[endOfPath] = row;
+            int j1 = endOfPath;
+            endOfPath = rowSol[row];
+            rowSol[row] = j1;
+            if(row == freeRow) break;
+        }
+        return true;
+    }
+
+    void solveSparse(int n, int rows, int cols) {
+        rowSol.assign(n, -1);
+        colSol.assign(n, -1);
+        freeRows.assign(n, 0);
+        labels.assign(n, Label{0, 0, -1, -1});
+        generation = 0;
+
+        buildCandidates(n, rows, cols);
+        int numFree = reduceSparse(n);
+        while(numFree > 0) {
+            for(int f = 0; f < numFree; f++) {
+                int freeRow = freeRows[f];
+                if(!augmentSparse(n, freeRow)) {
+                    // Cut off from every free column: connect it to the
+                    // cheapest ones (the price check sorts out the rest)
+                    const int* row = &cost[(size_t)freeRow * n];
+                    rowPicks.clear();
+                    for(int j = 0; j < n; j++) {
+                        if(colSol[j] < 0) rowPicks.push_back(make_pair(row[j], j));
+                    }
+                    keepCheapest(rowPicks, ASSIGN_CANDIDATES, 0, n);
+                    for(size_t e = 0; e < rowPicks.size(); e++) {
+                        arcs[freeRow].push_back(Arc{rowPicks[e].second, rowPicks[e].first});
+                    }
+                    augmentSparse(n, freeRow);
+                }
+            }
+
+            // Check the prices against the full matrix: a row whose column
+            // is not its cheapest one in reduced cost gets (up to
+            // ASSIGN_CANDIDATES of) the cheaper columns and is freed
+            numFree = 0;
+            for(int i = 0; i < n; i++) {
+                const int* row = &cost[(size_t)i * n];
+                int j0 = rowSol[i];
+                long long u = row[j0] - v[j0];
+                long long minReduced = u;
+                for(int j = 0; j < n; j++) {
+                    long long h = row[j] - v[j];
+                    if(h < minReduced) minReduced = h;
+                }
+                if(minReduced >= u) continue;
+                reducedPicks.clear();
+                for(int j = 0; j < n; j++) {
+                    if(row[j] - v[j] < u) reducedPicks.push_back(make_pair(row[j] - v[j], j));
+                }
+                if((int)reducedPicks.size() > ASSIGN_CANDIDATES) {
+                    nth_element(reducedPicks.begin(), reducedPicks.begin() + (ASSIGN_CANDIDATES - 1), reducedPicks.end());
+                    reducedPicks.resize(ASSIGN_CANDIDATES);
+                }
+                for(size_t e = 0; e < reducedPicks.size(); e++) {
+                    int j = reducedPicks[e].second;
+                    arcs[i].push_back(Arc{j, row[j]});
+                }
+                rowSol[i] = -1;
+                colSol[j0] = -1;
+                freeRows[numFree++] = i;
+            }
+        }
+    }
+
+public:
+    AssignmentEngine() {
+        generation = 0;
+    }
+
+    // costs.at(r, c) = cost of giving row r column c (INF = not allowed).
+    // Returns false on an empty matrix.
+    bool solve(const DistanceMatrix& costs, AssignmentResult& out) {
+        int rows = costs.rows;
+        int cols = costs.cols;
+        out = AssignmentResult();
+        out.rowToCol.assign(rows, -1);
+        out.colToRow.assign(cols, -1);
+        if(rows == 0 || cols == 0) return false;
+
+        int n = rows > cols ? rows : cols;
+        cost.assign((size_t)n * n, 0);     // Dummy rows/columns cost 0
+        for(int r = 0; r < rows; r++) {
+            int* row = &cost[(size_t)r * n];
+            for(int c = 0; c < cols; c++) {
+                int value = costs.at(r, c);
+                row[c] = (value == INF) ? ASSIGN_FORBIDDEN_COST : value;
+            }
+        }
+
+        // Every dummy row/column is connected to everything in the candidate
+        // graph, so only take the sparse path when there are few of them
+        int padding = n - (rows < cols ? rows : cols);
+        if(n >= ASSIGN_SPARSE_MIN_SIZE && padding * 16 <= n) {
+            solveSparse(n, rows, cols);
+        } else {
+            solveSquare(n);
+        }
+
+        for(int r = 0; r < rows; r++) {
+            int c = rowSol[r];
+            if(c >= cols || costs.at(r, c) == INF) continue;
+            out.rowToCol[r] = c;
+            out.colToRow[c] = r;
+            out.totalCost += costs.at(r, c);
+            out.assigned++;
+        }
+        return true;
+    }
+
+    // Match drivers (rows) to the vehicles named by vehicleIds (columns) by
+    // 'costs' and record each pairing. Only drivers that are available
+    // with no vehicle, and vehicles that are VEHICLE_AVAILABLE with no
+    // driver, take part: the other rows and columns are left out of the
+    // solve, so every pair it returns can be committed and a busy driver
+    // or vehicle never costs anyone the match they would otherwise get.
+    // The vehicle side goes through table.assignDriver/updateStatus so its
+    // indexes and observers see it; a pair whose driver the table refuses
+    // is dropped from 'out'. Returns the number of drivers assigned.
+    int assignDrivers(const vector<Driver*>& drivers, HashTable& table, const vector<string>& vehicleIds,
+                      const DistanceMatrix& costs, AssignmentResult& out) {
+        out = AssignmentResult();
+        out.rowToCol.assign(drivers.size(), -1);
+        out.colToRow.assign(vehicleIds.size(), -1);
+        if(costs.rows != (int)drivers.size() || costs.cols != (int)vehicleIds.size()) {
+            cout << "❌ Cost matrix is " << costs.rows << "x" << costs.cols << ", expected "
+                 << drivers.size() << "x" << vehicleIds.size() << endl;
+            return 0;
+        }
+
+        vector<int> freeRows;
+        for(size_t r = 0; r < drivers.size(); r++) {
+            if(drivers[r] != NULL && drivers[r]->isAvailable() && drivers[r]->assignedVehicleId.empty()) {
+                freeRows.push_back((int)r);
+            }
+        }
+        vector<int> freeCols;
+        for(size_t c = 0; c < vehicleIds.size(); c++) {
+            Vehicle* v = table.search(vehicleIds[c]);
+            if(v != NULL && v->status == VEHICLE_AVAILABLE && v->assignedDriverId == "") {
+                freeCols.push_back((int)c);
+            }
+        }
+        DistanceMatrix freeCosts;
+        freeCosts.resize((int)freeRows.size(), (int)freeCols.size());
+        for(size_t k = 0; k < freeRows.size(); k++) {
+            int* row = freeCosts.row((int)k);
+            for(size_t l = 0; l < freeCols.size(); l++) row[l] = costs.at(freeRows[k], freeCols[l]);
+        }
+        AssignmentResult freeOut;
+        if(!solve(freeCosts, freeOut)) return 0;
+
+        for(size_t k = 0; k < freeRows.size(); k++) {
+            if(freeOut.rowToCol[k] < 0) continue;
+            int r = freeRows[k];
+            int c = freeCols[freeOut.rowToCol[k]];
+            const string& vehicleId = vehicleIds[c];
+            if(!table.assignDriver(vehicleId, drivers[r]->driverId)) continue;
+            table.updateStatus(vehicleId, VEHICLE_IN_USE);
+            drivers[r]->status = DRIVER_ON_DUTY;
+            drivers[r]->assignedVehicleId = vehicleId;
+            out.rowToCol[r] = c;
+            out.colToRow[c] = r;
+            out.totalCost += costs.at(r, c);
+            out.assigned++;
+        }
+        return out.assigned;
+    }
+};
+
+#endif
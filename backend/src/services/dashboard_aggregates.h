@@ -0,0 +1,219 @@
+#ifndef DASHBOARD_AGGREGATES_H
+#define DASHBOARD_AGGREGATES_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "../core/vehicle.h"
+#include "../data_structures/hash_table.h"
+#include "../data_structures/auth_system.h"
+using namespace std;
+
+// Everything /api/stats/dashboard and /api/trips/stats report, as plain
+// counters. Derived values (available drivers, average distance) are kept
+// current too, so a reader only copies the struct.
+struct DashboardSnapshot {
+    uint64_t version;                   // Bumped by every applied change
+
+    long long vehicles;
+    long long vehiclesByStatus[VEHICLE_STATUS_COUNT];
+    long long vehiclesAssigned;         // Vehicles holding a driver
+
+    long long users;
+    long long usersActive;
+    long long usersPending;
+    long long usersInactive;
+
+    long long drivers;                  // EMPLOYEE accounts, any status
+    long long driversActive;
+    long long driversAssigned;          // Active drivers holding a vehicle
+    long long driversAvailable;         // Active drivers without a vehicle
+
+    long long tripsOngoing;
+    long long tripsCompleted;
+    double totalDistanceKm;             // Over completed trips
+    double averageDistanceKm;
+};
+
+// Materialized dashboard counters.
+// The JS handlers recount users and vehicles and run SUM/AVG over the trips
+// table on every dashboard request. Here the counters follow the fleet
+// structures instead: attach() subscribes to the HashTable and AuthSystem
+// observers (which replay what is already stored), and trips are reported
+// with tripStarted()/tripCompleted(). Each change is a few additions under
+// a mutex, and snapshot() is a copy of one small struct under the same
+// mutex - O(1) no matter how large the fleet is.
+//
+// Drivers are counted like app.js does: an ACTIVE EMPLOYEE account is
+// assigned if some vehicle's assignedDriverId is its userId, otherwise
+// available. Both sides are tracked per driver ID, so a vehicle held by an
+// unknown or inactive account does not count as an assigned driver.
+class DashboardAggregates {
+private:
+    struct DriverState {
+        bool employee;          // An EMPLOYEE account with this userId exists
+        bool active;
+        int vehicles;           // Vehicles naming this ID as their driver
+    };
+
+    mutable mutex lock;
+    DashboardSnapshot current;
+    unordered_map<string, DriverState> driverStates;
+
+    static long long* userStatusCounter(DashboardSnapshot& s, string_view status) {
+        if(status == "ACTIVE") return &s.usersActive;
+        if(status == "PENDING") return &s.usersPending;
+        if(status == "INACTIVE") return &s.usersInactive;
+        return NULL;
+    }
+
+    // +1 / -1 for the assigned or available counter; caller holds the lock
+    void countDriver(const DriverState& d, int sign) {
+        if(!d.employee || !d.active) return;
+        if(d.vehicles > 0) current.driversAssigned += sign;
+        else current.driversAvailable += sign;
+    }
+
+    // Apply 'change' to one driver's state and move it between counters
+    template <typename F>
+    void updateDriver(const string& driverId, F change) {
+        DriverState& d = driverStates.emplace(driverId, DriverState{false, false, 0}).first->second;
+        countDriver(d, -1);
+        change(d);
+        countDriver(d, +1);
+        if(!d.employee && d.vehicles == 0) driverStates.erase(driverId);
+    }
+
+    // Caller holds the lock
+    void refreshDerived() {
+        current.averageDistanceKm = current.tripsCompleted > 0 ? current.totalDistanceKm / current.tripsCompleted : 0.0;
+        current.version++;
+    }
+
+    void applyVehicle(const VehicleEvent& e) {
+        lock_guard<mutex> guard(lock);
+        const string& driverId = e.vehicle->assignedDriverId;
+        bool hasDriver = driverId != "";
+        switch(e.change) {
+            case VEHICLE_ADDED:
+                current.vehicles++;
+                current.vehiclesByStatus[e.vehicle->status]++;
+                if(hasDriver) {
+                    current.vehiclesAssigned++;
+                    updateDriver(driverId, [](DriverState& d) { d.vehicles++; });
+                }
+                break;
+            case VEHICLE_REMOVED:
+                current.vehicles--;
+                current.vehiclesByStatus[e.vehicle->status]--;
+                if(hasDriver) {
+                    current.vehiclesAssigned--;
+                    updateDriver(driverId, [](DriverState& d) { d.vehicles--; });
+                }
+                break;
+            case VEHICLE_STATUS_CHANGED:
+                current.vehiclesByStatus[e.previousStatus]--;
+                current.vehiclesByStatus[e.vehicle->status]++;
+                break;
+            case VEHICLE_DRIVER_CHANGED:
+                if(!e.previousDriverId.empty()) {
+                    current.vehiclesAssigned--;
+                    updateDriver(string(e.previousDriverId), [](DriverState& d) { d.vehicles--; });
+                }
+                if(hasDriver) {
+                    current.vehiclesAssigned++;
+                    updateDriver(driverId, [](DriverState& d) { d.vehicles++; });
+                }
+                break;
+        }
+        refreshDerived();
+    }
+
+    void applyUser(const UserEvent& e) {
+        lock_guard<mutex> guard(lock);
+        bool isDriver = e.user->role == "EMPLOYEE";
+        if(e.change == USER_ADDED) {
+            current.users++;
+            if(isDriver) current.drivers++;
+        } else {
+            long long* before = userStatusCounter(current, e.previousStatus);
+            if(before != NULL) (*before)--;
+            if(isDriver && e.previousStatus == "ACTIVE") current.driversActive--;
+        }
+        long long* after = userStatusCounter(current, e.user->status);
+        if(after != NULL) (*after)++;
+        if(isDriver) {
+            bool active = e.user->status == "ACTIVE";
+            if(active) current.driversActive++;
+            updateDriver(e.user->userId, [active](DriverState& d) {
+                d.employee = true;
+                d.active = active;
+            });
+        }
+        refreshDerived();
+    }
+
+public:
+    DashboardAggregates() {
+        current = DashboardSnapshot();
+    }
+
+    DashboardAggregates(const DashboardAggregates&) = delete;
+    DashboardAggregates& operator=(const DashboardAggregates&) = delete;
+
+    // Follow a vehicle table; its current vehicles are counted right away.
+    // Status and driver changes must go through the table's calls, and the
+    // aggregates must outlive the table (observers cannot be removed).
+    void attach(HashTable& table) {
+        table.addObserver([this](const VehicleEvent& e) { applyVehicle(e); });
+    }
+
+    // Follow user accounts; drivers are the EMPLOYEE accounts
+    void attach(AuthSystem& auth) {
+        auth.addObserver([this](const UserEvent& e) { applyUser(e); });
+    }
+
+    void tripStarted() {
+        lock_guard<mutex> guard(lock);
+        current.tripsOngoing++;
+        refreshDerived();
+    }
+
+    // For a trip previously reported with tripStarted()
+    void tripCompleted(double distanceKm) {
+        lock_guard<mutex> guard(lock);
+        current.tripsOngoing--;
+        current.tripsCompleted++;
+        current.totalDistanceKm += distanceKm;
+        refreshDerived();
+    }
+
+    // O(1): the counters are already up to date
+    DashboardSnapshot snapshot() const {
+        lock_guard<mutex> guard(lock);
+        return current;
+    }
+
+    void displayStats() const {
+        DashboardSnapshot s = snapshot();
+        cout << "\n=== Dashboard Statistics ===" << endl;
+        cout << "Vehicles: " << s.vehicles << " (";
+        for(int st = 0; st < VEHICLE_STATUS_COUNT; st++) {
+            cout << (st > 0 ? ", " : "") << vehicleStatusName((VehicleStatus)st) << ": " << s.vehiclesByStatus[st];
+        }
+        cout << "), with a driver: " << s.vehiclesAssigned << endl;
+        cout << "Users: " << s.users << " (active: " << s.usersActive << ", pending: " << s.usersPending
+             << ", inactive: " << s.usersInactive << ")" << endl;
+        cout << "Drivers: " << s.drivers << " (active: " << s.driversActive << ", assigned: " << s.driversAssigned
+             << ", available: " << s.driversAvailable << ")" << endl;
+        cout << "Trips: " << s.tripsOngoing << " ongoing, " << s.tripsCompleted << " completed, "
+             << s.totalDistanceKm << " km (avg " << s.averageDistanceKm << " km)" << endl;
+        cout << "Version: " << s.version << endl;
+        cout << "============================\n" << endl;
+    }
+};
+
+#endif
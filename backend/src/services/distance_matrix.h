@@ -0,0 +1,207 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "../data_structures/csr_graph.h"
+#include "../data_structures/contraction_hierarchy.h"
+#include "../data_structures/thread_pool.h"
+using namespace std;
+
+// Dense sources x targets table of road distances (INF = unreachable)
+struct DistanceMatrix {
+    int rows;
+    int cols;
+    vector<int> values;     // Row-major
+
+    DistanceMatrix() {
+        rows = 0;
+        cols = 0;
+    }
+
+    void resize(int r, int c) {
+        rows = r;
+        cols = c;
+        values.assign((size_t)r * c, INF);
+    }
+
+    int at(int r, int c) const {
+        return values[(size_t)r * cols + c];
+    }
+
+    int* row(int r) {
+        return &values[(size_t)r * cols];
+    }
+};
+
+// Many-to-many distance engine for dispatch ("which of N vehicles is
+// closest to each of M pickups").
+//
+// compute() runs one one-to-many Dijkstra per source that stops once every
+// target is settled. computeWithHierarchy() uses the bucket algorithm over a
+// ContractionHierarchy: one backward upward search per target leaves
+// (target, distance) entries in buckets at the vertices it reaches, then one
+// forward upward search per source scans the buckets it meets. Both spread
+// the per-source searches over a ThreadPool with one workspace per worker.
+class DistanceMatrixEngine {
+private:
+    struct HeapItem {
+        int key;
+        int node;
+        bool operator>(const HeapItem& other) const {
+            return key > other.key;
+        }
+    };
+
+    // Upward search workspace for the bucket algorithm
+    struct UpwardSearch {
+        vector<int> dist;
+        vector<uint32_t> stamp;
+        uint32_t generation;
+        vector<HeapItem> heap;
+        vector<int> settled;
+
+        UpwardSearch() {
+            generation = 0;
+        }
+
+        // Exhaustive Dijkstra over upward arcs; fills 'settled'
+        void run(const ContractionHierarchy& ch, int source) {
+            int n = ch.getNumVertices();
+            if((int)stamp.size() != n) {
+                dist.assign(n, INF);
+                stamp.assign(n, 0);
+                generation = 0;
+            }
+            if(++generation == 0) {
+                fill(stamp.begin(), stamp.end(), 0);
+                generation = 1;
+            }
+            heap.clear();
+            settled.clear();
+            if(source < 0 || source >= n) return;
+
+            stamp[source] = generation;
+            dist[source] = 0;
+            heap.push_back(HeapItem{0, source});
+            while(!heap.empty()) {
+                pop_heap(heap.begin(), heap.end(), greater<HeapItem>());
+                HeapItem top = heap.back();
+                heap.pop_back();
+                if(top.key > dist[top.node]) continue;
+                settled.push_back(top.node);
+
+                for(int a = ch.upwardBegin(top.node); a < ch.upwardEnd(top.node); a++) {
+                    int v = ch.upwardTarget(a);
+                    int nd = top.key + ch.upwardWeight(a);
+                    if(stamp[v] != generation || nd < dist[v]) {
+                        stamp[v] = generation;
+                        dist[v] = nd;
+                        heap.push_back(HeapItem{nd, v});
+                        push_heap(heap.begin(), heap.end(), greater<HeapItem>());
+                    }
+                }
+            }
+        }
+    };
+
+    struct BucketEntry {
+        int vertex;
+        int target;     // Column index
+        int dist;
+    };
+
+    ThreadPool& pool;
+    vector<DijkstraSearch> dijkstraWorkspaces;
+    vector<UpwardSearch> upwardWorkspaces;
+    vector<vector<BucketEntry> > workerBuckets;
+
+public:
+    DistanceMatrixEngine(ThreadPool& threadPool) : pool(threadPool) {
+    }
+
+    DistanceMatrixEngine(const DistanceMatrixEngine&) = delete;
+    DistanceMatrixEngine& operator=(const DistanceMatrixEngine&) = delete;
+
+    // One bounded Dijkstra per source, in parallel
+    void compute(const CSRGraph& graph, const vector<int>& sources, const vector<int>& targets,
+                 DistanceMatrix& out) {
+        out.resize((int)sources.size(), (int)targets.size());
+        if(targets.empty()) return;
+
+        if((int)dijkstraWorkspaces.size() != pool.getNumThreads()) {
+            dijkstraWorkspaces.clear();
+            for(int w = 0; w < pool.getNumThreads(); w++) {
+                dijkstraWorkspaces.push_back(DijkstraSearch(graph));
+            }
+        }
+        for(size_t w = 0; w < dijkstraWorkspaces.size(); w++) {
+            dijkstraWorkspaces[w].setGraph(graph);
+        }
+
+        pool.parallelFor((int)sources.size(), [&](int i, int worker) {
+            dijkstraWorkspaces[worker].distancesTo(sources[i], targets, out.row(i));
+        });
+    }
+
+    // Bucket-based many-to-many over a contraction hierarchy
+    void computeWithHierarchy(const ContractionHierarchy& ch, const vector<int>& sources,
+                              const vector<int>& targets, DistanceMatrix& out) {
+        out.resize((int)sources.size(), (int)targets.size());
+        if(targets.empty() || sources.empty()) return;
+
+        int workers = pool.getNumThreads();
+        upwardWorkspaces.resize(workers);
+        workerBuckets.assign(workers, vector<BucketEntry>());
+
+        // Phase 1: backward searches from every target fill the buckets
+        pool.parallelFor((int)targets.size(), [&](int j, int worker) {
+            UpwardSearch& s = upwardWorkspaces[worker];
+            s.run(ch, targets[j]);
+            for(size_t k = 0; k < s.settled.size(); k++) {
+                int v = s.settled[k];
+                workerBuckets[worker].push_back(BucketEntry{v, j, s.dist[v]});
+            }
+        });
+
+        // Group bucket entries by vertex (counting sort into CSR form)
+        int n = ch.getNumVertices();
+        vector<int> bucketOffsets(n + 1, 0);
+        for(int w = 0; w < workers; w++) {
+            for(size_t k = 0; k < workerBuckets[w].size(); k++) {
+                bucketOffsets[workerBuckets[w][k].vertex + 1]++;
+            }
+        }
+        for(int v = 0; v < n; v++) {
+            bucketOffsets[v + 1] += bucketOffsets[v];
+        }
+        vector<BucketEntry> buckets(bucketOffsets[n]);
+        vector<int> cursor(bucketOffsets.begin(), bucketOffsets.end() - 1);
+        for(int w = 0; w < workers; w++) {
+            for(size_t k = 0; k < workerBuckets[w].size(); k++) {
+                const BucketEntry& e = workerBuckets[w][k];
+                buckets[cursor[e.vertex]++] = e;
+            }
+            vector<BucketEntry>().swap(workerBuckets[w]);
+        }
+
+        // Phase 2: forward search per source scans buckets on its way up
+        pool.parallelFor((int)sources.size(), [&](int i, int worker) {
+            UpwardSearch& s = upwardWorkspaces[worker];
+            s.run(ch, sources[i]);
+            int* row = out.row(i);
+            for(size_t k = 0; k < s.settled.size(); k++) {
+                int v = s.settled[k];
+                int dv = s.dist[v];
+                for(int b = bucketOffsets[v]; b < bucketOffsets[v + 1]; b++) {
+                    int d = dv + buckets[b].dist;
+                    if(d < row[buckets[b].target]) row[buckets[b].target] = d;
+                }
+            }
+        });
+    }
+};
+
+#endif
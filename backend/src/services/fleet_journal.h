@@ -0,0 +1,553 @@
+#ifndef FLEET_JOURNAL_H
+#define FLEET_JOURNAL_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include "../core/vehicle.h"
+#include "../data_structures/hash_table.h"
+#include "../data_structures/write_ahead_log.h"
+#include "../data_structures/crc32.h"
+#include "../data_structures/durable_file.h"
+using namespace std;
+
+// WAL record types
+#define JOURNAL_INSERT 1
+#define JOURNAL_DELETE 2
+#define JOURNAL_STATUS 3
+#define JOURNAL_ODOMETER 4
+#define JOURNAL_ASSIGN 5
+
+#define SNAPSHOT_MAGIC 0x31504E53544C4646ULL    // "FFLTSNP1"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER 32                      // magic, version, reserved, lsn, count
+#define SNAPSHOT_MIN_RECORD 26                  // Four empty strings + type, status, year, days, km
+#define JOURNAL_DEFAULT_CHECKPOINT 100000       // WAL records between snapshots
+
+// Outcome of a journaled mutation
+enum JournalResult {
+    JOURNAL_OK,             // Applied and durable
+    JOURNAL_REJECTED,       // Invalid (unknown vehicle, duplicate ID, busy driver); nothing changed
+    JOURNAL_LOG_FAILED,     // The log refused the record; nothing changed
+    JOURNAL_NOT_DURABLE     // Logged and applied, but the sync failed
+};
+
+// Flat little-endian encoding of WAL payloads and snapshot records.
+// Strings carry a uint16 length; a longer one cannot be encoded, so it
+// marks the record as not fitting and callers must not write it out.
+class JournalWriter {
+public:
+    string bytes;
+    bool fits = true;
+
+    template <typename T>
+    void put(T value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(string_view s) {
+        if(s.size() > UINT16_MAX) {
+            fits = false;
+            return;
+        }
+        put<uint16_t>((uint16_t)s.size());
+        bytes.append(s.data(), s.size());
+    }
+
+    void putVehicle(const Vehicle& v) {
+        putString(v.vehicleId);
+        putString(v.registrationNumber);
+        putString(v.model);
+        putString(v.assignedDriverId);
+        put<uint8_t>(v.type);
+        put<uint8_t>(v.status);
+        put<int32_t>(v.year);
+        put<int32_t>(v.daysSinceLastService);
+        put<double>(v.kilometersRun);
+    }
+};
+
+class JournalReader {
+private:
+    const char* data;
+    size_t length;
+    size_t offset;
+    bool ok;
+
+public:
+    JournalReader(const char* d, size_t n) {
+        data = d;
+        length = n;
+        offset = 0;
+        ok = true;
+    }
+
+    template <typename T>
+    T get() {
+        T value = T();
+        if(offset + sizeof(T) > length) {
+            ok = false;
+            return value;
+        }
+        memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    string getString() {
+        uint16_t n = get<uint16_t>();
+        if(!ok || offset + n > length) {
+            ok = false;
+            return "";
+        }
+        string s(data + offset, n);
+        offset += n;
+        return s;
+    }
+
+    bool getVehicle(Vehicle& v) {
+        v.vehicleId = getString();
+        v.registrationNumber = getString();
+        v.model = getString();
+        v.assignedDriverId = getString();
+        uint8_t type = get<uint8_t>();
+        uint8_t status = get<uint8_t>();
+        v.year = get<int32_t>();
+        v.daysSinceLastService = get<int32_t>();
+        v.kilometersRun = get<double>();
+        if(type >= VEHICLE_TYPE_COUNT || status >= VEHICLE_STATUS_COUNT) ok = false;
+        v.type = (VehicleType)type;
+        v.status = (VehicleStatus)status;
+        return ok;
+    }
+
+    bool good() const {
+        return ok;
+    }
+
+    bool atEnd() const {
+        return offset == length;
+    }
+};
+
+// Durable front end for a HashTable of vehicles.
+// Every mutation is validated, appended to a write-ahead log and only then
+// applied to the table, all under one writer lock; the caller then waits
+// for the log to reach disk outside the lock, so concurrent writers are
+// group-committed into a single fdatasync. A call returns JOURNAL_OK only
+// once its record is durable. A rejected or unlogged mutation leaves the
+// table untouched, so the table never holds a change the log does not.
+// Every JOURNAL_DEFAULT_CHECKPOINT records (configurable) the table is
+// written to a compact checksummed snapshot - temp file, fsync, rename -
+// and the log is truncated. recover() loads the snapshot and replays the
+// log tail after its LSN; a torn last record is detected by its CRC and
+// dropped. A crash between snapshot and truncation is harmless: records
+// the snapshot already covers are skipped by LSN.
+//
+// Writers are serialized here; readers of the table must not race with
+// them. MinHeap and FleetStore views are rebuilt from the recovered table;
+// the BTree index already persists itself.
+class FleetJournal {
+private:
+    HashTable& table;
+    string walPath;
+    string snapshotPath;
+    WriteAheadLog wal;
+    mutex writeLock;
+    atomic<uint64_t> snapshotLsn;   // LSN covered by the current snapshot
+    uint64_t checkpointInterval;
+    bool verbose;
+
+    // Recovery statistics
+    size_t snapshotVehicles;
+    size_t replayedRecords;
+    size_t tornBytes;
+    double recoveryMs;
+    int checkpoints;
+
+    // Apply one logged mutation to the table (replay path)
+    bool apply(uint8_t type, const char* payload, uint32_t length) {
+        JournalReader in(payload, length);
+        if(type == JOURNAL_INSERT) {
+            Vehicle* v = new Vehicle();
+            if(!in.getVehicle(*v) || !table.insert(v)) {
+                delete v;
+                return false;
+            }
+            return true;
+        }
+        string vehicleId = in.getString();
+        if(type == JOURNAL_DELETE) {
+            return in.good() && table.deleteVehicle(vehicleId);
+        }
+        if(type == JOURNAL_STATUS) {
+            uint8_t status = in.get<uint8_t>();
+            return in.good() && status < VEHICLE_STATUS_COUNT && table.updateStatus(vehicleId, (VehicleStatus)status);
+        }
+        if(type == JOURNAL_ODOMETER) {
+            double km = in.get<double>();
+            int32_t days = in.get<int32_t>();
+            Vehicle* v = table.search(vehicleId);
+            if(!in.good() || v == NULL) return false;
+            v->kilometersRun = km;
+            v->daysSinceLastService = days;
+            return true;
+        }
+        if(type == JOURNAL_ASSIGN) {
+            string driverId = in.getString();
+            return in.good() && table.assignDriver(vehicleId, driverId);
+        }
+        return false;
+    }
+
+    // Checked before logging: a string field over UINT16_MAX bytes would
+    // desync the record and make the whole log unreplayable
+    bool encodable(const JournalWriter& record) const {
+        if(!record.fits && table.isVerbose()) cout << "❌ Field too long to journal!" << endl;
+        return record.fits;
+    }
+
+    // Append a validated mutation before it is applied; caller holds
+    // writeLock. 0 if the log refused it.
+    uint64_t log(uint8_t type, const JournalWriter& record) {
+        uint64_t lsn = wal.append(type, record.bytes.data(), (uint32_t)record.bytes.size());
+        if(lsn == 0) cout << "❌ WAL append failed: " << walPath << endl;
+        return lsn;
+    }
+
+    // The log has grown enough past the snapshot. Another writer may have
+    // checkpointed past 'lsn' already, so no subtraction here.
+    bool checkpointDue(uint64_t lsn) const {
+        return checkpointInterval > 0 && lsn >= snapshotLsn.load() + checkpointInterval;
+    }
+
+    // Wait for durability, then checkpoint if the log has grown enough.
+    // Many writers can see the same checkpoint due; the first one to get
+    // writeLock takes it and the rest find it no longer due.
+    JournalResult commit(uint64_t lsn) {
+        if(!wal.waitDurable(lsn)) return JOURNAL_NOT_DURABLE;
+        if(checkpointDue(lsn)) {
+            lock_guard<mutex> guard(writeLock);
+            if(checkpointDue(lsn)) writeCheckpoint();
+        }
+        return JOURNAL_OK;
+    }
+
+    // Checks made before logging, so every logged record replays cleanly.
+    // Caller holds writeLock.
+    Vehicle* findVehicle(const string& vehicleId) const {
+        Vehicle* v = table.search(vehicleId);
+        if(v == NULL && table.isVerbose()) cout << "❌ Vehicle not found!" << endl;
+        return v;
+    }
+
+    bool driverBusy(const string& driverId, const Vehicle* except) const {
+        if(driverId == "") return false;
+        Vehicle* holder = table.findByDriver(driverId);
+        if(holder == NULL || holder == except) return false;
+        if(table.isVerbose()) cout << "❌ Driver " << driverId << " already has a vehicle!" << endl;
+        return true;
+    }
+
+    // Load the snapshot into the (empty) table; a missing file is an empty fleet
+    bool loadSnapshot() {
+        FILE* file = fopen(snapshotPath.c_str(), "rb");
+        snapshotLsn = 0;
+        snapshotVehicles = 0;
+        if(file == NULL) return true;
+
+        string contents;
+        char buffer[65536];
+        size_t got;
+        while((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            contents.append(buffer, got);
+        }
+        fclose(file);
+
+        if(contents.size() < SNAPSHOT_HEADER + 4) {
+            cout << "❌ Snapshot too short: " << snapshotPath << endl;
+            return false;
+        }
+        uint32_t storedCrc;
+        memcpy(&storedCrc, contents.data() + contents.size() - 4, 4);
+        if(crc32(contents.data(), contents.size() - 4) != storedCrc) {
+            cout << "❌ Snapshot checksum mismatch: " << snapshotPath << endl;
+            return false;
+        }
+
+        JournalReader in(contents.data(), contents.size() - 4);
+        uint64_t magic = in.get<uint64_t>();
+        uint32_t version = in.get<uint32_t>();
+        in.get<uint32_t>();
+        uint64_t lsn = in.get<uint64_t>();
+        uint64_t count = in.get<uint64_t>();
+        if(magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+            cout << "❌ Not a fleet snapshot: " << snapshotPath << endl;
+            return false;
+        }
+        // Bound the count by what the file can hold before reserving for it
+        if(count > (contents.size() - 4 - SNAPSHOT_HEADER) / SNAPSHOT_MIN_RECORD) {
+            cout << "❌ Snapshot claims " << count << " vehicles, more than the file holds" << endl;
+            return false;
+        }
+
+        table.reserve((size_t)count);
+        for(uint64_t i = 0; i < count; i++) {
+            Vehicle* v = new Vehicle();
+            if(!in.getVehicle(*v) || !table.insert(v)) {
+                delete v;
+                cout << "❌ Bad snapshot record " << i << endl;
+                return false;
+            }
+        }
+        if(!in.atEnd()) {
+            cout << "❌ Trailing bytes in snapshot" << endl;
+            return false;
+        }
+        snapshotLsn = lsn;
+        snapshotVehicles = (size_t)count;
+        return true;
+    }
+
+    // Write a snapshot of the whole table and empty the log; caller holds
+    // writeLock
+    bool writeCheckpoint() {
+        if(!wal.sync()) return false;
+        uint64_t lsn = wal.getLastLsn();
+
+        JournalWriter out;
+        out.put<uint64_t>(SNAPSHOT_MAGIC);
+        out.put<uint32_t>(SNAPSHOT_VERSION);
+        out.put<uint32_t>(0);
+        out.put<uint64_t>(lsn);
+        out.put<uint64_t>((uint64_t)table.getTotalVehicles());
+        table.forEachVehicle([&](const Vehicle& v) { out.putVehicle(v); });
+        if(!out.fits) {
+            cout << "❌ Snapshot skipped: a vehicle has a field too long to encode" << endl;
+            return false;
+        }
+        out.put<uint32_t>(crc32(out.bytes.data(), out.bytes.size()));
+
+        string tempPath = snapshotPath + ".tmp";
+        if(!writeFileDurably(tempPath, out.bytes) || rename(tempPath.c_str(), snapshotPath.c_str()) != 0) {
+            cout << "❌ Snapshot write failed: " << snapshotPath << endl;
+            return false;
+        }
+        syncDirectory(snapshotPath);
+        snapshotLsn = lsn;
+        checkpoints++;
+
+        if(!wal.truncate()) {
+            cout << "❌ WAL truncate failed: " << walPath << endl;
+            return false;
+        }
+        if(verbose) {
+            cout << "✅ Checkpoint at LSN " << lsn << ": " << table.getTotalVehicles() << " vehicles, "
+                 << out.bytes.size() / 1024 << " KB snapshot" << endl;
+        }
+        return true;
+    }
+
+public:
+    // Files are <pathPrefix>.wal and <pathPrefix>.snap
+    FleetJournal(HashTable& vehicles, const string& pathPrefix) : table(vehicles) {
+        walPath = pathPrefix + ".wal";
+        snapshotPath = pathPrefix + ".snap";
+        snapshotLsn = 0;
+        checkpointInterval = JOURNAL_DEFAULT_CHECKPOINT;
+        verbose = true;
+        snapshotVehicles = 0;
+        replayedRecords = 0;
+        tornBytes = 0;
+        recoveryMs = 0;
+        checkpoints = 0;
+    }
+
+    FleetJournal(const FleetJournal&) = delete;
+    FleetJournal& operator=(const FleetJournal&) = delete;
+
+    void setVerbose(bool v) {
+        verbose = v;
+    }
+
+    // 0 turns automatic checkpoints off
+    void setCheckpointInterval(uint64_t records) {
+        checkpointInterval = records;
+    }
+
+    // Rebuild the table from snapshot + WAL tail and open the log for
+    // writing. The table must be empty.
+    bool recover() {
+        lock_guard<mutex> guard(writeLock);
+        if(table.getTotalVehicles() != 0) {
+            cout << "❌ Recovery needs an empty vehicle table" << endl;
+            return false;
+        }
+
+        auto start = chrono::steady_clock::now();
+        bool tableVerbose = table.isVerbose();
+        table.setVerbose(false);
+        replayedRecords = 0;
+        tornBytes = 0;
+
+        bool ok = loadSnapshot() && wal.open(walPath, snapshotLsn,
+            [&](uint64_t lsn, uint8_t type, const char* payload, uint32_t length) {
+                if(!apply(type, payload, length)) {
+                    cout << "❌ WAL record " << lsn << " does not apply" << endl;
+                    return false;
+                }
+                replayedRecords++;
+                return true;
+            }, &tornBytes);
+
+        table.setVerbose(tableVerbose);
+        recoveryMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if(verbose && ok) {
+            cout << "✅ Recovered " << table.getTotalVehicles() << " vehicles (snapshot: " << snapshotVehicles
+                 << ", WAL records: " << replayedRecords << ", torn bytes dropped: " << tornBytes << ")" << endl;
+        }
+        return ok;
+    }
+
+    // The table takes ownership of v unless the result is JOURNAL_REJECTED
+    // or JOURNAL_LOG_FAILED, in which case the caller still owns it.
+    JournalResult insert(Vehicle* v) {
+        if(v == NULL) return JOURNAL_REJECTED;
+        JournalWriter record;
+        record.putVehicle(*v);
+        if(!encodable(record)) return JOURNAL_REJECTED;
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(writeLock);
+            if(table.search(v->vehicleId) != NULL) {
+                if(table.isVerbose()) cout << "❌ Vehicle ID already exists!" << endl;
+                return JOURNAL_REJECTED;
+            }
+            if(driverBusy(v->assignedDriverId, NULL)) return JOURNAL_REJECTED;
+            lsn = log(JOURNAL_INSERT, record);
+            if(lsn == 0) return JOURNAL_LOG_FAILED;
+            table.insert(v);
+        }
+        return commit(lsn);
+    }
+
+    JournalResult deleteVehicle(const string& vehicleId) {
+        JournalWriter record;
+        record.putString(vehicleId);
+        if(!encodable(record)) return JOURNAL_REJECTED;
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(writeLock);
+            if(findVehicle(vehicleId) == NULL) return JOURNAL_REJECTED;
+            lsn = log(JOURNAL_DELETE, record);
+            if(lsn == 0) return JOURNAL_LOG_FAILED;
+            table.deleteVehicle(vehicleId);
+        }
+        return commit(lsn);
+    }
+
+    JournalResult updateStatus(const string& vehicleId, VehicleStatus status) {
+        if(status >= VEHICLE_STATUS_COUNT) return JOURNAL_REJECTED;
+        JournalWriter record;
+        record.putString(vehicleId);
+        record.put<uint8_t>(status);
+        if(!encodable(record)) return JOURNAL_REJECTED;
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(writeLock);
+            if(findVehicle(vehicleId) == NULL) return JOURNAL_REJECTED;
+            lsn = log(JOURNAL_STATUS, record);
+            if(lsn == 0) return JOURNAL_LOG_FAILED;
+            table.updateStatus(vehicleId, status);
+        }
+        return commit(lsn);
+    }
+
+    JournalResult updateOdometer(const string& vehicleId, double km, int daysSinceService) {
+        JournalWriter record;
+        record.putString(vehicleId);
+        record.put<double>(km);
+        record.put<int32_t>(daysSinceService);
+        if(!encodable(record)) return JOURNAL_REJECTED;
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(writeLock);
+            Vehicle* v = findVehicle(vehicleId);
+            if(v == NULL) return JOURNAL_REJECTED;
+            lsn = log(JOURNAL_ODOMETER, record);
+            if(lsn == 0) return JOURNAL_LOG_FAILED;
+            v->kilometersRun = km;
+            v->daysSinceLastService = daysSinceService;
+        }
+        return commit(lsn);
+    }
+
+    JournalResult assignDriver(const string& vehicleId, const string& driverId) {
+        JournalWriter record;
+        record.putString(vehicleId);
+        record.putString(driverId);
+        if(!encodable(record)) return JOURNAL_REJECTED;
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(writeLock);
+            Vehicle* v = findVehicle(vehicleId);
+            if(v == NULL || driverBusy(driverId, v)) return JOURNAL_REJECTED;
+            lsn = log(JOURNAL_ASSIGN, record);
+            if(lsn == 0) return JOURNAL_LOG_FAILED;
+            table.assignDriver(vehicleId, driverId);
+        }
+        return commit(lsn);
+    }
+
+    // Write a snapshot of the whole table and empty the log
+    bool checkpoint() {
+        lock_guard<mutex> guard(writeLock);
+        return writeCheckpoint();
+    }
+
+    uint64_t getLastLsn() const {
+        return wal.getLastLsn();
+    }
+
+    uint64_t getSnapshotLsn() const {
+        return snapshotLsn.load();
+    }
+
+    size_t getReplayedRecords() const {
+        return replayedRecords;
+    }
+
+    size_t getTornBytes() const {
+        return tornBytes;
+    }
+
+    const string& getWalPath() const {
+        return walPath;
+    }
+
+    const string& getSnapshotPath() const {
+        return snapshotPath;
+    }
+
+    void displayStats() const {
+        long long syncs = wal.getSyncs();
+        cout << "\n=== Journal Statistics ===" << endl;
+        cout << "Last LSN: " << wal.getLastLsn() << " (durable: " << wal.getDurableLsn() << ")" << endl;
+        cout << "Snapshot LSN: " << snapshotLsn.load() << ", checkpoints: " << checkpoints << endl;
+        cout << "WAL size: " << wal.getFileBytes() << " bytes" << endl;
+        cout << "Group commits: " << syncs << " syncs for " << wal.getRecordsSynced() << " records";
+        if(syncs > 0) cout << " (" << (double)wal.getRecordsSynced() / syncs << " per sync)";
+        cout << endl;
+        cout << "Last recovery: " << snapshotVehicles << " from snapshot + " << replayedRecords
+             << " WAL records in " << recoveryMs << " ms" << endl;
+        cout << "==========================\n" << endl;
+    }
+};
+
+#endif
@@ -0,0 +1,578 @@
+#ifndef FLEET_QUERY_H
+#define FLEET_QUERY_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+#include "../data_structures/fleet_store.h"
+#include "../data_structures/roaring_bitmap.h"
+using namespace std;
+
+#define QUERY_MAX_DEPTH 64         // Nested NOT / parentheses
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+enum QueryField {
+    QUERY_YEAR,
+    QUERY_KM,
+    QUERY_DAYS,         // Days since last service
+    QUERY_STATUS,
+    QUERY_TYPE
+};
+
+enum QueryOp {
+    QUERY_LT,
+    QUERY_LE,
+    QUERY_GT,
+    QUERY_GE,
+    QUERY_EQ,
+    QUERY_NE
+};
+
+enum QueryNodeKind {
+    QUERY_COMPARE,
+    QUERY_AND,
+    QUERY_OR,
+    QUERY_NOT
+};
+
+struct QueryNode {
+    QueryNodeKind kind;
+    QueryField field;       // QUERY_COMPARE only
+    QueryOp op;
+    double value;           // Number, or the status/type code
+    vector<int> children;   // Node indexes
+};
+
+// Ad-hoc fleet filter, parsed from text such as
+//   year < 2019 AND type = Truck AND km > 20000 AND NOT MAINTENANCE
+// Fields: year, km, days (since service), status, type. Operators:
+// < <= > >= = != (status and type take = and != only). AND binds tighter
+// than OR; NOT and parentheses work as usual. A bare status name
+// (AVAILABLE, IN_USE, MAINTENANCE, RETIRED) means "status = name" and a
+// bare type name (Truck, Van, Car, SUV, Other) means "type = name".
+// Keywords and names are case-insensitive. Nesting is capped at
+// QUERY_MAX_DEPTH so the recursive parser stays within the stack.
+class FleetQuery {
+private:
+    vector<QueryNode> nodes;
+    int root;
+    string error;
+
+    // ---------- tokenizer ----------
+    vector<string> tokens;
+    size_t position;
+    int depth;                  // NOT / parenthesis nesting at 'position'
+
+    static string upper(string_view s) {
+        string result(s);
+        for(size_t i = 0; i < result.size(); i++) {
+            result[i] = (char)toupper((unsigned char)result[i]);
+        }
+        return result;
+    }
+
+    bool tokenize(string_view text) {
+        tokens.clear();
+        size_t i = 0;
+        while(i < text.size()) {
+            char c = text[i];
+            if(isspace((unsigned char)c)) {
+                i++;
+            } else if(c == '(' || c == ')') {
+                tokens.push_back(string(1, c));
+                i++;
+            } else if(c == '<' || c == '>' || c == '=' || c == '!') {
+                size_t start = i++;
+                if(i < text.size() && text[i] == '=') i++;
+                string op(text.substr(start, i - start));
+                if(op == "!") {
+                    error = "expected != at position " + to_string(start);
+                    return false;
+                }
+                tokens.push_back(op == "==" ? "=" : op);
+            } else if(isalnum((unsigned char)c) || c == '_' || c == '.' || c == '-') {
+                size_t start = i;
+                while(i < text.size() && (isalnum((unsigned char)text[i]) || text[i] == '_' || text[i] == '.' || text[i] == '-')) i++;
+                tokens.push_back(string(text.substr(start, i - start)));
+            } else {
+                error = string("unexpected character '") + c + "' at position " + to_string(i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool atEnd() const {
+        return position >= tokens.size();
+    }
+
+    bool peekKeyword(const char* keyword) const {
+        return !atEnd() && upper(tokens[position]) == keyword;
+    }
+
+    // ---------- name lookup ----------
+    static int statusCode(string_view name) {
+        string u = upper(name);
+        for(int s = 0; s < VEHICLE_STATUS_COUNT; s++) {
+            if(u == vehicleStatusName((VehicleStatus)s)) return s;
+        }
+        return -1;
+    }
+
+    static int typeCode(string_view name) {
+        string u = upper(name);
+        for(int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+            if(u == upper(vehicleTypeName((VehicleType)t))) return t;
+        }
+        return -1;
+    }
+
+    static bool fieldOf(string_view name, QueryField& field) {
+        string u = upper(name);
+        if(u == "YEAR") field = QUERY_YEAR;
+        else if(u == "KM" || u == "KILOMETERS") field = QUERY_KM;
+        else if(u == "DAYS" || u == "SERVICE_DAYS") field = QUERY_DAYS;
+        else if(u == "STATUS") field = QUERY_STATUS;
+        else if(u == "TYPE") field = QUERY_TYPE;
+        else return false;
+        return true;
+    }
+
+    static bool opOf(const string& token, QueryOp& op) {
+        if(token == "<") op = QUERY_LT;
+        else if(token == "<=") op = QUERY_LE;
+        else if(token == ">") op = QUERY_GT;
+        else if(token == ">=") op = QUERY_GE;
+        else if(token == "=") op = QUERY_EQ;
+        else if(token == "!=") op = QUERY_NE;
+        else return false;
+        return true;
+    }
+
+    int addNode(QueryNodeKind kind) {
+        QueryNode node;
+        node.kind = kind;
+        node.field = QUERY_YEAR;
+        node.op = QUERY_EQ;
+        node.value = 0;
+        nodes.push_back(node);
+        return (int)nodes.size() - 1;
+    }
+
+    int addCompare(QueryField field, QueryOp op, double value) {
+        int index = addNode(QUERY_COMPARE);
+        nodes[index].field = field;
+        nodes[index].op = op;
+        nodes[index].value = value;
+        return index;
+    }
+
+    // ---------- recursive descent; each returns a node index or -1 ----------
+    int parseOr() {
+        int left = parseAnd();
+        if(left < 0 || !peekKeyword("OR")) return left;
+        int node = addNode(QUERY_OR);
+        nodes[node].children.push_back(left);
+        while(peekKeyword("OR")) {
+            position++;
+            int right = parseAnd();
+            if(right < 0) return -1;
+            nodes[node].children.push_back(right);
+        }
+        return node;
+    }
+
+    int parseAnd() {
+        int left = parseFactor();
+        if(left < 0 || !peekKeyword("AND")) return left;
+        int node = addNode(QUERY_AND);
+        nodes[node].children.push_back(left);
+        while(peekKeyword("AND")) {
+            position++;
+            int right = parseFactor();
+            if(right < 0) return -1;
+            nodes[node].children.push_back(right);
+        }
+        return node;
+    }
+
+    int parseFactor() {
+        if(atEnd()) {
+            error = "unexpected end of query";
+            return -1;
+        }
+        bool nested = peekKeyword("NOT") || tokens[position] == "(";
+        if(nested && depth >= QUERY_MAX_DEPTH) {
+            error = "query nested deeper than " + to_string(QUERY_MAX_DEPTH);
+            return -1;
+        }
+        if(peekKeyword("NOT")) {
+            position++;
+            depth++;
+            int child = parseFactor();
+            depth--;
+            if(child < 0) return -1;
+            int node = addNode(QUERY_NOT);
+            nodes[node].children.push_back(child);
+            return node;
+        }
+        if(tokens[position] == "(") {
+            position++;
+            depth++;
+            int inner = parseOr();
+            depth--;
+            if(inner < 0) return -1;
+            if(atEnd() || tokens[position] != ")") {
+                error = "missing )";
+                return -1;
+            }
+            position++;
+            return inner;
+        }
+        return parseComparison();
+    }
+
+    int parseComparison() {
+        const string& name = tokens[position++];
+        QueryField field;
+        QueryOp op;
+        if(!fieldOf(name, field)) {
+            // Bare status or type name
+            int code = statusCode(name);
+            if(code >= 0) return addCompare(QUERY_STATUS, QUERY_EQ, code);
+            code = typeCode(name);
+            if(code >= 0) return addCompare(QUERY_TYPE, QUERY_EQ, code);
+            error = "unknown field or name '" + name + "'";
+            return -1;
+        }
+        if(atEnd() || !opOf(tokens[position], op)) {
+            error = "expected a comparison after '" + name + "'";
+            return -1;
+        }
+        position++;
+        if(atEnd()) {
+            error = "expected a value after '" + name + "'";
+            return -1;
+        }
+        const string& text = tokens[position++];
+
+        if(field == QUERY_STATUS || field == QUERY_TYPE) {
+            if(op != QUERY_EQ && op != QUERY_NE) {
+                error = "'" + name + "' only supports = and !=";
+                return -1;
+            }
+            int code = field == QUERY_STATUS ? statusCode(text) : typeCode(text);
+            if(code < 0) {
+                error = "unknown " + string(field == QUERY_STATUS ? "status" : "type") + " '" + text + "'";
+                return -1;
+            }
+            return addCompare(field, op, code);
+        }
+
+        char* end = NULL;
+        double value = strtod(text.c_str(), &end);
+        if(text.empty() || *end != '\0') {
+            error = "expected a number after '" + name + "', got '" + text + "'";
+            return -1;
+        }
+        if(!isfinite(value)) {
+            error = "'" + name + "' expects a finite number";
+            return -1;
+        }
+        if(field != QUERY_KM) {
+            // Range first: casting an out-of-range double is undefined
+            if(value < -2147483648.0 || value > 2147483647.0) {
+                error = "'" + name + "' value " + text + " is out of range";
+                return -1;
+            }
+            if(value != trunc(value)) {
+                error = "'" + name + "' expects a whole number";
+                return -1;
+            }
+        }
+        return addCompare(field, op, value);
+    }
+
+    void describeNode(int index, string& out) const {
+        static const char* fieldNames[] = {"year", "km", "days", "status", "type"};
+        static const char* opNames[] = {"<", "<=", ">", ">=", "=", "!="};
+        const QueryNode& node = nodes[index];
+        if(node.kind == QUERY_COMPARE) {
+            out += fieldNames[node.field];
+            out += " ";
+            out += opNames[node.op];
+            out += " ";
+            if(node.field == QUERY_STATUS) out += vehicleStatusName((VehicleStatus)(int)node.value);
+            else if(node.field == QUERY_TYPE) out += vehicleTypeName((VehicleType)(int)node.value);
+            else {
+                string number = to_string(node.value);
+                number.erase(number.find_last_not_of('0') + 1);
+                if(number.back() == '.') number.pop_back();
+                out += number;
+            }
+            return;
+        }
+        if(node.kind == QUERY_NOT) {
+            out += "NOT ";
+            describeNode(node.children[0], out);
+            return;
+        }
+        out += "(";
+        for(size_t i = 0; i < node.children.size(); i++) {
+            if(i > 0) out += node.kind == QUERY_AND ? " AND " : " OR ";
+            describeNode(node.children[i], out);
+        }
+        out += ")";
+    }
+
+public:
+    FleetQuery() {
+        root = -1;
+        position = 0;
+        depth = 0;
+    }
+
+    // Parse and validate; on failure getError() says why
+    bool compile(string_view text) {
+        nodes.clear();
+        root = -1;
+        error = "";
+        position = 0;
+        depth = 0;
+        if(!tokenize(text)) return false;
+        if(tokens.empty()) {
+            error = "empty query";
+            return false;
+        }
+        int parsed = parseOr();
+        if(parsed < 0) return false;
+        if(!atEnd()) {
+            error = "unexpected '" + tokens[position] + "'";
+            return false;
+        }
+        root = parsed;
+        return true;
+    }
+
+    bool isValid() const {
+        return root >= 0;
+    }
+
+    const string& getError() const {
+        return error;
+    }
+
+    const vector<QueryNode>& getNodes() const {
+        return nodes;
+    }
+
+    int getRoot() const {
+        return root;
+    }
+
+    // Fully parenthesized form, e.g. for logging
+    string describe() const {
+        string out;
+        if(root >= 0) describeNode(root, out);
+        return out;
+    }
+};
+
+// Runs compiled FleetQuery predicates over a FleetStore.
+// Each comparison is a tight loop over one column that writes a byte per
+// row (the compiler vectorizes it; with SSE2 the bytes are packed to bits
+// 16 at a time) and produces a RoaringBitmap, chunk by chunk. AND passes
+// the result so far into the next child, which then skips every 64-row
+// block that is already empty - so later predicates of a selective AND
+// touch only a fraction of the column. OR unions, NOT subtracts from the
+// candidate set. Results are row bitmaps; count() and vehicleIds() never
+// build Vehicle objects.
+class FleetQueryEngine {
+private:
+    const FleetStore& fleet;
+
+    template <int OP, typename T, typename V>
+    static bool test(T x, V v) {
+        if(OP == QUERY_LT) return (V)x < v;
+        if(OP == QUERY_LE) return (V)x <= v;
+        if(OP == QUERY_GT) return (V)x > v;
+        if(OP == QUERY_GE) return (V)x >= v;
+        if(OP == QUERY_EQ) return (V)x == v;
+        return (V)x != v;
+    }
+
+    // 64 match bytes (0/1) -> one word
+    static uint64_t packBytes(const uint8_t* match) {
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        uint64_t bits = 0;
+        for(int part = 0; part < 4; part++) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(match + 16 * part));
+            bits |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, zero)) << (16 * part);
+        }
+        return bits;
+#else
+        uint64_t bits = 0;
+        for(int i = 0; i < 64; i++) {
+            bits |= (uint64_t)match[i] << i;
+        }
+        return bits;
+#endif
+    }
+
+    // Words for rows [begin, begin + 64 * nWords) of one chunk; a zero
+    // mask word skips its block
+    template <int OP, typename T, typename V>
+    static void scanWords(const T* column, V value, size_t begin, size_t rows,
+                          const uint64_t* mask, uint64_t* out, size_t nWords) {
+        uint8_t match[64];
+        for(size_t w = 0; w < nWords; w++) {
+            out[w] = 0;
+            if(mask != NULL && mask[w] == 0) continue;
+            size_t start = begin + w * 64;
+            if(start >= rows) continue;
+            size_t count = rows - start < 64 ? rows - start : 64;
+            const T* col = column + start;
+            if(count == 64) {
+                for(int i = 0; i < 64; i++) {
+                    match[i] = test<OP>(col[i], value);
+                }
+                out[w] = packBytes(match);
+            } else {
+                for(size_t i = 0; i < count; i++) {
+                    out[w] |= (uint64_t)test<OP>(col[i], value) << i;
+                }
+            }
+            if(mask != NULL) out[w] &= mask[w];
+        }
+    }
+
+    template <typename T, typename V>
+    static void scanColumn(QueryOp op, const T* column, V value, size_t begin, size_t rows,
+                           const uint64_t* mask, uint64_t* out, size_t nWords) {
+        switch(op) {
+            case QUERY_LT: scanWords<QUERY_LT>(column, value, begin, rows, mask, out, nWords); break;
+            case QUERY_LE: scanWords<QUERY_LE>(column, value, begin, rows, mask, out, nWords); break;
+            case QUERY_GT: scanWords<QUERY_GT>(column, value, begin, rows, mask, out, nWords); break;
+            case QUERY_GE: scanWords<QUERY_GE>(column, value, begin, rows, mask, out, nWords); break;
+            case QUERY_EQ: scanWords<QUERY_EQ>(column, value, begin, rows, mask, out, nWords); break;
+            case QUERY_NE: scanWords<QUERY_NE>(column, value, begin, rows, mask, out, nWords); break;
+        }
+    }
+
+    // Integer columns compare against a clamped 32-bit value (same result)
+    static int32_t clampInt(double value) {
+        if(value < -2147483648.0) return INT32_MIN;
+        if(value > 2147483647.0) return INT32_MAX;
+        return (int32_t)value;
+    }
+
+    void scanChunk(const QueryNode& node, size_t begin, const uint64_t* mask, uint64_t* out) const {
+        size_t rows = fleet.size();
+        switch(node.field) {
+            case QUERY_YEAR:
+                scanColumn(node.op, fleet.yearsColumn(), clampInt(node.value), begin, rows, mask, out, ROARING_CHUNK_WORDS);
+                break;
+            case QUERY_KM:
+                scanColumn(node.op, fleet.kilometersColumn(), node.value, begin, rows, mask, out, ROARING_CHUNK_WORDS);
+                break;
+            case QUERY_DAYS:
+                scanColumn(node.op, fleet.serviceDaysColumn(), clampInt(node.value), begin, rows, mask, out, ROARING_CHUNK_WORDS);
+                break;
+            case QUERY_STATUS:
+                scanColumn(node.op, fleet.statusColumn(), (uint8_t)node.value, begin, rows, mask, out, ROARING_CHUNK_WORDS);
+                break;
+            case QUERY_TYPE:
+                scanColumn(node.op, fleet.typeColumn(), (uint8_t)node.value, begin, rows, mask, out, ROARING_CHUNK_WORDS);
+                break;
+        }
+    }
+
+    // Rows of 'within' (all rows if NULL) matching one comparison
+    RoaringBitmap scan(const QueryNode& node, const RoaringBitmap* within) const {
+        RoaringBitmap result;
+        vector<uint64_t> words(ROARING_CHUNK_WORDS);
+        if(within == NULL) {
+            for(size_t begin = 0; begin < fleet.size(); begin += ROARING_CHUNK_BITS) {
+                scanChunk(node, begin, NULL, words.data());
+                result.appendChunk((uint16_t)(begin >> 16), words.data(), ROARING_CHUNK_WORDS);
+            }
+            return result;
+        }
+        vector<uint64_t> mask(ROARING_CHUNK_WORDS);
+        for(size_t i = 0; i < within->getNumChunks(); i++) {
+            within->chunkWords(i, mask.data());
+            size_t begin = (size_t)within->chunkKey(i) << 16;
+            scanChunk(node, begin, mask.data(), words.data());
+            result.appendChunk(within->chunkKey(i), words.data(), ROARING_CHUNK_WORDS);
+        }
+        return result;
+    }
+
+    RoaringBitmap evaluateNode(const FleetQuery& query, int index, const RoaringBitmap* within) const {
+        const QueryNode& node = query.getNodes()[index];
+        if(node.kind == QUERY_COMPARE) {
+            return scan(node, within);
+        }
+        if(node.kind == QUERY_NOT) {
+            RoaringBitmap candidates = within != NULL ? *within : RoaringBitmap::range((uint32_t)fleet.size());
+            return candidates.andNotWith(evaluateNode(query, node.children[0], &candidates));
+        }
+        if(node.kind == QUERY_AND) {
+            RoaringBitmap result = evaluateNode(query, node.children[0], within);
+            for(size_t i = 1; i < node.children.size() && !result.isEmpty(); i++) {
+                result = evaluateNode(query, node.children[i], &result);
+            }
+            return result;
+        }
+        RoaringBitmap result = evaluateNode(query, node.children[0], within);
+        for(size_t i = 1; i < node.children.size(); i++) {
+            result = result.orWith(evaluateNode(query, node.children[i], within));
+        }
+        return result;
+    }
+
+public:
+    FleetQueryEngine(const FleetStore& store) : fleet(store) {
+    }
+
+    // Matching rows; empty for an invalid query
+    RoaringBitmap evaluate(const FleetQuery& query) const {
+        if(!query.isValid()) return RoaringBitmap();
+        return evaluateNode(query, query.getRoot(), NULL);
+    }
+
+    size_t count(const FleetQuery& query) const {
+        return evaluate(query).cardinality();
+    }
+
+    // IDs of matching vehicles; views stay valid while the store is unchanged
+    size_t vehicleIds(const FleetQuery& query, vector<string_view>& ids) const {
+        RoaringBitmap rows = evaluate(query);
+        ids.clear();
+        ids.reserve(rows.cardinality());
+        rows.forEach([&](uint32_t row) { ids.push_back(fleet.vehicleId(row)); });
+        return ids.size();
+    }
+
+    // Compile and count in one call; false (with a message) on a bad query
+    bool run(string_view text, size_t& matches) const {
+        FleetQuery query;
+        if(!query.compile(text)) {
+            cout << "❌ Query error: " << query.getError() << endl;
+            return false;
+        }
+        matches = count(query);
+        return true;
+    }
+};
+
+#endif
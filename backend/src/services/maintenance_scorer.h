@@ -0,0 +1,199 @@
+#ifndef MAINTENANCE_SCORER_H
+#define MAINTENANCE_SCORER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "../data_structures/fleet_store.h"
+using namespace std;
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MAINTENANCE_SCORER_X86 1
+#include <immintrin.h>
+#endif
+
+enum ScoringPath {
+    SCORING_SCALAR,
+    SCORING_SSE2,
+    SCORING_AVX2
+};
+
+// Fleet-wide maintenance scoring over FleetStore columns.
+// For every row it writes the same priority as
+// Vehicle::getMaintenancePriority() and sets bit r of the urgency mask when
+// Vehicle::needsMaintenance() would be true, from the same MAINTENANCE_*
+// constants (vehicle.h). The loop is vectorized with
+// AVX2 (8 vehicles per step) or SSE2 (4 per step), picked at runtime from
+// what the CPU supports; other targets use the scalar loop. Divisions are
+// done in double precision and truncated, exactly like the per-object path.
+class MaintenanceScorer {
+private:
+    ScoringPath path;
+
+    static size_t scoreScalar(const double* km, const int32_t* days, size_t begin, size_t n,
+                              int32_t* priority, uint64_t* urgentBits) {
+        size_t urgent = 0;
+        for(size_t r = begin; r < n; r++) {
+            priority[r] = (int32_t)(km[r] / MAINTENANCE_KM_PER_POINT) + days[r] / MAINTENANCE_DAYS_PER_POINT;
+            if(km[r] > MAINTENANCE_URGENT_KM || days[r] > MAINTENANCE_URGENT_DAYS) {
+                urgentBits[r >> 6] |= 1ULL << (r & 63);
+                urgent++;
+            }
+        }
+        return urgent;
+    }
+
+#ifdef MAINTENANCE_SCORER_X86
+    // Two vehicles per half step, four per loop iteration
+    static size_t scoreSse2(const double* km, const int32_t* days, size_t n,
+                            int32_t* priority, uint64_t* urgentBits) {
+        const __m128d kmScale = _mm_set1_pd(MAINTENANCE_KM_PER_POINT);
+        const __m128d dayScale = _mm_set1_pd((double)MAINTENANCE_DAYS_PER_POINT);
+        const __m128d kmLimit = _mm_set1_pd(MAINTENANCE_URGENT_KM);
+        const __m128i dayLimit = _mm_set1_epi32(MAINTENANCE_URGENT_DAYS);
+        size_t urgent = 0;
+        size_t r = 0;
+        for(; r + 4 <= n; r += 4) {
+            __m128i d = _mm_loadu_si128((const __m128i*)(days + r));
+            __m128d kmLo = _mm_loadu_pd(km + r);
+            __m128d kmHi = _mm_loadu_pd(km + r + 2);
+            __m128d dLo = _mm_cvtepi32_pd(d);
+            __m128d dHi = _mm_cvtepi32_pd(_mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            __m128i pLo = _mm_add_epi32(_mm_cvttpd_epi32(_mm_div_pd(kmLo, kmScale)),
+                                        _mm_cvttpd_epi32(_mm_div_pd(dLo, dayScale)));
+            __m128i pHi = _mm_add_epi32(_mm_cvttpd_epi32(_mm_div_pd(kmHi, kmScale)),
+                                        _mm_cvttpd_epi32(_mm_div_pd(dHi, dayScale)));
+            _mm_storeu_si128((__m128i*)(priority + r), _mm_unpacklo_epi64(pLo, pHi));
+
+            int kmMask = _mm_movemask_pd(_mm_cmpgt_pd(kmLo, kmLimit)) |
+                         (_mm_movemask_pd(_mm_cmpgt_pd(kmHi, kmLimit)) << 2);
+            int dayMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(d, dayLimit)));
+            uint64_t mask = (uint64_t)(kmMask | dayMask);
+            urgentBits[r >> 6] |= mask << (r & 63);     // r is a multiple of 4
+            urgent += __builtin_popcount((unsigned)mask);
+        }
+        return urgent + scoreScalar(km, days, r, n, priority, urgentBits);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t scoreAvx2(const double* km, const int32_t* days, size_t n,
+                            int32_t* priority, uint64_t* urgentBits) {
+        const __m256d kmScale = _mm256_set1_pd(MAINTENANCE_KM_PER_POINT);
+        const __m256d dayScale = _mm256_set1_pd((double)MAINTENANCE_DAYS_PER_POINT);
+        const __m256d kmLimit = _mm256_set1_pd(MAINTENANCE_URGENT_KM);
+        const __m256i dayLimit = _mm256_set1_epi32(MAINTENANCE_URGENT_DAYS);
+        size_t urgent = 0;
+        size_t r = 0;
+        for(; r + 8 <= n; r += 8) {
+            __m256i d = _mm256_loadu_si256((const __m256i*)(days + r));
+            __m256d kmLo = _mm256_loadu_pd(km + r);
+            __m256d kmHi = _mm256_loadu_pd(km + r + 4);
+            __m256d dLo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(d));
+            __m256d dHi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(d, 1));
+
+            __m128i pLo = _mm_add_epi32(_mm256_cvttpd_epi32(_mm256_div_pd(kmLo, kmScale)),
+                                        _mm256_cvttpd_epi32(_mm256_div_pd(dLo, dayScale)));
+            __m128i pHi = _mm_add_epi32(_mm256_cvttpd_epi32(_mm256_div_pd(kmHi, kmScale)),
+                                        _mm256_cvttpd_epi32(_mm256_div_pd(dHi, dayScale)));
+            _mm256_storeu_si256((__m256i*)(priority + r), _mm256_set_m128i(pHi, pLo));
+
+            int kmMask = _mm256_movemask_pd(_mm256_cmp_pd(kmLo, kmLimit, _CMP_GT_OQ)) |
+                         (_mm256_movemask_pd(_mm256_cmp_pd(kmHi, kmLimit, _CMP_GT_OQ)) << 4);
+            int dayMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(d, dayLimit)));
+            uint64_t mask = (uint64_t)(kmMask | dayMask);
+            urgentBits[r >> 6] |= mask << (r & 63);     // r is a multiple of 8
+            urgent += __builtin_popcount((unsigned)mask);
+        }
+        return urgent + scoreScalar(km, days, r, n, priority, urgentBits);
+    }
+#endif
+
+public:
+    // Uses the widest path the CPU supports
+    MaintenanceScorer() {
+        path = SCORING_SCALAR;
+#ifdef MAINTENANCE_SCORER_X86
+        if(isSupported(SCORING_AVX2)) path = SCORING_AVX2;
+        else if(isSupported(SCORING_SSE2)) path = SCORING_SSE2;
+#endif
+    }
+
+    static bool isSupported(ScoringPath p) {
+        if(p == SCORING_SCALAR) return true;
+#ifdef MAINTENANCE_SCORER_X86
+        __builtin_cpu_init();
+        if(p == SCORING_SSE2) return __builtin_cpu_supports("sse2");
+        if(p == SCORING_AVX2) return __builtin_cpu_supports("avx2");
+#endif
+        return false;
+    }
+
+    // Force a path (for benchmarks); false if the CPU cannot run it
+    bool setPath(ScoringPath p) {
+        if(!isSupported(p)) return false;
+        path = p;
+        return true;
+    }
+
+    ScoringPath getPath() const {
+        return path;
+    }
+
+    const char* getPathName() const {
+        if(path == SCORING_AVX2) return "AVX2";
+        if(path == SCORING_SSE2) return "SSE2";
+        return "scalar";
+    }
+
+    // priority[0..n) and urgentBits[0..(n+63)/64) are overwritten.
+    // Returns the number of urgent vehicles.
+    size_t score(const double* km, const int32_t* days, size_t n, int32_t* priority, uint64_t* urgentBits) const {
+        for(size_t w = 0; w < (n + 63) / 64; w++) {
+            urgentBits[w] = 0;
+        }
+#ifdef MAINTENANCE_SCORER_X86
+        if(path == SCORING_AVX2) return scoreAvx2(km, days, n, priority, urgentBits);
+        if(path == SCORING_SSE2) return scoreSse2(km, days, n, priority, urgentBits);
+#endif
+        return scoreScalar(km, days, 0, n, priority, urgentBits);
+    }
+
+    size_t scoreFleet(const FleetStore& fleet, vector<int32_t>& priority, vector<uint64_t>& urgentBits) const {
+        size_t n = fleet.size();
+        priority.resize(n);
+        urgentBits.resize((n + 63) / 64);
+        if(n == 0) return 0;
+        return score(fleet.kilometersColumn(), fleet.serviceDaysColumn(), n, priority.data(), urgentBits.data());
+    }
+
+    // Rows of the k lowest scores, lowest first. Equal scores are ordered
+    // (and cut at the k-th place) by row: the comparator is a total order,
+    // so nth_element picks the same rows every time. MinHeap::topK() may
+    // order equal priorities differently. nth_element + sort of the k
+    // winners: O(n + k log k) instead of sorting the whole fleet.
+    static void topK(const vector<int32_t>& priority, int k, vector<uint32_t>& rows) {
+        rows.clear();
+        if(k <= 0) return;
+        size_t n = priority.size();
+        rows.resize(n);
+        for(size_t r = 0; r < n; r++) {
+            rows[r] = (uint32_t)r;
+        }
+        auto better = [&](uint32_t a, uint32_t b) {
+            return priority[a] != priority[b] ? priority[a] < priority[b] : a < b;
+        };
+        if((size_t)k < n) {
+            nth_element(rows.begin(), rows.begin() + k, rows.end(), better);
+            rows.resize(k);
+        }
+        sort(rows.begin(), rows.end(), better);
+    }
+
+    static bool isUrgent(const vector<uint64_t>& urgentBits, uint32_t row) {
+        return (urgentBits[row >> 6] >> (row & 63)) & 1;
+    }
+};
+
+#endif
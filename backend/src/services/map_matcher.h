@@ -0,0 +1,416 @@
+#ifndef MAP_MATCHER_H
+#define MAP_MATCHER_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "../data_structures/road_segment_index.h"
+#include "../data_structures/thread_pool.h"
+#include "../data_structures/geo.h"
+using namespace std;
+
+#define MAP_MATCH_SIGMA_KM 0.02         // GPS noise (standard deviation)
+#define MAP_MATCH_BETA_KM 0.05          // Typical |route - straight line| between fixes
+#define MAP_MATCH_MAX_CANDIDATES 8      // Nearest arcs considered per fix
+#define MAP_MATCH_MAX_DETOUR 3.0        // A route longer than this x straight line is implausible
+
+// One raw GPS fix of a trip
+struct GpsPoint {
+    double latitude;
+    double longitude;
+    int64_t timestampMs;
+};
+
+// One road traversed by the trip, as Graph location ids
+struct MatchedEdge {
+    int from;
+    int to;
+};
+
+struct MatchedTrip {
+    vector<MatchedEdge> edges;  // In driving order
+    double distanceKm;          // Along the roads, first to last matched fix
+    int points;                 // Fixes received
+    int matchedPoints;          // Fixes that became a Viterbi step
+    int skippedPoints;          // Out of order, or within 2 sigma of the previous fix
+    int unmatchedPoints;        // No road within the search radius
+    int breaks;                 // No plausible route between consecutive fixes
+
+    MatchedTrip() {
+        clear();
+    }
+
+    void clear() {
+        edges.clear();
+        distanceKm = 0;
+        points = 0;
+        matchedPoints = 0;
+        skippedPoints = 0;
+        unmatchedPoints = 0;
+        breaks = 0;
+    }
+};
+
+// HMM map matching of one trip (Newson & Krumm).
+// Hidden states are candidate positions on arcs near each fix. Emission
+// scores a candidate by its distance to the fix (Gaussian, sigma);
+// transition scores a pair of candidates by how much the road route
+// between them differs from the straight line between the fixes
+// (exponential, beta). Fixes are streamed in with addPoint(): each one adds
+// a Viterbi layer, with route distances from one bounded Dijkstra per
+// distinct end vertex of the previous layer. When no candidate pair is
+// reachable (tunnel, missing road) the chain is closed and a new one
+// starts. finish() backtracks and expands each step into the edges driven.
+//
+// All log-probabilities are kept relative to the best state of the layer.
+// Not thread-safe; MapMatcher keeps one per worker.
+class TripMatcher {
+private:
+    struct State {
+        int arc;
+        double fraction;
+        double score;       // Best log-probability of reaching this state
+        int back;           // Index in history of the previous state, -1 starts the chain
+    };
+
+    struct HeapItem {
+        double dist;
+        int node;
+        bool operator>(const HeapItem& other) const {
+            return dist > other.dist;
+        }
+    };
+
+    const RoadSegmentIndex* index;
+    double sigmaKm;
+    double betaKm;
+    double radiusKm;
+
+    vector<State> history;          // Every layer of the open chain
+    size_t layerBegin;              // Current layer: history[layerBegin ..)
+    GpsPoint lastPoint;
+    bool hasLastPoint;
+    MatchedTrip result;
+
+    vector<SegmentCandidate> candidates;
+    vector<State> nextLayer;
+    vector<int> order;
+    vector<int> chain;
+
+    // Route search workspace, reset in O(1) per query like DijkstraSearch
+    vector<double> dist;
+    vector<int> parentArc;
+    vector<uint32_t> stamp;
+    uint32_t generation;
+    vector<HeapItem> heap;
+
+    double emission(double distanceKm) const {
+        double z = distanceKm / sigmaKm;
+        return -0.5 * z * z;
+    }
+
+    void beginSearch() {
+        int n = index->getGraph().getNumVertices();
+        if((int)stamp.size() != n) {
+            dist.assign(n, INFINITY);
+            parentArc.assign(n, -1);
+            stamp.assign(n, 0);
+            generation = 0;
+        }
+        generation++;
+        if(generation == 0) {
+            fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        heap.clear();
+    }
+
+    double distanceTo(int v) const {
+        return stamp[v] == generation ? dist[v] : INFINITY;
+    }
+
+    // Dijkstra over arc lengths in km from source, settling every vertex
+    // closer than limitKm, or stopping early once target is settled
+    void search(int source, double limitKm, int target) {
+        beginSearch();
+        const CSRGraph& graph = index->getGraph();
+        stamp[source] = generation;
+        dist[source] = 0;
+        parentArc[source] = -1;
+        heap.push_back(HeapItem{0, source});
+
+        while(!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<HeapItem>());
+            HeapItem top = heap.back();
+            heap.pop_back();
+            int u = top.node;
+            if(top.dist > dist[u]) continue;
+            if(top.dist > limitKm || u == target) break;
+
+            for(int a = graph.arcBegin(u); a < graph.arcEnd(u); a++) {
+                double length = index->arcLengthKm(a);
+                if(std::isinf(length)) continue;
+                int v = graph.arcTarget(a);
+                double nd = top.dist + length;
+                if(stamp[v] != generation || nd < dist[v]) {
+                    stamp[v] = generation;
+                    dist[v] = nd;
+                    parentArc[v] = a;
+                    heap.push_back(HeapItem{nd, v});
+                    push_heap(heap.begin(), heap.end(), greater<HeapItem>());
+                }
+            }
+        }
+    }
+
+    // Same arc, not moving backwards beyond GPS jitter: no search needed
+    bool alongSameArc(const State& from, int arc, double fraction, double& routeKm) const {
+        if(from.arc != arc) return false;
+        double along = (fraction - from.fraction) * index->arcLengthKm(arc);
+        if(along < -sigmaKm) return false;
+        routeKm = along > 0 ? along : 0;
+        return true;
+    }
+
+    // Start a chain at the current candidates
+    void startChain() {
+        history.clear();
+        layerBegin = 0;
+        for(size_t j = 0; j < candidates.size(); j++) {
+            history.push_back(State{candidates[j].arc, candidates[j].fraction, emission(candidates[j].distanceKm), -1});
+        }
+    }
+
+    // Viterbi step. Returns false if no candidate is reachable from the
+    // previous layer.
+    bool extendChain(const GpsPoint& p) {
+        double straightKm = haversineKm(lastPoint.latitude, lastPoint.longitude, p.latitude, p.longitude);
+        double limitKm = straightKm * MAP_MATCH_MAX_DETOUR + 2 * radiusKm;
+
+        nextLayer.clear();
+        for(size_t j = 0; j < candidates.size(); j++) {
+            nextLayer.push_back(State{candidates[j].arc, candidates[j].fraction, -INFINITY, -1});
+        }
+
+        // Previous states sharing an end vertex share one search
+        order.clear();
+        for(size_t i = layerBegin; i < history.size(); i++) order.push_back((int)i);
+        sort(order.begin(), order.end(), [&](int a, int b) {
+            return index->arcTarget(history[a].arc) < index->arcTarget(history[b].arc);
+        });
+
+        int searchedFrom = -1;
+        for(size_t o = 0; o < order.size(); o++) {
+            const State& from = history[order[o]];
+            int head = index->arcTarget(from.arc);
+            double remainingKm = (1 - from.fraction) * index->arcLengthKm(from.arc);
+            for(size_t j = 0; j < nextLayer.size(); j++) {
+                State& to = nextLayer[j];
+                double routeKm;
+                if(!alongSameArc(from, to.arc, to.fraction, routeKm)) {
+                    if(head != searchedFrom) {
+                        search(head, limitKm, -1);
+                        searchedFrom = head;
+                    }
+                    routeKm = remainingKm + distanceTo(index->arcSource(to.arc)) + to.fraction * index->arcLengthKm(to.arc);
+                }
+                if(routeKm > limitKm) continue;
+                double score = from.score - fabs(routeKm - straightKm) / betaKm;
+                if(score > to.score) {
+                    to.score = score;
+                    to.back = order[o];
+                }
+            }
+        }
+
+        double best = -INFINITY;
+        for(size_t j = 0; j < nextLayer.size(); j++) {
+            nextLayer[j].score += emission(candidates[j].distanceKm);
+            if(nextLayer[j].score > best) best = nextLayer[j].score;
+        }
+        if(std::isinf(best)) return false;
+
+        layerBegin = history.size();
+        for(size_t j = 0; j < nextLayer.size(); j++) {
+            if(std::isinf(nextLayer[j].score)) continue;
+            nextLayer[j].score -= best;
+            history.push_back(nextLayer[j]);
+        }
+        return true;
+    }
+
+    void appendEdge(int arc) {
+        MatchedEdge e{index->arcSource(arc), index->arcTarget(arc)};
+        if(!result.edges.empty() && result.edges.back().from == e.from && result.edges.back().to == e.to) return;
+        result.edges.push_back(e);
+    }
+
+    // Backtrack the open chain from its best final state and expand it into
+    // edges and driven distance
+    void closeChain() {
+        if(history.empty()) return;
+        int best = (int)layerBegin;
+        for(size_t i = layerBegin; i < history.size(); i++) {
+            if(history[i].score > history[best].score) best = (int)i;
+        }
+        chain.clear();
+        for(int s = best; s != -1; s = history[s].back) chain.push_back(s);
+        reverse(chain.begin(), chain.end());
+
+        // A chain starting at the very end of an arc did not drive any of it
+        if(chain.size() == 1 || history[chain[0]].fraction < 1) appendEdge(history[chain[0]].arc);
+        for(size_t c = 1; c < chain.size(); c++) {
+            const State& from = history[chain[c - 1]];
+            const State& to = history[chain[c]];
+            double routeKm;
+            if(alongSameArc(from, to.arc, to.fraction, routeKm)) {
+                result.distanceKm += routeKm;
+                continue;
+            }
+            int head = index->arcTarget(from.arc);
+            int tail = index->arcSource(to.arc);
+            search(head, INFINITY, tail);
+            result.distanceKm += (1 - from.fraction) * index->arcLengthKm(from.arc) + distanceTo(tail) +
+                                 to.fraction * index->arcLengthKm(to.arc);
+
+            size_t firstNew = result.edges.size();
+            for(int v = tail; parentArc[v] != -1 && v != head; v = index->arcSource(parentArc[v])) {
+                result.edges.push_back(MatchedEdge{index->arcSource(parentArc[v]), v});
+            }
+            reverse(result.edges.begin() + firstNew, result.edges.end());
+            if(c + 1 < chain.size() || to.fraction > 0) appendEdge(to.arc);
+        }
+        history.clear();
+        layerBegin = 0;
+    }
+
+public:
+    TripMatcher(const RoadSegmentIndex& segmentIndex, double sigma = MAP_MATCH_SIGMA_KM, double beta = MAP_MATCH_BETA_KM) {
+        index = &segmentIndex;
+        sigmaKm = sigma;
+        betaKm = beta;
+        radiusKm = 5 * sigma;
+        generation = 0;
+        lastPoint = GpsPoint{0, 0, 0};
+        reset();
+    }
+
+    // Begin a new trip
+    void reset() {
+        history.clear();
+        layerBegin = 0;
+        hasLastPoint = false;
+        result.clear();
+    }
+
+    // Feed the next fix of the trip
+    void addPoint(const GpsPoint& p) {
+        result.points++;
+        if(hasLastPoint) {
+            // Fixes closer than 2 sigma carry no direction information
+            if(p.timestampMs < lastPoint.timestampMs ||
+               haversineKm(lastPoint.latitude, lastPoint.longitude, p.latitude, p.longitude) < 2 * sigmaKm) {
+                result.skippedPoints++;
+                return;
+            }
+        }
+
+        index->candidates(p.latitude, p.longitude, radiusKm, MAP_MATCH_MAX_CANDIDATES, candidates);
+        if(candidates.empty()) {
+            result.unmatchedPoints++;
+            return;
+        }
+
+        if(history.empty()) {
+            startChain();
+        } else if(!extendChain(p)) {
+            closeChain();
+            result.breaks++;
+            startChain();
+        }
+        lastPoint = p;
+        hasLastPoint = true;
+        result.matchedPoints++;
+    }
+
+    // Close the trip and hand over its matched route
+    void finish(MatchedTrip& out) {
+        closeChain();
+        out = result;
+        reset();
+    }
+};
+
+// Batch map matching (e.g. every trip of the day at night).
+// Trips are spread over a ThreadPool; each worker owns one TripMatcher, so
+// the search workspaces are allocated once and reused for every trip. The
+// RoadSegmentIndex is shared read-only by all workers.
+class MapMatcher {
+private:
+    ThreadPool& pool;
+    vector<TripMatcher> workers;
+    long long trips;
+    long long points;
+    long long matchedPoints;
+    long long unmatchedPoints;
+    long long breaks;
+    double distanceKm;
+
+public:
+    MapMatcher(const RoadSegmentIndex& index, ThreadPool& threadPool,
+               double sigmaKm = MAP_MATCH_SIGMA_KM, double betaKm = MAP_MATCH_BETA_KM) : pool(threadPool) {
+        for(int w = 0; w < pool.getNumThreads(); w++) {
+            workers.push_back(TripMatcher(index, sigmaKm, betaKm));
+        }
+        trips = 0;
+        points = 0;
+        matchedPoints = 0;
+        unmatchedPoints = 0;
+        breaks = 0;
+        distanceKm = 0;
+    }
+
+    MapMatcher(const MapMatcher&) = delete;
+    MapMatcher& operator=(const MapMatcher&) = delete;
+
+    // Match every trace; results[i] answers traces[i]. Returns the total
+    // driven distance in km.
+    double matchAll(const vector<vector<GpsPoint>>& traces, vector<MatchedTrip>& results) {
+        results.resize(traces.size());
+        pool.parallelFor((int)traces.size(), [&](int i, int worker) {
+            TripMatcher& matcher = workers[worker];
+            matcher.reset();
+            for(size_t p = 0; p < traces[i].size(); p++) {
+                matcher.addPoint(traces[i][p]);
+            }
+            matcher.finish(results[i]);
+        });
+
+        double batchKm = 0;
+        for(size_t i = 0; i < results.size(); i++) {
+            points += results[i].points;
+            matchedPoints += results[i].matchedPoints;
+            unmatchedPoints += results[i].unmatchedPoints;
+            breaks += results[i].breaks;
+            batchKm += results[i].distanceKm;
+        }
+        trips += (long long)traces.size();
+        distanceKm += batchKm;
+        return batchKm;
+    }
+
+    void displayStats() const {
+        cout << "\n=== Map Matching Statistics ===" << endl;
+        cout << "Trips: " << trips << " on " << workers.size() << " worker threads" << endl;
+        cout << "GPS fixes: " << points << " (Viterbi steps: " << matchedPoints
+             << ", off-road: " << unmatchedPoints << ")" << endl;
+        cout << "Chain breaks: " << breaks << endl;
+        cout << "Distance matched: " << distanceKm << " km" << endl;
+        cout << "===============================\n" << endl;
+    }
+};
+
+#endif
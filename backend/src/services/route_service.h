@@ -0,0 +1,89 @@
+#ifndef ROUTE_SERVICE_H
+#define ROUTE_SERVICE_H
+
+#include <vector>
+#include <memory>
+#include "../data_structures/csr_graph.h"
+#include "../data_structures/thread_pool.h"
+using namespace std;
+
+struct RouteQuery {
+    int source;
+    int destination;
+};
+
+// Batch route planner (e.g. end-of-day replanning of every trip).
+//
+// Queries run against an immutable CSRGraph snapshot held by shared_ptr.
+// publish() swaps in a new map atomically; a batch that already started
+// keeps its own reference, so updating the map never blocks or corrupts
+// in-flight queries. Each ThreadPool worker owns one DijkstraSearch, whose
+// generation-stamped arrays are reused across queries without clearing, so
+// a warmed-up batch only allocates the result paths.
+class RouteQueryService {
+private:
+    ThreadPool& pool;
+    shared_ptr<const CSRGraph> current;
+    CSRGraph emptyGraph;                    // Placeholder until the first batch
+    vector<DijkstraSearch> workspaces;      // One per worker
+    vector<RoutePath> scratch;
+
+public:
+    RouteQueryService(ThreadPool& threadPool) : pool(threadPool), current(make_shared<const CSRGraph>()) {
+        for(int w = 0; w < pool.getNumThreads(); w++) {
+            workspaces.push_back(DijkstraSearch(emptyGraph));
+        }
+        scratch.resize(workspaces.size());
+    }
+
+    RouteQueryService(const RouteQueryService&) = delete;
+    RouteQueryService& operator=(const RouteQueryService&) = delete;
+
+    // Replace the road network used by subsequent batches
+    void publish(shared_ptr<const CSRGraph> graph) {
+        if(graph == NULL) return;
+        atomic_store(&current, graph);
+    }
+
+    shared_ptr<const CSRGraph> getSnapshot() const {
+        return atomic_load(&current);
+    }
+
+    // Route every query in parallel; results[i] answers queries[i].
+    // Returns how many routes were found.
+    int routeBatch(const vector<RouteQuery>& queries, vector<RoutePath>& results) {
+        shared_ptr<const CSRGraph> graph = getSnapshot();
+        results.resize(queries.size());
+
+        vector<int> foundPerWorker(workspaces.size(), 0);
+        pool.parallelFor((int)queries.size(), [&](int i, int worker) {
+            DijkstraSearch& search = workspaces[worker];
+            search.setGraph(*graph);
+            if(search.findRoute(queries[i].source, queries[i].destination, results[i])) {
+                foundPerWorker[worker]++;
+            }
+        });
+
+        int found = 0;
+        for(size_t w = 0; w < foundPerWorker.size(); w++) {
+            found += foundPerWorker[w];
+        }
+        return found;
+    }
+
+    // Distances only (no path reconstruction), INF where unreachable
+    void distanceBatch(const vector<RouteQuery>& queries, vector<int>& distances) {
+        shared_ptr<const CSRGraph> graph = getSnapshot();
+        distances.assign(queries.size(), INF);
+
+        pool.parallelFor((int)queries.size(), [&](int i, int worker) {
+            DijkstraSearch& search = workspaces[worker];
+            search.setGraph(*graph);
+            if(search.findRoute(queries[i].source, queries[i].destination, scratch[worker])) {
+                distances[i] = scratch[worker].distance;
+            }
+        });
+    }
+};
+
+#endif
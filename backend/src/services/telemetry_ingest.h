@@ -0,0 +1,238 @@
+#ifndef TELEMETRY_INGEST_H
+#define TELEMETRY_INGEST_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <charconv>
+#include <cstdint>
+#include "../data_structures/position_table.h"
+using namespace std;
+
+#define TELEMETRY_DEFAULT_TRIPS (1 << 16)
+#define TELEMETRY_DEFAULT_FLUSH_MS 1000
+
+// One GPS ping, as posted to /api/trips/location
+struct LocationPing {
+    string_view tripId;
+    double latitude;
+    double longitude;
+    float speed;
+    int64_t timestampMs;
+};
+
+// Receives one coalesced batch per flush: the latest position of every
+// trip that moved since the previous successful flush. Meant to become a
+// single multi-row "UPDATE trips ... FROM (VALUES ...)" instead of one
+// query per ping. Returns false if the rows were not stored; they are then
+// handed out again with the next flush.
+typedef function<bool(const vector<TripPosition>& batch)> PositionSink;
+
+// GPS ingestion for ongoing trips.
+// Pings arrive in batches - either LocationPing arrays or text frames of
+// "trip_id,latitude,longitude,speed,timestamp_ms" lines - and only update
+// the in-memory PositionTable, which is lock-free on this path. Storage
+// sees one row per trip per flush interval no matter how often the trip
+// reports, and out-of-order pings never overwrite a newer position.
+// Pings for trips that are not started are rejected, like the 404 from
+// the HTTP handler.
+class TelemetryIngest {
+private:
+    PositionTable positions;
+    PositionSink sink;
+    int64_t flushIntervalMs;
+    atomic<int64_t> lastFlushMs;
+    mutex flushLock;                    // One flush at a time
+    vector<TripPosition> batch;         // Reused between flushes
+    DirtyBatch pending;                 // Slots behind 'batch'
+    bool pendingOpen;                   // A sink threw before acking 'pending'
+
+    atomic<long long> pings;
+    atomic<long long> updated;
+    atomic<long long> stale;
+    atomic<long long> unknownTrip;
+    atomic<long long> malformed;
+    atomic<long long> flushes;
+    atomic<long long> rowsFlushed;
+    atomic<long long> failedFlushes;
+
+    template <typename T>
+    static bool parseField(string_view field, T& value) {
+        const char* end = field.data() + field.size();
+        auto result = from_chars(field.data(), end, value);
+        return result.ec == errc() && result.ptr == end;
+    }
+
+    // "trip,lat,lon,speed,ts" - speed may be empty
+    static bool parseLine(string_view line, LocationPing& ping) {
+        string_view fields[5];
+        for(int f = 0; f < 5; f++) {
+            size_t comma = f < 4 ? line.find(',') : line.size();
+            if(comma == string_view::npos) return false;
+            fields[f] = line.substr(0, comma);
+            line.remove_prefix(f < 4 ? comma + 1 : comma);
+        }
+        if(!fields[4].empty() && fields[4].back() == '\r') fields[4].remove_suffix(1);
+        ping.tripId = fields[0];
+        ping.speed = 0;
+        if(ping.tripId.empty() || !parseField(fields[1], ping.latitude) || !parseField(fields[2], ping.longitude) ||
+           (!fields[3].empty() && !parseField(fields[3], ping.speed)) || !parseField(fields[4], ping.timestampMs)) {
+            return false;
+        }
+        return validCoordinates(ping);
+    }
+
+    // In range (which also rules out NaN and infinities)
+    static bool validCoordinates(const LocationPing& ping) {
+        return ping.latitude >= -90 && ping.latitude <= 90 && ping.longitude >= -180 && ping.longitude <= 180;
+    }
+
+    void count(long long batchPings, long long ok, long long late, long long unknown, long long bad) {
+        pings += batchPings;
+        updated += ok;
+        stale += late;
+        unknownTrip += unknown;
+        malformed += bad;
+    }
+
+public:
+    TelemetryIngest(size_t maxTrips = TELEMETRY_DEFAULT_TRIPS, int64_t flushEveryMs = TELEMETRY_DEFAULT_FLUSH_MS)
+        : positions(maxTrips * 2) {
+        flushIntervalMs = flushEveryMs;
+        lastFlushMs = 0;
+        pings = 0;
+        updated = 0;
+        stale = 0;
+        unknownTrip = 0;
+        malformed = 0;
+        flushes = 0;
+        rowsFlushed = 0;
+        failedFlushes = 0;
+        pendingOpen = false;
+    }
+
+    TelemetryIngest(const TelemetryIngest&) = delete;
+    TelemetryIngest& operator=(const TelemetryIngest&) = delete;
+
+    void setSink(const PositionSink& s) {
+        lock_guard<mutex> guard(flushLock);
+        sink = s;
+    }
+
+    bool startTrip(string_view tripId) {
+        return positions.startTrip(tripId);
+    }
+
+    // The final position still goes out with the next flush
+    bool endTrip(string_view tripId) {
+        return positions.endTrip(tripId);
+    }
+
+    // Returns how many pings moved a trip forward; pings with coordinates
+    // out of range are counted as malformed, as in ingestFrame()
+    size_t ingest(const LocationPing* batchPings, size_t n) {
+        long long ok = 0, late = 0, unknown = 0, bad = 0;
+        for(size_t i = 0; i < n; i++) {
+            const LocationPing& p = batchPings[i];
+            if(!validCoordinates(p)) {
+                bad++;
+                continue;
+            }
+            PositionUpdate result = positions.update(p.tripId, p.latitude, p.longitude, p.speed, p.timestampMs);
+            if(result == POSITION_UPDATED) ok++;
+            else if(result == POSITION_STALE) late++;
+            else unknown++;
+        }
+        count((long long)n, ok, late, unknown, bad);
+        return (size_t)ok;
+    }
+
+    // Newline-separated text frame; malformed lines are counted and skipped
+    size_t ingestFrame(string_view frame) {
+        long long lines = 0, ok = 0, late = 0, unknown = 0, bad = 0;
+        while(!frame.empty()) {
+            size_t newline = frame.find('\n');
+            string_view line = frame.substr(0, newline);
+            frame.remove_prefix(newline == string_view::npos ? frame.size() : newline + 1);
+            if(line.empty() || line == "\r") continue;
+
+            lines++;
+            LocationPing p;
+            if(!parseLine(line, p)) {
+                bad++;
+                continue;
+            }
+            PositionUpdate result = positions.update(p.tripId, p.latitude, p.longitude, p.speed, p.timestampMs);
+            if(result == POSITION_UPDATED) ok++;
+            else if(result == POSITION_STALE) late++;
+            else unknown++;
+        }
+        count(lines, ok, late, unknown, bad);
+        return (size_t)ok;
+    }
+
+    bool getPosition(string_view tripId, TripPosition& out) const {
+        return positions.get(tripId, out);
+    }
+
+    // Hand every trip that moved since the last successful flush to the
+    // sink. Rows are only settled once the sink accepts them; a refused
+    // (or thrown-out) batch goes out again next time. Returns the rows
+    // stored.
+    size_t flush(int64_t nowMs = 0) {
+        lock_guard<mutex> guard(flushLock);
+        if(pendingOpen) positions.releaseDirty(pending);
+        batch.clear();
+        positions.takeDirty(batch, pending);
+        pendingOpen = true;
+        lastFlushMs = nowMs;
+        if(!batch.empty() && sink && !sink(batch)) {
+            positions.releaseDirty(pending);
+            pendingOpen = false;
+            failedFlushes++;
+            return 0;
+        }
+        positions.ackDirty(pending);
+        pendingOpen = false;
+        if(batch.empty()) return 0;
+        flushes++;
+        rowsFlushed += (long long)batch.size();
+        return batch.size();
+    }
+
+    // Call from the ingest loop with the current time
+    size_t flushIfDue(int64_t nowMs) {
+        if(nowMs - lastFlushMs.load() < flushIntervalMs) return 0;
+        return flush(nowMs);
+    }
+
+    size_t getActiveTrips() const {
+        return positions.getActiveTrips();
+    }
+
+    long long getPings() const {
+        return pings.load();
+    }
+
+    long long getRowsFlushed() const {
+        return rowsFlushed.load();
+    }
+
+    void displayStats() const {
+        cout << "\n=== Telemetry Statistics ===" << endl;
+        cout << "Active trips: " << positions.getActiveTrips() << " (capacity " << positions.capacity() / 2 << ")" << endl;
+        cout << "Pings: " << pings.load() << " (applied: " << updated.load() << ", out of order: " << stale.load()
+             << ", unknown trip: " << unknownTrip.load() << ", malformed: " << malformed.load() << ")" << endl;
+        cout << "Flushes: " << flushes.load() << " (failed: " << failedFlushes.load() << "), rows written: "
+             << rowsFlushed.load();
+        if(rowsFlushed.load() > 0) cout << " (" << (double)updated.load() / rowsFlushed.load() << " pings per row)";
+        cout << endl;
+        cout << "============================\n" << endl;
+    }
+};
+
+#endif